@@ -0,0 +1,114 @@
+#include "AIScheduler.h"
+#include "Scene.h"
+#include "Object.h"
+
+AIScheduler::AIScheduler(Scene* parent) :
+	mParent{ parent }
+{
+}
+
+void AIScheduler::Schedule(vector<Object*>& objects, float deltaTime)
+{
+	++mFrame;
+
+	// ÷̾ ġ Ӵ   ã´.
+	PlayerObject* player = mParent->GetObj<PlayerObject>();
+	mHasPlayer = player != nullptr;
+	if (mHasPlayer) XMStoreFloat3(&mPlayerPos, player->GetComponent<Transform>()->GetPosition());
+
+	mAgents.clear();
+	for (Object* obj : objects)
+	{
+		if (!obj->GetValid()) continue;
+		TigerObject* tiger = dynamic_cast<TigerObject*>(obj);
+		if (tiger) mAgents.push_back(tiger);
+	}
+	if (mAgents.empty()) return;
+
+	XMVECTOR playerPos = XMLoadFloat3(&mPlayerPos);
+	uint32_t budget = mThinkBudget;
+	mPositions.resize(mAgents.size());
+	for (size_t i = 0; i < mAgents.size(); ++i)
+	{
+		TigerObject* tiger = mAgents[i];
+		AIThinkState& state = tiger->GetThinkState();
+		state.accumTime += deltaTime;
+
+		XMVECTOR pos = tiger->GetComponent<Transform>()->GetPosition();
+		XMStoreFloat3(&mPositions[i], pos);
+
+		eAILod lod = eAILod::Near;
+		if (mHasPlayer)
+		{
+			lod = CalcLod(XMVectorGetX(XMVector3LengthSq(playerPos - pos)));
+		}
+		state.lod = lod;
+
+		Collider* collider = tiger->GetComponent<Collider>();
+		if (collider) collider->SetActive(lod != eAILod::Far);
+
+		switch (lod)
+		{
+		case eAILod::Near:
+			state.think = true;
+			break;
+		case eAILod::Mid:
+		{
+			// id     ӿ  ʰ Ѵ.
+			bool due = (mFrame + tiger->GetId()) % mMidInterval == 0;
+			state.think = due && budget > 0;
+			if (state.think) --budget;
+			break;
+		}
+		case eAILod::Far:
+			state.think = false;
+			break;
+		}
+	}
+
+	// ̵   о   д.
+	mCrowd.Solve(mPositions, mSeparations);
+	for (size_t i = 0; i < mAgents.size(); ++i)
+	{
+		mAgents[i]->SetSeparation(mSeparations[i]);
+	}
+
+	// Far    ȿ  κ   .
+	uint32_t farBudget = min(mFarBudget, budget);
+	size_t count = mAgents.size();
+	size_t visited = 0;
+	mFarCursor %= count;
+	while (farBudget > 0 && visited < count)
+	{
+		AIThinkState& state = mAgents[mFarCursor]->GetThinkState();
+		if (state.lod == eAILod::Far)
+		{
+			state.think = true;
+			--farBudget;
+		}
+		mFarCursor = (mFarCursor + 1) % count;
+		++visited;
+	}
+}
+
+XMVECTOR AIScheduler::GetPlayerPosition()
+{
+	return XMVectorSet(mPlayerPos.x, mPlayerPos.y, mPlayerPos.z, 1.0f);
+}
+
+bool AIScheduler::HasPlayer()
+{
+	return mHasPlayer;
+}
+
+Scene* AIScheduler::GetScene()
+{
+	return mParent;
+}
+
+eAILod AIScheduler::CalcLod(float distSq)
+{
+	if (distSq < mNearDistance * mNearDistance) return eAILod::Near;
+	if (distSq < mMidDistance * mMidDistance) return eAILod::Mid;
+	return eAILod::Far;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "stdafx.h"
+#include "CrowdSeparation.h"
+
+class Scene;
+class Object;
+class TigerObject;
+
+enum class eAILod
+{
+	Near,	//   think
+	Mid,	// N Ӹ think
+	Far		//    think, 浹 
+};
+
+// Ʈ ϳ  . Ʈ  ְ AIScheduler    ä.
+struct AIThinkState
+{
+	eAILod lod = eAILod::Near;
+	bool think = true;			// ̹ ӿ Think  
+	float accumTime = 0.0f;		//  Think   ð
+};
+
+class AIScheduler
+{
+public:
+	AIScheduler(Scene* parent);
+	AIScheduler(const AIScheduler&) = delete;
+	AIScheduler& operator=(const AIScheduler&) = delete;
+	~AIScheduler() = default;
+
+	void Schedule(vector<Object*>& objects, float deltaTime);
+	XMVECTOR GetPlayerPosition();
+	bool HasPlayer();
+	Scene* GetScene();
+private:
+	eAILod CalcLod(float distSq);
+private:
+	Scene* mParent = nullptr;
+
+	vector<TigerObject*> mAgents;
+	vector<XMFLOAT3> mPositions;
+	vector<XMFLOAT3> mSeparations;
+	CrowdSeparation mCrowd{};
+	XMFLOAT3 mPlayerPos{};
+	bool mHasPlayer = false;
+	uint32_t mFrame = 0;
+	size_t mFarCursor = 0;
+
+	float mNearDistance = 200.0f;	// ȣ Ž  
+	float mMidDistance = 500.0f;
+	uint32_t mMidInterval = 4;
+	uint32_t mThinkBudget = 64;		// Ӵ Mid + Far  ϴ think 
+	uint32_t mFarBudget = 8;
+};
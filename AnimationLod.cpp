@@ -0,0 +1,32 @@
+#include "AnimationLod.h"
+
+void AnimationLod::BeginFrame(XMVECTOR cameraPos)
+{
+	XMStoreFloat3(&mCameraPos, cameraPos);
+	mEnabled = true;
+	++mFrame;
+}
+
+void AnimationLod::Disable()
+{
+	mEnabled = false;
+	++mFrame;
+}
+
+UINT AnimationLod::GetInterval(XMVECTOR pos)
+{
+	if (!mEnabled) return 1;
+	float distSq = XMVectorGetX(XMVector3LengthSq(pos - XMLoadFloat3(&mCameraPos)));
+	UINT interval = 1;
+	for (float distance : mDistance)
+	{
+		if (distSq > distance * distance) interval <<= 1;
+	}
+	return interval;
+}
+
+bool AnimationLod::ShouldEvaluate(uint32_t id, XMVECTOR pos)
+{
+	UINT interval = GetInterval(pos);
+	return ((mFrame + id) & (interval - 1)) == 0;
+}
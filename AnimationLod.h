@@ -0,0 +1,20 @@
+#pragma once
+#include "stdafx.h"
+
+// ī޶󿡼  ̷ 2, 4, 8 Ӹ   ٽ ϰ
+//  ̿  ۿ  ִ  ȷƮ ״ .
+//  ܰ Ʈ id    ߳ ؼ  Ӹ  .
+class AnimationLod
+{
+public:
+	void BeginFrame(XMVECTOR cameraPos);
+	void Disable();	// ī޶     
+	UINT GetInterval(XMVECTOR pos);
+	bool ShouldEvaluate(uint32_t id, XMVECTOR pos);
+private:
+	XMFLOAT3 mCameraPos{};
+	bool mEnabled = false;
+	uint32_t mFrame = 0;
+	//  Ÿ ָ  2, 4, 8 
+	float mDistance[3] = { 150.0f, 300.0f, 500.0f };
+};
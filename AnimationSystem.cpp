@@ -0,0 +1,272 @@
+#include "AnimationSystem.h"
+#include "Scene.h"
+#include "Object.h"
+#include "DXSampleHelper.h"
+
+AnimationSystem::AnimationSystem(Scene* parent, ID3D12Device* device, UINT workerCount) :
+	mParent{ parent }
+{
+	BuildResource(device);
+
+	mScratch.resize(workerCount + 1);
+	for (UINT i = 0; i < workerCount; ++i)
+	{
+		mWorkers.emplace_back(&AnimationSystem::WorkerMain, this, i + 1);
+	}
+}
+
+AnimationSystem::~AnimationSystem()
+{
+	{
+		lock_guard<mutex> lock(mMutex);
+		mQuit = true;
+	}
+	mWakeUp.notify_all();
+	for (thread& worker : mWorkers)
+	{
+		worker.join();
+	}
+	if (mPaletteBuffer) mPaletteBuffer->Unmap(0, nullptr);
+}
+
+void AnimationSystem::Update(vector<Object*>& objects, float deltaTime)
+{
+	++mFrame;
+	Gather(objects, deltaTime);
+	ReleaseUnusedSlots();
+
+	ParallelFor((UINT)mEvaluateJobs.size(), [this](UINT i, UINT worker) {
+		EvaluateJob& job = mEvaluateJobs[i];
+		job.data->GetFinalTransforms(job.clip, job.timePos, mScratch[worker], mSkinningMode, job.out, job.keyCursors);
+	});
+
+	// ĳ ȷƮ   ä ڿ ؾ Ѵ.
+	// Ʈ ϳ memcpy  ̶ ۾ 带 ٽ  ͺ ⼭ ٷ ϴ  δ.
+	for (CopyJob& job : mCopyJobs)
+	{
+		memcpy(job.dst, job.src, sizeof(XMFLOAT4) * job.size);
+	}
+
+	if (mFrame % 600 == 0 && mLegacyUploadBytes > 0)
+	{
+		OutputDebugStringA(("[AnimUpload] palette " + to_string(mUploadBytes) + " bytes/frame, ObjectCB float4x4[" + to_string(MAX_BONE)
+			+ "] would be " + to_string(mLegacyUploadBytes) + " bytes/frame ("
+			+ (mSkinningMode == SkinningMode::DualQuaternion ? "dual quaternion" : "3x4") + ")\n").c_str());
+	}
+}
+
+void AnimationSystem::BindPalette(ID3D12GraphicsCommandList* commandList)
+{
+	commandList->SetGraphicsRootShaderResourceView(5, mPaletteBuffer->GetGPUVirtualAddress());
+}
+
+void AnimationSystem::SetSkinningMode(SkinningMode mode)
+{
+	if (mode == mSkinningMode) return;
+	mSkinningMode = mode;
+	//  ϳ ũⰡ ٲǷ ڸ   ´.
+	mSlots.clear();
+	mFreeSlots.clear();
+	mPaletteTop = 0;
+}
+
+SkinningMode AnimationSystem::GetSkinningMode()
+{
+	return mSkinningMode;
+}
+
+UINT AnimationSystem::GetWorkerCount()
+{
+	return (UINT)mWorkers.size();
+}
+
+UINT AnimationSystem::GetEvaluateCount()
+{
+	return (UINT)mEvaluateJobs.size();
+}
+
+size_t AnimationSystem::GetUploadBytes()
+{
+	return mUploadBytes;
+}
+
+size_t AnimationSystem::GetLegacyUploadBytes()
+{
+	return mLegacyUploadBytes;
+}
+
+void AnimationSystem::Gather(vector<Object*>& objects, float deltaTime)
+{
+	mEvaluateJobs.clear();
+	mCopyJobs.clear();
+	mUploadBytes = 0;
+	mLegacyUploadBytes = 0;
+	UINT stride = PaletteStride(mSkinningMode);
+
+	PoseCache& poseCache = mParent->GetPoseCache();
+	AnimationLod& animationLod = mParent->GetAnimationLod();
+	for (Object* obj : objects)
+	{
+		if (!obj->GetValid()) continue;
+		Animation* animation = obj->GetComponent<Animation>();
+		if (!animation) continue;
+
+		const ClipInfo& clip = *animation->mClip;
+		animation->mAnimationTime += deltaTime;
+		if (animation->mAnimationTime >= clip.EndTime) animation->mAnimationTime = 0.0f;
+
+		bool newSlot = false;
+		UINT offset = AcquireSlot(obj->GetId(), clip.BoneCount * stride, newSlot);
+		obj->SetPalette(offset, (int)mSkinningMode);
+
+		// ָ   ӿ   ϰ,  ̿  ȷƮ ״ д.
+		XMVECTOR pos = obj->GetComponent<Transform>()->GetFinalM().r[3];
+		if (animation->mPaletteValid && !newSlot && !animationLod.ShouldEvaluate(obj->GetId(), pos)) continue;
+		animation->mPaletteValid = true;
+		mUploadBytes += sizeof(XMFLOAT4) * clip.BoneCount * stride;
+		mLegacyUploadBytes += sizeof(XMFLOAT4X4) * MAX_BONE;
+
+		EvaluateJob job;
+		job.data = clip.Data;
+		job.clip = clip.Clip;
+		job.timePos = animation->mAnimationTime;
+		job.out = mMappedPalette + offset;
+		job.keyCursors = animation->mKeyCursors.data();
+
+		//   ̹ ̹ ӿ     縸 Ѵ.
+		bool isNew = false;
+		XMFLOAT4* palette = poseCache.Acquire(*clip.Data, clip.Clip, job.timePos, isNew);
+		if (!palette)
+		{
+			mEvaluateJobs.push_back(job);
+			continue;
+		}
+		CopyJob copy;
+		copy.src = palette;
+		copy.dst = job.out;
+		copy.size = clip.BoneCount * stride;
+		mCopyJobs.push_back(copy);
+
+		if (!isNew) continue;
+		job.out = palette;
+		mEvaluateJobs.push_back(job);
+	}
+}
+
+UINT AnimationSystem::AcquireSlot(uint32_t id, UINT size, bool& isNew)
+{
+	isNew = false;
+	auto it = mSlots.find(id);
+	if (it != mSlots.end())
+	{
+		if (it->second.size == size)
+		{
+			it->second.frame = mFrame;
+			return it->second.offset;
+		}
+		mFreeSlots[it->second.size].push_back(it->second.offset);
+		mSlots.erase(it);
+	}
+
+	isNew = true;
+	PaletteSlot slot;
+	slot.size = size;
+	slot.frame = mFrame;
+	vector<UINT>& freeSlots = mFreeSlots[size];
+	if (!freeSlots.empty())
+	{
+		slot.offset = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else
+	{
+		if (mPaletteTop + size > MAX_PALETTE) throw; // 
+		slot.offset = mPaletteTop;
+		mPaletteTop += size;
+	}
+	mSlots[id] = slot;
+	return slot.offset;
+}
+
+void AnimationSystem::ReleaseUnusedSlots()
+{
+	// ̹ ӿ   Ʈ ų ִϸ̼ .
+	for (auto it = mSlots.begin(); it != mSlots.end();)
+	{
+		if (it->second.frame == mFrame)
+		{
+			++it;
+			continue;
+		}
+		mFreeSlots[it->second.size].push_back(it->second.offset);
+		it = mSlots.erase(it);
+	}
+}
+
+void AnimationSystem::BuildResource(ID3D12Device* device)
+{
+	ThrowIfFailed(device->CreateCommittedResource(
+		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
+		D3D12_HEAP_FLAG_NONE,
+		&CD3DX12_RESOURCE_DESC::Buffer(sizeof(XMFLOAT4) * MAX_PALETTE),
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&mPaletteBuffer)));
+
+	CD3DX12_RANGE readRange(0, 0);
+	ThrowIfFailed(mPaletteBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mMappedPalette)));
+}
+
+void AnimationSystem::ParallelFor(UINT count, const function<void(UINT, UINT)>& func)
+{
+	if (count == 0) return;
+	if (mWorkers.empty() || count < MIN_PARALLEL_COUNT)
+	{
+		for (UINT i = 0; i < count; ++i) func(i, 0);
+		return;
+	}
+
+	{
+		lock_guard<mutex> lock(mMutex);
+		mBatchFunc = &func;
+		mBatchCount = count;
+		mNext = 0;
+		mBusyWorkers = (UINT)mWorkers.size();
+		++mGeneration;
+	}
+	mWakeUp.notify_all();
+
+	//   0  ۾ڷ  Ѵ.
+	RunBatch(0);
+
+	unique_lock<mutex> lock(mMutex);
+	mDone.wait(lock, [this] { return mBusyWorkers == 0; });
+	mBatchFunc = nullptr;
+}
+
+void AnimationSystem::RunBatch(UINT worker)
+{
+	for (UINT i = mNext++; i < mBatchCount; i = mNext++)
+	{
+		(*mBatchFunc)(i, worker);
+	}
+}
+
+void AnimationSystem::WorkerMain(UINT worker)
+{
+	uint64_t generation = 0;
+	while (true)
+	{
+		{
+			unique_lock<mutex> lock(mMutex);
+			mWakeUp.wait(lock, [&] { return mQuit || mGeneration != generation; });
+			if (mQuit) return;
+			generation = mGeneration;
+		}
+
+		RunBatch(worker);
+
+		lock_guard<mutex> lock(mMutex);
+		if (--mBusyWorkers == 0) mDone.notify_one();
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "stdafx.h"
+#include "Info.h"
+#include "SkinnedData.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#define MAX_PALETTE (256 * MAX_BONE * 3)	// float4 . 90  ĳ 256  3x4 ķ
+#define MIN_PARALLEL_COUNT 8	// ̺   带   꺸 ũ
+
+class Scene;
+class Object;
+
+//  Animation Ʈ   óϴ ܰ.
+// Scene::LateUpdate   Ʈ  ȯ   ڿ . (LOD  ġ )
+// 1)  : ð ϰ, LOD   ĳ÷    .  .
+// 2)    :   ۾   Ѵ. 帶 AnimationScratch   .
+// 3)    : ĳÿ  ȷƮ    Ʈ ȷƮ ڸ Ѵ. memcpy ̶  忡 Ѵ.
+// ȷƮ Ʈ  ۰ ƴ϶ ȭ  ϳ  ŭ ´. (t3)
+// Ʈ ڸ Ǿ ־ LOD  ǳʶ ӿ  ȷƮ ״ ´.
+class AnimationSystem
+{
+public:
+	AnimationSystem(Scene* parent, ID3D12Device* device, UINT workerCount);
+	AnimationSystem(const AnimationSystem&) = delete;
+	AnimationSystem& operator=(const AnimationSystem&) = delete;
+	~AnimationSystem();
+
+	void Update(vector<Object*>& objects, float deltaTime);
+	void BindPalette(ID3D12GraphicsCommandList* commandList);
+	void SetSkinningMode(SkinningMode mode);	//  ȷƮ  Update  ٽ Ѵ
+	SkinningMode GetSkinningMode();
+	UINT GetWorkerCount();
+	UINT GetEvaluateCount();	//  Update     
+	size_t GetUploadBytes();	//  Update  ȷƮ ۿ  Ʈ
+	size_t GetLegacyUploadBytes();	//   ObjectCB  float4x4[MAX_BONE]    Ʈ
+private:
+	void Gather(vector<Object*>& objects, float deltaTime);
+	UINT AcquireSlot(uint32_t id, UINT size, bool& isNew);
+	void ReleaseUnusedSlots();
+	void BuildResource(ID3D12Device* device);
+	// func(index, worker)  [0, count)   ۾   尡  θ.
+	// count  MIN_PARALLEL_COUNT   ۾ 带  ʰ  忡  Ѵ.
+	void ParallelFor(UINT count, const function<void(UINT, UINT)>& func);
+	void RunBatch(UINT worker);
+	void WorkerMain(UINT worker);
+private:
+	struct EvaluateJob
+	{
+		const SkinnedData* data = nullptr;
+		ClipHandle clip = 0;
+		float timePos = 0.0f;
+		XMFLOAT4* out = nullptr;
+		UINT* keyCursors = nullptr;
+	};
+	struct CopyJob
+	{
+		const XMFLOAT4* src = nullptr;
+		XMFLOAT4* dst = nullptr;
+		UINT size = 0;	// float4 
+	};
+
+	Scene* mParent = nullptr;
+	vector<EvaluateJob> mEvaluateJobs;
+	vector<CopyJob> mCopyJobs;
+	vector<AnimationScratch> mScratch;	// ۾   + 1 ( )
+
+	// ȷƮ .   GPU  ٸǷ ε  ϳ ϴ.
+	struct PaletteSlot
+	{
+		UINT offset = 0;
+		UINT size = 0;
+		uint64_t frame = 0;
+	};
+	SkinningMode mSkinningMode = SkinningMode::Matrix3x4;
+	unordered_map<uint32_t, PaletteSlot> mSlots;		// Ʈ id -> ڸ
+	unordered_map<UINT, vector<UINT>> mFreeSlots;	// ũ ->  ִ ڸ
+	UINT mPaletteTop = 0;
+	uint64_t mFrame = 0;
+	ComPtr<ID3D12Resource> mPaletteBuffer;
+	XMFLOAT4* mMappedPalette = nullptr;
+
+	size_t mUploadBytes = 0;
+	size_t mLegacyUploadBytes = 0;
+
+	// ۾ .   mWakeUp  ܴ.
+	vector<thread> mWorkers;
+	mutex mMutex;
+	condition_variable mWakeUp;
+	condition_variable mDone;
+	const function<void(UINT, UINT)>* mBatchFunc = nullptr;
+	UINT mBatchCount = 0;
+	atomic<UINT> mNext{ 0 };
+	UINT mBusyWorkers = 0;
+	uint64_t mGeneration = 0;
+	bool mQuit = false;
+};
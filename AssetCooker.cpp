@@ -0,0 +1,534 @@
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <cmath>
+#include "AssetCooker.h"
+#include "FbxExtractor.h"
+#include "NativeFbxImporter.h"
+
+const vector<FbxAsset>& GetFbxAssets()
+{
+	static const vector<FbxAsset> assets{
+		{ "1P(boy-idle).fbx", false, true, "" },
+		{ "boy_walk_fix.fbx", true, true, "1P(boy-idle).fbx" },
+		{ "boy_run_fix.fbx", true, true, "1P(boy-idle).fbx" },
+		{ "boy_pickup_fix.fbx", true, true, "1P(boy-idle).fbx" },
+		{ "boy_attack(45).fbx", true, true, "1P(boy-idle).fbx" },
+		{ "boy_hit.fbx", true, true, "1P(boy-idle).fbx" },
+		{ "boy_dying_fix.fbx", true, true, "1P(boy-idle).fbx" },
+		{ "boy_throw.fbx", true, true, "1P(boy-idle).fbx" },
+
+		{ "god_idle.fbx", false, true, "" },
+		{ "sister_idle_fix.fbx", false, true, "" },
+
+		{ "0113_tiger.fbx", false, true, "" },
+		{ "0722_tiger_idle2.fbx", true, true, "0113_tiger.fbx" },
+		{ "0113_tiger_walk.fbx", true, true, "0113_tiger.fbx" },
+		{ "0722_tiger_run.fbx", true, true, "0113_tiger.fbx" },
+		{ "0208_tiger_attack.fbx", true, true, "0113_tiger.fbx" },
+		{ "0208_tiger_hit.fbx", true, true, "0113_tiger.fbx" },
+		{ "0208_tiger_dying.fbx", true, true, "0113_tiger.fbx" },
+
+		{ "long_tree.fbx", false, true, "" },
+		{ "normal_tree.fbx", false, true, "" },
+
+		{ "broken_house.fbx", false, true, "" },
+		{ "broken_house2.fbx", false, true, "" },
+		{ "background_house.fbx", false, true, "" },
+
+		{ "table.fbx", false, true, "" },
+		{ "well.fbx", false, true, "" },
+		{ "fence.fbx", false, true, "" },
+
+		{ "cloud1.fbx", false, true, "" },
+		{ "cloud2.fbx", false, true, "" },
+		{ "cloud3.fbx", false, true, "" },
+		{ "cloud4.fbx", false, true, "" },
+
+		{ "tiger_leather.fbx", false, true, "" },
+		{ "axe.fbx", false, true, "" },
+		{ "wood.fbx", false, true, "" },
+		{ "ricecake.fbx", false, true, "" },
+
+		{ "grass_low.fbx", false, true, "" },
+	};
+	return assets;
+}
+
+const vector<string>& GetAnimStates(const string& skeletonName)
+{
+	// ̸ ãǷ GetFbxAssets  ʹ 
+	static const unordered_map<string, vector<string>> states{
+		{ "1P(boy-idle).fbx", { "1P(boy-idle).fbx", "boy_walk_fix.fbx", "boy_run_fix.fbx", "boy_pickup_fix.fbx",
+			"boy_attack(45).fbx", "boy_hit.fbx", "boy_dying_fix.fbx", "boy_throw.fbx" } },
+		{ "0113_tiger.fbx", { "0113_tiger.fbx", "0722_tiger_idle2.fbx", "0113_tiger_walk.fbx", "0722_tiger_run.fbx",
+			"0208_tiger_attack.fbx", "0208_tiger_hit.fbx", "0208_tiger_dying.fbx" } },
+	};
+	static const vector<string> none;
+	auto it = states.find(skeletonName);
+	return it != states.end() ? it->second : none;
+}
+
+const AnimationCompression& GetAnimationCompression()
+{
+	//   ΰ SoA  Ѵ. Ѹ 󸶳 پ -animreport  .
+	static const AnimationCompression compression{};
+	return compression;
+}
+
+AssetCooker::AssetCooker(UINT workerCount, bool sdkImport) :
+	mWorkerCount{ max(workerCount, 1u) },
+	mSdkImport{ sdkImport }
+{
+}
+
+bool AssetCooker::Run(bool force)
+{
+	auto start = chrono::steady_clock::now();
+	CreateDirectoryA(COOKED_DIRECTORY, nullptr);
+	mManifest.Load(COOK_MANIFEST);
+
+	CollectFbxJobs(force);
+	HashRawFiles("./Textures/*.dds", "./Textures/");
+	HashRawFiles("./*.raw", "./");
+	CookJobs();
+
+	UINT failCount = 0;
+	size_t rawVertexCount = 0, vertexCount = 0;
+	for (Job& job : mJobs) {
+		if (!job.saved) ++failCount;
+		rawVertexCount += job.mesh.rawVertexCount;
+		vertexCount += job.vertexCount;
+		char buffer[384];
+		sprintf_s(buffer, "[Cook] %-24s %s  %s, vertices %zu -> %zu (%.1f%%), indices %zu (%d bit), clips %zu, %.2fs\n", job.asset->fileName.c_str(),
+			job.saved ? "cooked" : "FAILED", job.native ? "native" : "sdk", job.mesh.rawVertexCount, job.vertexCount,
+			job.mesh.rawVertexCount > 0 ? 100.0f * job.vertexCount / job.mesh.rawVertexCount : 100.0f, job.indexCount,
+			MeshOptimizer::FitsIndex16(job.vertexCount) ? 16 : 32, job.clipCount, job.seconds);
+		Log(buffer);
+		if (job.indexCount > 0) {
+			sprintf_s(buffer, "       %-24s vertex cache %u : ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n", "", VERTEX_CACHE_SIZE,
+				job.mesh.before.acmr, job.mesh.after.acmr, job.mesh.before.atvr, job.mesh.after.atvr);
+			Log(buffer);
+		}
+	}
+	if (rawVertexCount > 0) {
+		char buffer[128];
+		sprintf_s(buffer, "[Cook] welded vertices %zu -> %zu (%.1f%%), vertex memory %.2f MB -> %.2f MB\n", rawVertexCount, vertexCount,
+			100.0f * vertexCount / rawVertexCount, rawVertexCount * sizeof(Vertex) / 1048576.0f, vertexCount * sizeof(Vertex) / 1048576.0f);
+		Log(buffer);
+	}
+
+	if (mManifest.IsDirty() && !mManifest.Save(COOK_MANIFEST)) {
+		Log("[Cook] " COOK_MANIFEST "  \n");
+		++failCount;
+	}
+
+	float seconds = chrono::duration<float>(chrono::steady_clock::now() - start).count();
+	char buffer[256];
+	sprintf_s(buffer, "[Cook] fbx %zu cooked, %u up to date, %u failed / raw files %u hashed / %u workers, %.2fs\n",
+		mJobs.size() - failCount, mUpToDateCount, failCount, mRawFileCount, mWorkerCount, seconds);
+	Log(buffer);
+	return failCount == 0;
+}
+
+void AssetCooker::CollectFbxJobs(bool force)
+{
+	const vector<FbxAsset>& assets = GetFbxAssets();
+
+	//     ʴ fbx   𸣹Ƿ  ʴ´.
+	WIN32_FIND_DATAA findData{};
+	HANDLE find = FindFirstFileA(FBX_DIRECTORY "*.fbx", &findData);
+	if (find != INVALID_HANDLE_VALUE) {
+		do {
+			string fileName = findData.cFileName;
+			auto it = find_if(assets.begin(), assets.end(), [&](const FbxAsset& asset) { return asset.fileName == fileName; });
+			if (it == assets.end()) Log("[Cook] " + fileName + " :  ʴ , ǳʶ\n");
+		} while (FindNextFileA(find, &findData));
+		FindClose(find);
+	}
+
+	//  ؽô  п ٲ ϸ ٽ Ѵ.
+	// ̷   Ŭ ϵ麸 տ Ƿ, Ŭ    ̷ ٽ  ̹  ִ.
+	for (const FbxAsset& asset : assets) {
+		Job job;
+		job.asset = &asset;
+		job.sourceHash = mManifest.GetSourceHash(FBX_DIRECTORY + asset.fileName, CookedAsset::GetImportSeed(asset.onlyAnimation, asset.zUp));
+		if (job.sourceHash == 0) {
+			Log("[Cook] " + asset.fileName + " :  \n");
+			mJobs.push_back(job);	// з 
+			continue;
+		}
+		string cookedPath = CookedAsset::GetCookedPath(asset.fileName);
+		CookedHeader header{};
+		bool upToDate = !force && CookedAsset::ReadHeader(cookedPath, header) && header.sourceHash == job.sourceHash;
+		if (upToDate && asset.skeletonName.empty()) {
+			// ̷  Ͽ о ΰ,   ٲ ٽ Ѵ
+			FbxData data;
+			upToDate = CookedAsset::Load(cookedPath, job.sourceHash, asset.onlyAnimation, asset.zUp, data);
+			if (upToDate && data.boneHierarchy.empty() == false) {
+				Skeleton& skeleton = mSkeletons[asset.fileName];
+				CookedAsset::MakeSkeleton(data, skeleton);
+				upToDate = data.bindHash == CookedAsset::GetBindHash(skeleton, GetAnimationCompression());
+				if (!upToDate) mSkeletons.erase(asset.fileName);
+			}
+		}
+		else if (upToDate) {
+			const Skeleton* skeleton = FindSkeleton(asset);
+			upToDate = skeleton && header.bindHash == CookedAsset::GetBindHash(*skeleton, GetAnimationCompression());
+		}
+		if (upToDate) {
+			++mUpToDateCount;
+			continue;
+		}
+		mJobs.push_back(job);
+	}
+}
+
+const Skeleton* AssetCooker::FindSkeleton(const FbxAsset& asset)
+{
+	auto it = mSkeletons.find(asset.skeletonName.empty() ? asset.fileName : asset.skeletonName);
+	return it != mSkeletons.end() ? &it->second : nullptr;
+}
+
+void AssetCooker::HashRawFiles(const string& pattern, const string& directory)
+{
+	WIN32_FIND_DATAA findData{};
+	HANDLE find = FindFirstFileA(pattern.c_str(), &findData);
+	if (find == INVALID_HANDLE_VALUE) return;
+	do {
+		mManifest.GetSourceHash(directory + findData.cFileName, 0);
+		++mRawFileCount;
+	} while (FindNextFileA(find, &findData));
+	FindClose(find);
+}
+
+void AssetCooker::CookJobs()
+{
+	// Ŭ  ̷ ־   Ƿ   Ѵ
+	RunJobs(false);
+	for (Job& job : mJobs) {
+		if (job.skeleton.BoneCount() > 0) mSkeletons[job.asset->fileName] = move(job.skeleton);
+	}
+	RunJobs(true);
+}
+
+void AssetCooker::RunJobs(bool clipFiles)
+{
+	vector<Job*> jobs;
+	for (Job& job : mJobs) {
+		if (job.asset->skeletonName.empty() != clipFiles) jobs.push_back(&job);
+	}
+
+	atomic<UINT> next{ 0 };
+	auto Work = [&]() {
+		// FbxManager  峢   ʴ´. Ƽ    ʴ´.
+		unique_ptr<FbxExtractor> extractor;
+		NativeFbxImporter importer;
+		for (UINT i = next++; i < jobs.size(); i = next++) {
+			Job& job = *jobs[i];
+			if (job.sourceHash == 0) continue;
+			auto start = chrono::steady_clock::now();
+
+			FbxData data;
+			if (!mSdkImport && !mManifest.IsNativeRejected(FBX_DIRECTORY + job.asset->fileName, job.sourceHash)) {
+				string report;
+				job.native = importer.Import(FBX_DIRECTORY + job.asset->fileName, job.asset->onlyAnimation, job.asset->zUp, data);
+				if (!job.native) Log("[Cook] " + job.asset->fileName + " : " + importer.GetError() + ", FBX SDK  \n");
+				else if (!NativeFbxImporter::Check(data, report)) {
+					job.native = false;
+					data = FbxData{};
+					Log("[Cook] " + job.asset->fileName + " : ˻  " + report + ", FBX SDK  \n");
+				}
+			}
+			if (!job.native) {
+				if (!extractor) extractor = make_unique<FbxExtractor>();
+				extractor->Extract(job.asset->fileName, job.asset->onlyAnimation, job.asset->zUp, data);
+			}
+			job.mesh = MeshOptimizer::Optimize(data.vertices, data.indices);
+			job.vertexCount = data.vertices.size();
+			job.indexCount = data.indices.size();
+			job.clipCount = data.animations.size();
+
+			// Ŭ ̷   SoA   Ʈ  д. Ÿ ״ ű⸸ Ѵ
+			if (data.boneHierarchy.empty() == false) {
+				if (clipFiles == false) CookedAsset::MakeSkeleton(data, job.skeleton);
+				const Skeleton* skeleton = clipFiles ? FindSkeleton(*job.asset) : &job.skeleton;
+				if (!skeleton) {
+					Log("[Cook] " + job.asset->fileName + " : ̷ " + job.asset->skeletonName + " \n");
+					continue;
+				}
+				SkinnedData::BindClips(*skeleton, data.boneNames, data.animations, GetAnimationCompression());
+				data.bindHash = CookedAsset::GetBindHash(*skeleton, GetAnimationCompression());
+			}
+			job.saved = CookedAsset::Save(CookedAsset::GetCookedPath(job.asset->fileName), data, job.sourceHash,
+				job.asset->onlyAnimation, job.asset->zUp);
+			job.seconds = chrono::duration<float>(chrono::steady_clock::now() - start).count();
+		}
+	};
+
+	UINT workerCount = min(mWorkerCount, (UINT)jobs.size());
+	vector<thread> workers;
+	for (UINT i = 1; i < workerCount; ++i) workers.emplace_back(Work);
+	if (workerCount > 0) Work();
+	for (thread& worker : workers) worker.join();
+}
+
+// SDK (a) Ƽ (b)  ū . ٸ   error  ´.
+static void CompareFbxData(const FbxData& a, const FbxData& b, string& report, string& error)
+{
+	auto Diff3 = [](const XMFLOAT3& x, const XMFLOAT3& y) { return max(max(fabsf(x.x - y.x), fabsf(x.y - y.y)), fabsf(x.z - y.z)); };
+	auto Diff4 = [](const XMFLOAT4& x, const XMFLOAT4& y) { return max(max(fabsf(x.x - y.x), fabsf(x.y - y.y)), max(fabsf(x.z - y.z), fabsf(x.w - y.w))); };
+	auto Check = [&](float value, float tolerance, const char* name) {
+		if (value > tolerance && error.empty()) error = string{ name } + "  " + to_string(value);
+	};
+
+	char buffer[256];
+	if (a.vertices.size() != b.vertices.size()) error = "  " + to_string(a.vertices.size()) + " / " + to_string(b.vertices.size());
+	else {
+		float position = 0.0f, normal = 0.0f, uv = 0.0f, weight = 0.0f;
+		size_t boneIndex = 0;
+		for (size_t i = 0; i < a.vertices.size(); ++i) {
+			const Vertex& x = a.vertices[i];
+			const Vertex& y = b.vertices[i];
+			position = max(position, Diff3(x.position, y.position));
+			normal = max(normal, Diff3(x.normal, y.normal));
+			uv = max(uv, max(fabsf(x.uv.x - y.uv.x), fabsf(x.uv.y - y.uv.y)));
+			weight = max(weight, Diff4(x.weight, y.weight));
+			// ġ    ٲ   ġ ִ ͸ 
+			const float* wx = &x.weight.x;
+			for (int j = 0; j < 4; ++j) if (wx[j] > 0.0f && x.boneIndex[j] != y.boneIndex[j]) { ++boneIndex; break; }
+		}
+		sprintf_s(buffer, "vertices %zu (position %g, normal %g, uv %g, weight %g, bone index %zu)", a.vertices.size(), position, normal, uv, weight, boneIndex);
+		report += buffer;
+		Check(position, 1e-3f, "position");
+		Check(normal, 1e-4f, "normal");
+		Check(uv, 1e-4f, "uv");
+		Check(weight, 1e-4f, "weight");
+		if (boneIndex > 0 && error.empty()) error = "bone index ٸ  " + to_string(boneIndex);
+	}
+
+	if (a.boneHierarchy != b.boneHierarchy || a.boneNames != b.boneNames) {
+		if (error.empty()) error = "  ٸ";
+		return;
+	}
+	if (a.offsetMatrix.size() != b.offsetMatrix.size()) {
+		if (error.empty()) error = "   ٸ";
+		return;
+	}
+	float offset = 0.0f;
+	for (size_t i = 0; i < a.offsetMatrix.size(); ++i) {
+		for (int j = 0; j < 16; ++j) offset = max(offset, fabsf(a.offsetMatrix[i].m[j / 4][j % 4] - b.offsetMatrix[i].m[j / 4][j % 4]));
+	}
+	Check(offset, 1e-3f, "offset");
+
+	if (a.animations.size() != b.animations.size()) {
+		if (error.empty()) error = "Ŭ  " + to_string(a.animations.size()) + " / " + to_string(b.animations.size());
+		return;
+	}
+	float translation = 0.0f, scale = 0.0f, rotation = 0.0f, time = 0.0f;
+	for (auto& [name, clip] : a.animations) {
+		auto other = b.animations.find(name);
+		if (other == b.animations.end() || other->second.BoneAnimations.size() != clip.BoneAnimations.size()) {
+			if (error.empty()) error = name + " Ŭ ų   ٸ";
+			return;
+		}
+		for (size_t bone = 0; bone < clip.BoneAnimations.size(); ++bone) {
+			const vector<Keyframe>& x = clip.BoneAnimations[bone].Keyframes;
+			const vector<Keyframe>& y = other->second.BoneAnimations[bone].Keyframes;
+			if (x.size() != y.size()) {
+				if (error.empty()) error = name + " Ű  ٸ ( " + to_string(bone) + ")";
+				return;
+			}
+			for (size_t k = 0; k < x.size(); ++k) {
+				time = max(time, fabsf(x[k].TimePos - y[k].TimePos));
+				translation = max(translation, Diff3(x[k].Translation, y[k].Translation));
+				scale = max(scale, Diff3(x[k].Scale, y[k].Scale));
+				// q  -q   ȸ̴
+				XMFLOAT4 negative{ -y[k].RotationQuat.x, -y[k].RotationQuat.y, -y[k].RotationQuat.z, -y[k].RotationQuat.w };
+				rotation = max(rotation, min(Diff4(x[k].RotationQuat, y[k].RotationQuat), Diff4(x[k].RotationQuat, negative)));
+			}
+		}
+	}
+	sprintf_s(buffer, ", bones %zu (offset %g), clips %zu (time %g, translation %g, scale %g, rotation %g)",
+		a.boneNames.size(), offset, a.animations.size(), time, translation, scale, rotation);
+	report += buffer;
+	Check(time, 1e-5f, "time");
+	Check(translation, 1e-3f, "translation");
+	Check(scale, 1e-4f, "scale");
+	Check(rotation, 1e-4f, "rotation");
+}
+
+bool AssetCooker::Validate()
+{
+	const vector<FbxAsset>& assets = GetFbxAssets();
+	FbxExtractor extractor;
+	NativeFbxImporter importer;
+	UINT passCount = 0, failCount = 0, fallbackCount = 0;
+	mManifest.Load(COOK_MANIFEST);
+
+	WIN32_FIND_DATAA findData{};
+	HANDLE find = FindFirstFileA(FBX_DIRECTORY "*.fbx", &findData);
+	if (find == INVALID_HANDLE_VALUE) return false;
+	do {
+		string fileName = findData.cFileName;
+		auto it = find_if(assets.begin(), assets.end(), [&](const FbxAsset& asset) { return asset.fileName == fileName; });
+		bool onlyAnimation = it != assets.end() ? it->onlyAnimation : false;
+		bool zUp = it != assets.end() ? it->zUp : true;
+		string sourcePath = FBX_DIRECTORY + fileName;
+		uint64_t sourceHash = mManifest.GetSourceHash(sourcePath, CookedAsset::GetImportSeed(onlyAnimation, zUp));
+
+		FbxData sdk, native;
+		auto start = chrono::steady_clock::now();
+		extractor.Extract(fileName, onlyAnimation, zUp, sdk);
+		float sdkSeconds = chrono::duration<float>(chrono::steady_clock::now() - start).count();
+
+		start = chrono::steady_clock::now();
+		bool imported = importer.Import(FBX_DIRECTORY + fileName, onlyAnimation, zUp, native);
+		float nativeSeconds = chrono::duration<float>(chrono::steady_clock::now() - start).count();
+
+		// Ƽ갡  д    SDK  Ƿ а ƴϴ
+		if (!imported) {
+			++fallbackCount;
+			mManifest.SetNativeRejected(sourcePath, sourceHash, false);
+			Log("[Validate] " + fileName + " : SDK  " + importer.GetError() + "\n");
+			continue;
+		}
+
+		string report, error;
+		CompareFbxData(sdk, native, report, error);
+		error.empty() ? ++passCount : ++failCount;
+		// ٸ    SDK  д´
+		mManifest.SetNativeRejected(sourcePath, sourceHash, !error.empty());
+		char buffer[128];
+		sprintf_s(buffer, " / sdk %.2fs, native %.2fs", sdkSeconds, nativeSeconds);
+		Log("[Validate] " + fileName + " : " + (error.empty() ? "PASS " : "FAIL " + error + "  ") + report + buffer + "\n");
+	} while (FindNextFileA(find, &findData));
+	FindClose(find);
+
+	char buffer[128];
+	sprintf_s(buffer, "[Validate] %u pass, %u fail, %u SDK only\n", passCount, failCount, fallbackCount);
+	Log(buffer);
+	CreateDirectoryA(COOKED_DIRECTORY, nullptr);
+	if (mManifest.IsDirty() && !mManifest.Save(COOK_MANIFEST)) Log("[Validate] " COOK_MANIFEST "  \n");
+	return failCount == 0;
+}
+
+bool AssetCooker::CheckNative()
+{
+	const vector<FbxAsset>& assets = GetFbxAssets();
+	NativeFbxImporter importer;
+	UINT passCount = 0, failCount = 0, fallbackCount = 0;
+	mManifest.Load(COOK_MANIFEST);
+
+	WIN32_FIND_DATAA findData{};
+	HANDLE find = FindFirstFileA(FBX_DIRECTORY "*.fbx", &findData);
+	if (find == INVALID_HANDLE_VALUE) return false;
+	do {
+		string fileName = findData.cFileName;
+		auto it = find_if(assets.begin(), assets.end(), [&](const FbxAsset& asset) { return asset.fileName == fileName; });
+		bool onlyAnimation = it != assets.end() ? it->onlyAnimation : false;
+		bool zUp = it != assets.end() ? it->zUp : true;
+		string sourcePath = FBX_DIRECTORY + fileName;
+		uint64_t sourceHash = mManifest.GetSourceHash(sourcePath, CookedAsset::GetImportSeed(onlyAnimation, zUp));
+
+		FbxData native;
+		if (!importer.Import(sourcePath, onlyAnimation, zUp, native)) {
+			++fallbackCount;
+			Log("[CheckNative] " + fileName + " : SDK  " + importer.GetError() + "\n");
+			continue;
+		}
+		string report;
+		bool passed = NativeFbxImporter::Check(native, report);
+		passed ? ++passCount : ++failCount;
+		// SDK   Validate    ʰ, Ʋ ͸ Ѵ
+		if (!passed) mManifest.SetNativeRejected(sourcePath, sourceHash, true);
+		Log("[CheckNative] " + fileName + " : " + (passed ? "PASS " : "FAIL ") + report + "\n");
+	} while (FindNextFileA(find, &findData));
+	FindClose(find);
+
+	char buffer[128];
+	sprintf_s(buffer, "[CheckNative] %u pass, %u fail, %u SDK only\n", passCount, failCount, fallbackCount);
+	Log(buffer);
+	CreateDirectoryA(COOKED_DIRECTORY, nullptr);
+	if (mManifest.IsDirty() && !mManifest.Save(COOK_MANIFEST)) Log("[CheckNative] " COOK_MANIFEST "  \n");
+	return failCount == 0;
+}
+
+bool AssetCooker::ReportAnimation()
+{
+	const vector<FbxAsset>& assets = GetFbxAssets();
+	unique_ptr<FbxExtractor> extractor;
+	NativeFbxImporter importer;
+	AnimationCompression compression = GetAnimationCompression();
+	compression.Enabled = true;	//      
+	size_t rawKeyBytes = 0, compressedKeyBytes = 0;
+	UINT fileCount = 0, failCount = 0;
+
+	// Ƽ  а,  аų ˻翡 ɸ SDK  д´
+	auto Import = [&](const string& fileName, bool onlyAnimation, bool zUp, FbxData& data) {
+		string report;
+		if (!mSdkImport && importer.Import(FBX_DIRECTORY + fileName, onlyAnimation, zUp, data) && NativeFbxImporter::Check(data, report)) return;
+		data = FbxData{};
+		if (!extractor) extractor = make_unique<FbxExtractor>();
+		extractor->Extract(fileName, onlyAnimation, zUp, data);
+	};
+
+	WIN32_FIND_DATAA findData{};
+	HANDLE find = FindFirstFileA(FBX_DIRECTORY "*.fbx", &findData);
+	if (find == INVALID_HANDLE_VALUE) return false;
+	do {
+		string fileName = findData.cFileName;
+		auto it = find_if(assets.begin(), assets.end(), [&](const FbxAsset& asset) { return asset.fileName == fileName; });
+		FbxAsset asset = it != assets.end() ? *it : FbxAsset{ fileName, false, true, "" };
+
+		FbxData data;
+		Import(fileName, asset.onlyAnimation, asset.zUp, data);
+		if (data.boneHierarchy.empty() || data.animations.empty()) continue;
+
+		// ̷     ó   о д
+		const string& owner = asset.skeletonName.empty() ? fileName : asset.skeletonName;
+		if (asset.skeletonName.empty()) CookedAsset::MakeSkeleton(data, mSkeletons[owner]);
+		else if (FindSkeleton(asset) == nullptr) {
+			auto ownerAsset = find_if(assets.begin(), assets.end(), [&](const FbxAsset& other) { return other.fileName == owner; });
+			FbxData ownerData;
+			if (ownerAsset != assets.end()) Import(owner, ownerAsset->onlyAnimation, ownerAsset->zUp, ownerData);
+			if (ownerData.boneHierarchy.empty()) {
+				++failCount;
+				Log("[AnimReport] " + fileName + " : ̷ " + owner + " 
+");
+				continue;
+			}
+			CookedAsset::MakeSkeleton(ownerData, mSkeletons[owner]);
+		}
+		SkinnedData::BindClips(*FindSkeleton(asset), data.boneNames, data.animations, compression);
+
+		size_t fileRawBytes = 0, fileCompressedBytes = 0;
+		for (auto& [name, clip] : data.animations) {
+			fileRawBytes += clip.RawKeyBytes;
+			fileCompressedBytes += clip.CompressedKeyBytes;
+		}
+		rawKeyBytes += fileRawBytes;
+		compressedKeyBytes += fileCompressedBytes;
+		++fileCount;
+		char buffer[256];
+		sprintf_s(buffer, "[AnimReport] %-24s clips %zu, keys %zu -> %zu bytes (%.1f%%)\n", fileName.c_str(), data.animations.size(),
+			fileRawBytes, fileCompressedBytes, fileRawBytes > 0 ? 100.0f * fileCompressedBytes / fileRawBytes : 100.0f);
+		Log(buffer);
+	} while (FindNextFileA(find, &findData));
+	FindClose(find);
+
+	char buffer[256];
+	sprintf_s(buffer, "[AnimReport] %u files, keys %.2f MB -> %.2f MB (%.1f%%), error translation %g, rotation %g rad, scale %g, cooked compression %s\n",
+		fileCount, rawKeyBytes / 1048576.0f, compressedKeyBytes / 1048576.0f, rawKeyBytes > 0 ? 100.0f * compressedKeyBytes / rawKeyBytes : 100.0f,
+		compression.TranslationError, compression.RotationError, compression.ScaleError, GetAnimationCompression().Enabled ? "on" : "off");
+	Log(buffer);
+	return failCount == 0;
+}
+
+void AssetCooker::Log(const string& message)
+{
+	printf("%s", message.c_str());
+	OutputDebugStringA(message.c_str());
+}
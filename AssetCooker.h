@@ -0,0 +1,74 @@
+#pragma once
+#include "stdafx.h"
+#include "CookedAsset.h"
+#include "MeshOptimizer.h"
+
+//   fbx   .    ResourceManager::AcquireMeshes  ʿ ͸   εѴ.
+struct FbxAsset
+{
+	string fileName;
+	bool onlyAnimation;
+	bool zUp;
+	string skeletonName;	//      ̷ ȴ
+};
+
+const vector<FbxAsset>& GetFbxAssets();
+
+// ̷  -> (Info.h  BoyAnim, TigerAnim)   Ŭ . °  ĳʹ  ִ.
+const vector<string>& GetAnimStates(const string& skeletonName);
+
+//   Ŭ   . Ÿ    Ŭ , ƴϸ ٽ ´.
+const AnimationCompression& GetAnimationCompression();
+
+//   -cook  â   Ŀ.
+// Fbxs  fbx   +   ؽؼ,   ؽÿ ٸ ͸ ٽ Ѵ.
+//  ۾ 帶 FbxExtractor  ϳ ΰ  Ѵ. Ŭ ̷濡  SoA   Ʈ  Ƿ
+// ̷   ϰ, ̷ ٲ  Ŭ ϵ鵵 ٽ Ѵ.
+// fbx  NativeFbxImporter   а,  аų NativeFbxImporter::Check   ϸ FbxExtractor  д´.
+// Validate  CheckNative  Ʋȴٰ   ٷ FbxExtractor  д´. sdkImport   FbxExtractor  д´.
+// Textures  dds  ̸ ״ д ̶ ؽø Ͽ , Ÿ   ϰ ´ .
+class AssetCooker
+{
+public:
+	AssetCooker(UINT workerCount, bool sdkImport = false);
+	// force  ؽð Ƶ  ٽ Ѵ.  ۾  false
+	bool Run(bool force);
+	// Fbxs   fbx  FbxExtractor  NativeFbxImporter  о  Ѵ.
+	// Ͽ   ⺻ (ִϸ̼ , Z ) д´. ٸ   false
+	// ٸ   Ͽ ܼ, Ŀ Ÿ   SDK  а Ѵ.
+	bool Validate();
+	// SDK  Fbxs   fbx  NativeFbxImporter  а NativeFbxImporter::Check  ˻Ѵ.
+	// ϸ PASS / FAIL / SDK(Ƽ갡  )  , FAIL  Ͽ . FAIL   false
+	bool CheckNative();
+	// Fbxs   fbx  Ŭ ̷濡   , ϸ Ű ޸𸮰 󸶳 ִ ´.
+	//   ǵ帮 ʴ´. ̷ ã  Ŭ   false
+	bool ReportAnimation();
+private:
+	struct Job
+	{
+		const FbxAsset* asset = nullptr;
+		uint64_t sourceHash = 0;
+		bool saved = false;
+		bool native = false;	// NativeFbxImporter  о
+		MeshOptimizer::Report mesh;
+		size_t vertexCount = 0;
+		size_t indexCount = 0;
+		size_t clipCount = 0;
+		float seconds = 0.0f;
+		Skeleton skeleton;	//    ̷̸ ä
+	};
+	void CollectFbxJobs(bool force);
+	void HashRawFiles(const string& pattern, const string& directory);
+	void CookJobs();
+	void RunJobs(bool clipFiles);	// clipFiles  ٸ  ̷  ͸, ƴϸ 
+	const Skeleton* FindSkeleton(const FbxAsset& asset);	// ߰ų  Ͽ  ̷
+	void Log(const string& message);
+private:
+	UINT mWorkerCount = 1;
+	bool mSdkImport = false;
+	CookManifest mManifest;
+	vector<Job> mJobs;
+	unordered_map<string, Skeleton> mSkeletons;	// ̷  ̸ -> ̷
+	UINT mUpToDateCount = 0;
+	UINT mRawFileCount = 0;
+};
@@ -168,6 +168,13 @@ void Collider::UpdateOBB(XMMATRIX M)
 {
 	mBaseOBB.Transform(mOBB, M);
 	XMStoreFloat4(&mOBB.Orientation, XMQuaternionNormalize(XMLoadFloat4(&mOBB.Orientation)));
+
+	// ȸ   밪 extents   ϸ AABB   ũⰡ ȴ.
+	XMMATRIX R = XMMatrixRotationQuaternion(XMLoadFloat4(&mOBB.Orientation));
+	XMVECTOR e = XMLoadFloat3(&mOBB.Extents);
+	XMVECTOR extents = XMVectorAbs(R.r[0]) * XMVectorSplatX(e) + XMVectorAbs(R.r[1]) * XMVectorSplatY(e) + XMVectorAbs(R.r[2]) * XMVectorSplatZ(e);
+	mAABB.Center = mOBB.Center;
+	XMStoreFloat3(&mAABB.Extents, extents);
 }
 
 BoundingOrientedBox& Collider::GetOBB()
@@ -175,14 +182,55 @@ BoundingOrientedBox& Collider::GetOBB()
 	return mOBB;
 }
 
-Animation::Animation(string initFileName) : mCurrentFileName{initFileName}
+void Collider::SetActive(bool active)
+{
+	mActive = active;
+}
+
+bool Collider::IsActive()
+{
+	return mActive;
+}
+
+BoundingBox& Collider::GetAABB()
+{
+	return mAABB;
+}
+
+void Collider::SetTrigger(bool trigger)
+{
+	mTrigger = trigger;
+}
+
+bool Collider::IsTrigger()
+{
+	return mTrigger;
+}
+
+void Collider::SetActivator(bool activator)
+{
+	mActivator = activator;
+}
+
+bool Collider::IsActivator()
+{
+	return mActivator;
+}
+
+Animation::Animation(const AnimationSet& animSet, int initAnim) : mAnimSet{ &animSet }, mCurrentAnim{ initAnim }
 {
+	mClip = &animSet.Get(animSet.GetStateIndex(initAnim));
+	//  AnimationSet  Ŭ ̷ Ƿ   .
+	mKeyCursors.assign(mClip->BoneCount, 0);
 }
 
-bool Animation::ResetAnim(string fileName, float time)
+bool Animation::ResetAnim(int anim, float time)
 {
-	if (fileName == mCurrentFileName) return false;
-	mCurrentFileName = fileName;
+	if (anim == mCurrentAnim) return false;
+	mCurrentAnim = anim;
+	mClip = &mAnimSet->Get(mAnimSet->GetStateIndex(anim));
 	mAnimationTime = time;
+	std::fill(mKeyCursors.begin(), mKeyCursors.end(), 0);
+	mPaletteValid = false;
 	return true;
 }
@@ -73,10 +73,14 @@ struct Texture : public Component
 
 struct Animation : public Component
 {
-	Animation(string initFileName);
-	bool ResetAnim(string fileName, float time);
+	Animation(const AnimationSet& animSet, int initAnim = 0);
+	bool ResetAnim(int anim, float time);
 	float mAnimationTime = 0.0f;
-	string mCurrentFileName = "";
+	const AnimationSet* mAnimSet = nullptr;	// ĳ Ŭ. ̷  .
+	int mCurrentAnim = 0;					//  (Info.h  BoyAnim, TigerAnim)
+	const ClipInfo* mClip = nullptr;		// mCurrentAnim  Ŭ. ٲ  mAnimSet  ã  ȣ ´.
+	vector<UINT> mKeyCursors;	//  ø ƴ Ŭ,   Ű ġ
+	bool mPaletteValid = false;	//  ۿ  Ŭ ȷƮ  ִ
 };
 
 class Gravity : public Component
@@ -98,7 +102,18 @@ public:
 	Collider(XMFLOAT3&& center = { 0.0f, 0.0f, 0.0f }, XMFLOAT3&& extents = { 0.5f, 0.5f, 0.5f }, XMFLOAT4&& orientation = { 0.0f, 0.0f, 0.0f, 1.0f });
 	void UpdateOBB(XMMATRIX M);
 	BoundingOrientedBox& GetOBB();
+	BoundingBox& GetAABB();
+	void SetActive(bool active);
+	bool IsActive();
+	void SetTrigger(bool trigger);
+	bool IsTrigger();
+	void SetActivator(bool activator);
+	bool IsActivator();
 private:
 	BoundingOrientedBox mBaseOBB{};
 	BoundingOrientedBox mOBB{};
+	BoundingBox mAABB{}; // mOBB  δ  AABB. Ʈ ˻翡 
+	bool mActive = true; // false  浹 ˻翡 
+	bool mTrigger = false; // о ʰ Ȱڿ ħ ˸
+	bool mActivator = false; // ƮŸ ߵŰ  (÷̾)
 };
\ No newline at end of file
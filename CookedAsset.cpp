@@ -0,0 +1,515 @@
+#include <fstream>
+#include <algorithm>
+#include <type_traits>
+#include "CookedAsset.h"
+#include "MeshOptimizer.h"
+
+static_assert(is_trivially_copyable<Vertex>::value, "Vertex  ״   ־ Ѵ");
+static_assert(is_trivially_copyable<Keyframe>::value, "Keyframe  ״   ־ Ѵ");
+static_assert(sizeof(Keyframe) == sizeof(float) * 11, "Keyframe  е   ȴ");
+static_assert(sizeof(CookedTrack) == sizeof(uint32_t) * 3, "CookedTrack  е   ȴ");
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const string& path)
+{
+	Close();
+	mFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (mFile == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(mFile, &size) || size.QuadPart == 0) {
+		Close();
+		return false;
+	}
+	mSize = size.QuadPart;
+
+	mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mMapping) {
+		Close();
+		return false;
+	}
+	mData = reinterpret_cast<const uint8_t*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+	if (!mData) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (mData) UnmapViewOfFile(mData);
+	if (mMapping) CloseHandle(mMapping);
+	if (mFile != INVALID_HANDLE_VALUE) CloseHandle(mFile);
+	mData = nullptr;
+	mMapping = nullptr;
+	mFile = INVALID_HANDLE_VALUE;
+	mSize = 0;
+}
+
+const uint8_t* MappedFile::GetData()
+{
+	return mData;
+}
+
+uint64_t MappedFile::GetSize()
+{
+	return mSize;
+}
+
+namespace
+{
+	//  ̾ ̸鼭   ġ ش.
+	class Writer
+	{
+	public:
+		uint64_t Append(const void* data, size_t size)
+		{
+			Align();
+			uint64_t offset = mBytes.size();
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+			mBytes.insert(mBytes.end(), bytes, bytes + size);
+			return offset;
+		}
+		template<typename T>
+		uint64_t Append(const vector<T>& data)
+		{
+			return Append(data.data(), sizeof(T) * data.size());
+		}
+		vector<uint8_t>& GetBytes()
+		{
+			return mBytes;
+		}
+	private:
+		void Align()
+		{
+			mBytes.resize((mBytes.size() + 15) & ~size_t(15), 0);
+		}
+		vector<uint8_t> mBytes;
+	};
+
+	CookedString AddString(string& table, const string& str)
+	{
+		CookedString result{ (uint32_t)table.size(), (uint32_t)str.size() };
+		table += str;
+		return result;
+	}
+
+	//   ȿ ִ ȮѴ. ߸  дٰ  ʱ ̴.
+	bool InRange(uint64_t fileSize, uint64_t offset, uint64_t size)
+	{
+		return offset <= fileSize && size <= fileSize - offset;
+	}
+
+	//  vector  ű.  θ  ȮѴ.
+	template<typename T>
+	void CopyBlock(const uint8_t* base, uint64_t offset, uint64_t count, vector<T>& out)
+	{
+		const T* data = reinterpret_cast<const T*>(base + offset);
+		out.assign(data, data + count);
+	}
+}
+
+bool CookManifest::Load(const string& path)
+{
+	lock_guard<mutex> lock{ mLock };
+	mEntries.clear();
+	mDirty = false;
+	ifstream in{ path };
+	if (!in) return false;
+
+	//  ٿ ϳ,     /  /  ð / ũ / ؽ / Ƽ갡 Ʋ ؽ ( 0)
+	string line;
+	while (getline(in, line)) {
+		size_t tab = line.find('\t');
+		if (tab == string::npos) continue;
+		Entry entry;
+		int count = sscanf_s(line.c_str() + tab + 1, "%llx\t%llu\t%llu\t%llx\t%llx", &entry.seed, &entry.writeTime, &entry.size, &entry.hash, &entry.rejectedHash);
+		if (count < 4) continue;
+		mEntries[line.substr(0, tab)] = entry;
+	}
+	return true;
+}
+
+bool CookManifest::Save(const string& path)
+{
+	lock_guard<mutex> lock{ mLock };
+	string tempPath = path + ".tmp";
+	{
+		ofstream out{ tempPath, ios::trunc };
+		if (!out) return false;
+		char buffer[128];
+		for (auto& [source, entry] : mEntries) {
+			sprintf_s(buffer, "\t%016llx\t%llu\t%llu\t%016llx\t%016llx\n", entry.seed, entry.writeTime, entry.size, entry.hash, entry.rejectedHash);
+			out << source << buffer;
+		}
+		if (!out) return false;
+	}
+	if (MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) == 0) return false;
+	mDirty = false;
+	return true;
+}
+
+uint64_t CookManifest::GetSourceHash(const string& sourcePath, uint64_t seed)
+{
+	uint64_t writeTime = 0;
+	uint64_t size = 0;
+	if (!CookedAsset::GetFileInfo(sourcePath, writeTime, size)) return 0;
+
+	lock_guard<mutex> lock{ mLock };
+	auto it = mEntries.find(sourcePath);
+	if (it != mEntries.end() && it->second.seed == seed && it->second.writeTime == writeTime && it->second.size == size) {
+		return it->second.hash;
+	}
+
+	//  ð ٲ   ؽõ Ƿ   ״   ִ.
+	Entry& entry = mEntries[sourcePath];
+	entry.seed = seed;
+	entry.writeTime = writeTime;
+	entry.size = size;
+	entry.hash = CookedAsset::HashFile(sourcePath, seed);
+	mDirty = true;
+	return entry.hash;
+}
+
+bool CookManifest::IsNativeRejected(const string& sourcePath, uint64_t sourceHash)
+{
+	lock_guard<mutex> lock{ mLock };
+	auto it = mEntries.find(sourcePath);
+	return it != mEntries.end() && sourceHash != 0 && it->second.rejectedHash == sourceHash;
+}
+
+void CookManifest::SetNativeRejected(const string& sourcePath, uint64_t sourceHash, bool rejected)
+{
+	lock_guard<mutex> lock{ mLock };
+	auto it = mEntries.find(sourcePath);
+	if (it == mEntries.end()) return;
+	uint64_t rejectedHash = rejected ? sourceHash : 0;
+	if (it->second.rejectedHash == rejectedHash) return;
+	it->second.rejectedHash = rejectedHash;
+	mDirty = true;
+}
+
+bool CookManifest::IsRawFileCurrent(const string& path)
+{
+	uint64_t writeTime = 0;
+	uint64_t size = 0;
+	if (!CookedAsset::GetFileInfo(path, writeTime, size)) return false;
+
+	lock_guard<mutex> lock{ mLock };
+	auto it = mEntries.find(path);
+	if (it == mEntries.end()) return false;
+	if (it->second.writeTime == writeTime && it->second.size == size) return true;
+	//  ð ٲ  
+	return it->second.size == size && CookedAsset::HashFile(path, it->second.seed) == it->second.hash;
+}
+
+bool CookManifest::IsDirty()
+{
+	lock_guard<mutex> lock{ mLock };
+	return mDirty;
+}
+
+bool CookedAsset::GetFileInfo(const string& path, uint64_t& writeTime, uint64_t& size)
+{
+	WIN32_FILE_ATTRIBUTE_DATA attribute{};
+	if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &attribute)) return false;
+	writeTime = (uint64_t(attribute.ftLastWriteTime.dwHighDateTime) << 32) | attribute.ftLastWriteTime.dwLowDateTime;
+	size = (uint64_t(attribute.nFileSizeHigh) << 32) | attribute.nFileSizeLow;
+	return true;
+}
+
+uint64_t CookedAsset::HashFile(const string& path, uint64_t seed)
+{
+	MappedFile file;
+	if (!file.Open(path)) return 0;
+
+	return HashFnv1a(file.GetData(), file.GetSize(), FNV_OFFSET_BASIS ^ seed);
+}
+
+uint64_t CookedAsset::GetImportSeed(bool onlyAnimation, bool zUp)
+{
+	//   ٲ  ؽð ٲ  ´.
+	return (uint64_t(COOKED_VERSION) << 8) | (uint64_t(onlyAnimation) << 1) | uint64_t(zUp);
+}
+
+string CookedAsset::GetCookedPath(const string& fileName)
+{
+	return COOKED_DIRECTORY + fileName + ".cooked";
+}
+
+bool CookedAsset::ReadHeader(const string& path, CookedHeader& header)
+{
+	ifstream in{ path, ios::binary };
+	if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+	return header.magic == COOKED_MAGIC && header.version == COOKED_VERSION;
+}
+
+void CookedAsset::MakeSkeleton(const FbxData& data, Skeleton& skeleton)
+{
+	skeleton.BoneHierarchy = data.boneHierarchy;
+	skeleton.BoneNames = data.boneNames;
+	skeleton.BoneOffsets = data.offsetMatrix;
+	XMFLOAT4X4 identity;
+	XMStoreFloat4x4(&identity, XMMatrixIdentity());
+	skeleton.BoneOffsets.resize(skeleton.BoneHierarchy.size(), identity);
+}
+
+uint64_t CookedAsset::GetBindHash(const Skeleton& skeleton, const AnimationCompression& compression)
+{
+	uint64_t hash = FNV_OFFSET_BASIS ^ COOKED_VERSION;
+	hash = HashFnv1a(skeleton.BoneHierarchy.data(), sizeof(int) * skeleton.BoneHierarchy.size(), hash);
+	hash = HashFnv1a(skeleton.BoneOffsets.data(), sizeof(XMFLOAT4X4) * skeleton.BoneOffsets.size(), hash);
+	for (const string& name : skeleton.BoneNames) hash = HashFnv1a(name.c_str(), name.size() + 1, hash);
+	uint32_t enabled = compression.Enabled;
+	hash = HashFnv1a(&enabled, sizeof(enabled), hash);
+	hash = HashFnv1a(&compression.TranslationError, sizeof(float), hash);
+	hash = HashFnv1a(&compression.RotationError, sizeof(float), hash);
+	hash = HashFnv1a(&compression.ScaleError, sizeof(float), hash);
+	return hash != 0 ? hash : 1;
+}
+
+bool CookedAsset::Save(const string& path, const FbxData& data, uint64_t sourceHash, bool onlyAnimation, bool zUp)
+{
+	Writer writer;
+	CookedHeader header{};
+	writer.Append(&header, sizeof(header));	// ڸ  ΰ  ä
+
+	string strings;
+	header.magic = COOKED_MAGIC;
+	header.version = COOKED_VERSION;
+	header.sourceHash = sourceHash;
+	header.bindHash = data.bindHash;
+	header.onlyAnimation = onlyAnimation;
+	header.zUp = zUp;
+
+	header.vertexCount = (uint32_t)data.vertices.size();
+	header.vertexOffset = writer.Append(data.vertices);
+	header.indexCount = (uint32_t)data.indices.size();
+	if (MeshOptimizer::FitsIndex16(data.vertices.size())) {
+		header.indexSize = sizeof(uint16_t);
+		vector<uint16_t> indices(data.indices.begin(), data.indices.end());
+		header.indexOffset = writer.Append(indices);
+	}
+	else {
+		header.indexSize = sizeof(uint32_t);
+		header.indexOffset = writer.Append(data.indices);
+	}
+
+	header.boneCount = (uint32_t)data.boneHierarchy.size();
+	vector<int32_t> hierarchy(data.boneHierarchy.begin(), data.boneHierarchy.end());
+	header.hierarchyOffset = writer.Append(hierarchy);
+	//   ޽ð ִ Ͽ ִ.    ķ ä.
+	vector<XMFLOAT4X4> offsets = data.offsetMatrix;
+	XMFLOAT4X4 identity;
+	XMStoreFloat4x4(&identity, XMMatrixIdentity());
+	offsets.resize(header.boneCount, identity);
+	header.offsetMatrixOffset = writer.Append(offsets);
+	vector<CookedString> boneNames;
+	for (const string& name : data.boneNames) boneNames.push_back(AddString(strings, name));
+	boneNames.resize(header.boneCount, CookedString{});
+	header.boneNameOffset = writer.Append(boneNames);
+
+	// ̸  Ἥ  Է̸    Ѵ.
+	vector<string> clipNames;
+	for (const auto& clip : data.animations) clipNames.push_back(clip.first);
+	sort(clipNames.begin(), clipNames.end());
+
+	vector<CookedClip> clips;
+	for (const string& clipName : clipNames) {
+		const AnimationClip& clip = data.animations.at(clipName);
+		CookedClip cooked{};
+		cooked.name = AddString(strings, clipName);
+		cooked.boneCount = (uint32_t)clip.BoneAnimations.size();
+		cooked.keyCount = clip.KeyCount;
+		cooked.sampleRate = clip.SampleRate;
+		cooked.startTime = clip.StartTime;
+		cooked.soaBoneStride = clip.SoABoneStride;
+		cooked.trackCount = (uint32_t)clip.Compressed.size();
+		cooked.rawKeyBytes = clip.RawKeyBytes;
+		cooked.compressedKeyBytes = clip.CompressedKeyBytes;
+
+		vector<uint32_t> keyCounts;
+		vector<Keyframe> keys;
+		for (const BoneAnimation& bone : clip.BoneAnimations) {
+			keyCounts.push_back((uint32_t)bone.Keyframes.size());
+			keys.insert(keys.end(), bone.Keyframes.begin(), bone.Keyframes.end());
+		}
+		cooked.keyCountOffset = writer.Append(keyCounts);
+		cooked.keyOffset = writer.Append(keys);
+		cooked.soaOffset = writer.Append(clip.SoA);
+
+		vector<CookedTrack> tracks;
+		vector<uint16_t> translationFrames, rotationFrames, rotations, scaleFrames;
+		vector<XMFLOAT3> translations, scales;
+		for (const CompressedBoneAnimation& bone : clip.Compressed) {
+			tracks.push_back(CookedTrack{ (uint32_t)bone.TranslationFrames.size(), (uint32_t)bone.RotationFrames.size(), (uint32_t)bone.ScaleFrames.size() });
+			translationFrames.insert(translationFrames.end(), bone.TranslationFrames.begin(), bone.TranslationFrames.end());
+			translations.insert(translations.end(), bone.Translations.begin(), bone.Translations.end());
+			rotationFrames.insert(rotationFrames.end(), bone.RotationFrames.begin(), bone.RotationFrames.end());
+			rotations.insert(rotations.end(), bone.Rotations.begin(), bone.Rotations.end());
+			scaleFrames.insert(scaleFrames.end(), bone.ScaleFrames.begin(), bone.ScaleFrames.end());
+			scales.insert(scales.end(), bone.Scales.begin(), bone.Scales.end());
+		}
+		cooked.trackOffset = writer.Append(tracks);
+		cooked.translationFrameOffset = writer.Append(translationFrames);
+		cooked.translationOffset = writer.Append(translations);
+		cooked.rotationFrameOffset = writer.Append(rotationFrames);
+		cooked.rotationOffset = writer.Append(rotations);
+		cooked.scaleFrameOffset = writer.Append(scaleFrames);
+		cooked.scaleOffset = writer.Append(scales);
+		clips.push_back(cooked);
+	}
+	header.clipCount = (uint32_t)clips.size();
+	header.clipOffset = writer.Append(clips);
+	header.stringOffset = writer.Append(strings.data(), strings.size());
+
+	vector<uint8_t>& bytes = writer.GetBytes();
+	memcpy(bytes.data(), &header, sizeof(header));
+
+	// ٸ  ̸   ٲ㼭,     ʰ Ѵ.
+	string tempPath = path + ".tmp";
+	{
+		ofstream out{ tempPath, ios::binary | ios::trunc };
+		if (!out) return false;
+		out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+		if (!out) return false;
+	}
+	return MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+}
+
+bool CookedAsset::Load(const string& path, uint64_t sourceHash, bool onlyAnimation, bool zUp, FbxData& data)
+{
+	MappedFile file;
+	if (!file.Open(path)) return false;
+	const uint8_t* base = file.GetData();
+	uint64_t size = file.GetSize();
+
+	if (size < sizeof(CookedHeader)) return false;
+	CookedHeader header;
+	memcpy(&header, base, sizeof(header));
+	if (header.magic != COOKED_MAGIC || header.version != COOKED_VERSION) return false;
+	if (header.onlyAnimation != (uint32_t)onlyAnimation || header.zUp != (uint32_t)zUp) return false;
+	//  ٲ ٽ ؾ Ѵ.    ϸ .
+	if (sourceHash != 0 && header.sourceHash != sourceHash) return false;
+
+	if (!InRange(size, header.vertexOffset, sizeof(Vertex) * uint64_t(header.vertexCount))) return false;
+	if (header.indexSize != sizeof(uint16_t) && header.indexSize != sizeof(uint32_t)) return false;
+	if (!InRange(size, header.indexOffset, header.indexSize * uint64_t(header.indexCount))) return false;
+	if (!InRange(size, header.hierarchyOffset, sizeof(int32_t) * uint64_t(header.boneCount))) return false;
+	if (!InRange(size, header.offsetMatrixOffset, sizeof(XMFLOAT4X4) * uint64_t(header.boneCount))) return false;
+	if (!InRange(size, header.boneNameOffset, sizeof(CookedString) * uint64_t(header.boneCount))) return false;
+	if (!InRange(size, header.clipOffset, sizeof(CookedClip) * uint64_t(header.clipCount))) return false;
+	if (!InRange(size, header.stringOffset, 0)) return false;
+	const char* strings = reinterpret_cast<const char*>(base + header.stringOffset);
+	uint64_t stringSize = size - header.stringOffset;
+	auto ReadString = [&](const CookedString& str, string& out) {
+		if (!InRange(stringSize, str.offset, str.length)) return false;
+		out.assign(strings + str.offset, str.length);
+		return true;
+	};
+
+	FbxData result;
+	const Vertex* vertices = reinterpret_cast<const Vertex*>(base + header.vertexOffset);
+	result.vertices.assign(vertices, vertices + header.vertexCount);
+	if (header.indexSize == sizeof(uint16_t)) {
+		const uint16_t* indices = reinterpret_cast<const uint16_t*>(base + header.indexOffset);
+		result.indices.assign(indices, indices + header.indexCount);
+	}
+	else {
+		const uint32_t* indices = reinterpret_cast<const uint32_t*>(base + header.indexOffset);
+		result.indices.assign(indices, indices + header.indexCount);
+	}
+	for (uint32_t index : result.indices) {
+		if (index >= header.vertexCount) return false;
+	}
+
+	const int32_t* hierarchy = reinterpret_cast<const int32_t*>(base + header.hierarchyOffset);
+	result.boneHierarchy.assign(hierarchy, hierarchy + header.boneCount);
+	const XMFLOAT4X4* offsets = reinterpret_cast<const XMFLOAT4X4*>(base + header.offsetMatrixOffset);
+	result.offsetMatrix.assign(offsets, offsets + header.boneCount);
+	const CookedString* boneNames = reinterpret_cast<const CookedString*>(base + header.boneNameOffset);
+	result.boneNames.resize(header.boneCount);
+	for (uint32_t i = 0; i < header.boneCount; ++i) {
+		if (!ReadString(boneNames[i], result.boneNames[i])) return false;
+	}
+
+	const CookedClip* clips = reinterpret_cast<const CookedClip*>(base + header.clipOffset);
+	for (uint32_t c = 0; c < header.clipCount; ++c) {
+		const CookedClip& cooked = clips[c];
+		string name;
+		if (!ReadString(cooked.name, name)) return false;
+		if (!InRange(size, cooked.keyCountOffset, sizeof(uint32_t) * uint64_t(cooked.boneCount))) return false;
+		const uint32_t* keyCounts = reinterpret_cast<const uint32_t*>(base + cooked.keyCountOffset);
+		uint64_t totalKeys = 0;
+		for (uint32_t b = 0; b < cooked.boneCount; ++b) totalKeys += keyCounts[b];
+		if (!InRange(size, cooked.keyOffset, sizeof(Keyframe) * totalKeys)) return false;
+
+		//    ٽ  Ƿ Ŭ  ǥ  ⼭ 
+		bool uniform = cooked.sampleRate > 0.0f;
+		if (uniform && (cooked.keyCount < 2 || cooked.keyCount > 0xffff)) return false;
+		uint64_t soaCount = uint64_t(cooked.keyCount) * AnimationClip::SOA_STREAM_COUNT * cooked.soaBoneStride;
+		if (cooked.soaBoneStride != 0 && (!uniform || cooked.soaBoneStride % 4 != 0 || cooked.soaBoneStride < cooked.boneCount)) return false;
+		if (!InRange(size, cooked.soaOffset, sizeof(float) * soaCount)) return false;
+		if (cooked.trackCount != 0 && (!uniform || cooked.trackCount != cooked.boneCount)) return false;
+		if (!InRange(size, cooked.trackOffset, sizeof(CookedTrack) * uint64_t(cooked.trackCount))) return false;
+		for (uint32_t b = 0; b < cooked.boneCount; ++b) {
+			if (cooked.trackCount != 0 || cooked.soaBoneStride != 0) continue;
+			if (keyCounts[b] == 0 || (uniform && keyCounts[b] != cooked.keyCount)) return false;
+		}
+		const CookedTrack* tracks = reinterpret_cast<const CookedTrack*>(base + cooked.trackOffset);
+		uint64_t translationCount = 0, rotationCount = 0, scaleCount = 0;
+		for (uint32_t b = 0; b < cooked.trackCount; ++b) {
+			if (tracks[b].translationCount == 0 || tracks[b].rotationCount == 0 || tracks[b].scaleCount == 0) return false;
+			translationCount += tracks[b].translationCount;
+			rotationCount += tracks[b].rotationCount;
+			scaleCount += tracks[b].scaleCount;
+		}
+		if (!InRange(size, cooked.translationFrameOffset, sizeof(uint16_t) * translationCount)) return false;
+		if (!InRange(size, cooked.translationOffset, sizeof(XMFLOAT3) * translationCount)) return false;
+		if (!InRange(size, cooked.rotationFrameOffset, sizeof(uint16_t) * rotationCount)) return false;
+		if (!InRange(size, cooked.rotationOffset, sizeof(uint16_t) * 3 * rotationCount)) return false;
+		if (!InRange(size, cooked.scaleFrameOffset, sizeof(uint16_t) * scaleCount)) return false;
+		if (!InRange(size, cooked.scaleOffset, sizeof(XMFLOAT3) * scaleCount)) return false;
+
+		//    ״ ű. Ű ϳ Ǯų ٽ  ʴ´
+		AnimationClip& clip = result.animations[name];
+		clip.SampleRate = cooked.sampleRate;
+		clip.StartTime = cooked.startTime;
+		clip.KeyCount = cooked.keyCount;
+		clip.RawKeyBytes = cooked.rawKeyBytes;
+		clip.CompressedKeyBytes = cooked.compressedKeyBytes;
+		clip.BoneAnimations.resize(cooked.boneCount);
+		uint64_t keyOffset = cooked.keyOffset;
+		for (uint32_t b = 0; b < cooked.boneCount; ++b) {
+			CopyBlock(base, keyOffset, keyCounts[b], clip.BoneAnimations[b].Keyframes);
+			keyOffset += sizeof(Keyframe) * keyCounts[b];
+		}
+		CopyBlock(base, cooked.soaOffset, soaCount, clip.SoA);
+		clip.SoABoneStride = cooked.soaBoneStride;
+
+		clip.Compressed.resize(cooked.trackCount);
+		uint64_t translation = 0, rotation = 0, scale = 0;
+		for (uint32_t b = 0; b < cooked.trackCount; ++b) {
+			CompressedBoneAnimation& bone = clip.Compressed[b];
+			const CookedTrack& track = tracks[b];
+			CopyBlock(base, cooked.translationFrameOffset + sizeof(uint16_t) * translation, track.translationCount, bone.TranslationFrames);
+			CopyBlock(base, cooked.translationOffset + sizeof(XMFLOAT3) * translation, track.translationCount, bone.Translations);
+			CopyBlock(base, cooked.rotationFrameOffset + sizeof(uint16_t) * rotation, track.rotationCount, bone.RotationFrames);
+			CopyBlock(base, cooked.rotationOffset + sizeof(uint16_t) * 3 * rotation, uint64_t(track.rotationCount) * 3, bone.Rotations);
+			CopyBlock(base, cooked.scaleFrameOffset + sizeof(uint16_t) * scale, track.scaleCount, bone.ScaleFrames);
+			CopyBlock(base, cooked.scaleOffset + sizeof(XMFLOAT3) * scale, track.scaleCount, bone.Scales);
+			translation += track.translationCount;
+			rotation += track.rotationCount;
+			scale += track.scaleCount;
+		}
+	}
+	result.bindHash = header.bindHash;
+
+	data = move(result);
+	return true;
+}
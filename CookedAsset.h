@@ -0,0 +1,159 @@
+#pragma once
+#include "stdafx.h"
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include "Info.h"
+#include "SkinnedData.h"
+#define COOKED_MAGIC 0x31444B43	// "CKD1"
+#define COOKED_VERSION 5
+#define FBX_DIRECTORY "./Fbxs/"
+#define COOKED_DIRECTORY "./Cooked/"
+#define COOK_MANIFEST "./Cooked/manifest.txt"
+
+// FbxExtractor   Ͽ ̾Ƴ  .  ϵ   ´.
+struct FbxData
+{
+	vector<Vertex> vertices;
+	vector<uint32_t> indices;	//   ε  ׸.   MeshOptimizer::WeldVertices  
+	vector<int> boneHierarchy;
+	vector<string> boneNames;
+	vector<XMFLOAT4X4> offsetMatrix;
+	unordered_map<string, AnimationClip> animations;
+	// 0  ƴϸ animations  SkinnedData::BindClips  ̷濡  ִ. (CookedAsset::GetBindHash)
+	uint64_t bindHash = 0;
+};
+
+//   .    ó Ʈ ġ Ű 16 Ʈ ̴.
+//    ޸𸮿    ״ 縸 ϰ ؼ  ʴ´.
+// Ŭ ̷   SoA   Ʈ  ä  ִ.
+struct CookedHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t sourceHash;	//  fbx    ؽ (CookedAsset::HashFile)
+	uint64_t bindHash;		// Ŭ  ̷   ؽ. Ŭ  0
+	uint32_t onlyAnimation;
+	uint32_t zUp;
+	uint32_t vertexCount;
+	uint32_t boneCount;
+	uint32_t clipCount;
+	uint32_t indexCount;
+	uint32_t indexSize;		// 2 Ǵ 4.  65536  ϸ 16 Ʈ 
+	uint32_t padding;
+	uint64_t vertexOffset;		// Vertex[vertexCount]
+	uint64_t indexOffset;		// uint16 Ǵ uint32[indexCount]
+	uint64_t hierarchyOffset;	// int32[boneCount]
+	uint64_t offsetMatrixOffset;	// XMFLOAT4X4[boneCount]
+	uint64_t boneNameOffset;	// CookedString[boneCount]
+	uint64_t clipOffset;		// CookedClip[clipCount]
+	uint64_t stringOffset;		// ڿ 
+};
+
+struct CookedString
+{
+	uint32_t offset;	// stringOffset 
+	uint32_t length;
+};
+
+// AnimationClip ϳ. Ű, SoA,  Ʈ  Ŭ  ͸  ְ   0 ̴.
+struct CookedClip
+{
+	CookedString name;
+	uint32_t boneCount;			// ̷  
+	uint32_t keyCount;			//  ø̸   Ű , ƴϸ 0
+	float sampleRate;
+	float startTime;
+	uint32_t soaBoneStride;
+	uint32_t trackCount;		//  Ʈ . 0  ƴϸ boneCount  
+	uint64_t rawKeyBytes;
+	uint64_t compressedKeyBytes;
+	uint64_t keyCountOffset;	// uint32[boneCount]
+	uint64_t keyOffset;			//   ̾  Keyframe
+	uint64_t soaOffset;			// float[keyCount * SOA_STREAM_COUNT * soaBoneStride]
+	uint64_t trackOffset;		// CookedTrack[trackCount]
+	//  Ʈ .   ̾ ٿ   CookedTrack  ִ
+	uint64_t translationFrameOffset;	// uint16
+	uint64_t translationOffset;			// XMFLOAT3
+	uint64_t rotationFrameOffset;		// uint16
+	uint64_t rotationOffset;			// uint16 * 3
+	uint64_t scaleFrameOffset;			// uint16
+	uint64_t scaleOffset;				// XMFLOAT3
+};
+
+// CompressedBoneAnimation ϳ Ű 
+struct CookedTrack
+{
+	uint32_t translationCount;
+	uint32_t rotationCount;
+	uint32_t scaleCount;
+};
+
+//  ϳ б  Ѵ.
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile();
+
+	bool Open(const string& path);
+	void Close();
+	const uint8_t* GetData();
+	uint64_t GetSize();
+private:
+	HANDLE mFile = INVALID_HANDLE_VALUE;
+	HANDLE mMapping = nullptr;
+	const uint8_t* mData = nullptr;
+	uint64_t mSize = 0;
+};
+
+//   ؽ .  ð ũⰡ ״θ ٽ ؽ ʴ´.
+// Ŀ  Ÿ о,       Ȯϴ  .
+class CookManifest
+{
+public:
+	bool Load(const string& path);
+	bool Save(const string& path);
+	// seed   .   0
+	uint64_t GetSourceHash(const string& sourcePath, uint64_t seed);
+	// -validate  -checknative    Ƽ  Ʋȴٰ ߴ.  ڷ  ٲ false
+	bool IsNativeRejected(const string& sourcePath, uint64_t sourceHash);
+	void SetNativeRejected(const string& sourcePath, uint64_t sourceHash, bool rejected);
+	// ״ д (dds, ̸) Ŀ   ״.  ų  ٲ false
+	//  ġ Ƿ Ŀ ٽ    false 
+	bool IsRawFileCurrent(const string& path);
+	bool IsDirty();
+private:
+	struct Entry
+	{
+		uint64_t seed = 0;
+		uint64_t writeTime = 0;
+		uint64_t size = 0;
+		uint64_t hash = 0;
+		uint64_t rejectedHash = 0;	// Ƽ  Ʋ   ؽ. 0 ̸ Ʋ  
+	};
+	map<string, Entry> mEntries;	//   -> . ̸  Ἥ  Ź  ´
+	bool mDirty = false;
+	mutex mLock;	// ؽó    ۾ 忡  ȮѴ
+};
+
+namespace CookedAsset
+{
+	//   false
+	bool GetFileInfo(const string& path, uint64_t& writeTime, uint64_t& size);
+	//   FNV-1a ؽ.   0
+	uint64_t HashFile(const string& path, uint64_t seed);
+	uint64_t GetImportSeed(bool onlyAnimation, bool zUp);
+	string GetCookedPath(const string& fileName);
+	//  д´. ų  ٸ false
+	bool ReadHeader(const string& path, CookedHeader& header);
+	// ޽ð ִ   ̷ .      ̴
+	void MakeSkeleton(const FbxData& data, Skeleton& skeleton);
+	// Ŭ   ϴ ̷    ؽ. 0  ƴϴ
+	uint64_t GetBindHash(const Skeleton& skeleton, const AnimationCompression& compression);
+	bool Save(const string& path, const FbxData& data, uint64_t sourceHash, bool onlyAnimation, bool zUp);
+	//  ų, // ؽð ٸ false. sourceHash  0 ̸  Ȯ ǳʶڴ
+	bool Load(const string& path, uint64_t sourceHash, bool onlyAnimation, bool zUp, FbxData& data);
+}
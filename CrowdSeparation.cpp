@@ -0,0 +1,124 @@
+#include "CrowdSeparation.h"
+
+CrowdSeparation::CrowdSeparation(float radius) :
+	mRadius{ radius },
+	mInvCellSize{ 1.0f / radius }
+{
+}
+
+void CrowdSeparation::Solve(const vector<XMFLOAT3>& positions, vector<XMFLOAT3>& separations)
+{
+	uint32_t count = (uint32_t)positions.size();
+	separations.resize(count);
+	if (count == 0) return;
+
+	BuildHash(positions);
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		float x = positions[i].x;
+		float z = positions[i].z;
+		int cellX = (int)floorf(x * mInvCellSize);
+		int cellZ = (int)floorf(z * mInvCellSize);
+
+		// ؽ 浹  Ŷ      ȴ´.
+		uint32_t buckets[9];
+		int bucketCount = 0;
+		for (int dz = -1; dz <= 1; ++dz)
+		{
+			for (int dx = -1; dx <= 1; ++dx)
+			{
+				uint32_t bucket = HashCell(cellX + dx, cellZ + dz);
+				bool duplicated = false;
+				for (int k = 0; k < bucketCount; ++k)
+				{
+					if (buckets[k] == bucket) duplicated = true;
+				}
+				if (!duplicated) buckets[bucketCount++] = bucket;
+			}
+		}
+
+		XMVECTOR sum = XMVectorZero();
+		for (int k = 0; k < bucketCount; ++k)
+		{
+			sum += Accumulate(x, z, mBucketStart[buckets[k]], mBucketStart[buckets[k] + 1]);
+		}
+		XMStoreFloat3(&separations[i], XMVector3ClampLength(sum, 0.0f, 1.0f));
+	}
+}
+
+uint32_t CrowdSeparation::HashCell(int cellX, int cellZ)
+{
+	return ((uint32_t)cellX * 73856093u ^ (uint32_t)cellZ * 19349663u) & mBucketMask;
+}
+
+void CrowdSeparation::BuildHash(const vector<XMFLOAT3>& positions)
+{
+	uint32_t count = (uint32_t)positions.size();
+	uint32_t bucketCount = 64;
+	while (bucketCount < count * 2) bucketCount <<= 1;
+	mBucketMask = bucketCount - 1;
+
+	// ī : Ŷ  ->  -> Ѹ
+	mBucketStart.assign(bucketCount + 1, 0);
+	mBucketOf.resize(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		int cellX = (int)floorf(positions[i].x * mInvCellSize);
+		int cellZ = (int)floorf(positions[i].z * mInvCellSize);
+		uint32_t bucket = HashCell(cellX, cellZ);
+		mBucketOf[i] = bucket;
+		++mBucketStart[bucket + 1];
+	}
+	for (uint32_t b = 0; b < bucketCount; ++b)
+	{
+		mBucketStart[b + 1] += mBucketStart[b];
+	}
+
+	mCursor.assign(mBucketStart.begin(), mBucketStart.end() - 1);
+	mSortedX.resize(count + PADDING);
+	mSortedZ.resize(count + PADDING);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		uint32_t dst = mCursor[mBucketOf[i]]++;
+		mSortedX[dst] = positions[i].x;
+		mSortedZ[dst] = positions[i].z;
+	}
+	for (uint32_t i = count; i < count + PADDING; ++i)
+	{
+		mSortedX[i] = 1.0e9f;
+		mSortedZ[i] = 1.0e9f;
+	}
+}
+
+XMVECTOR CrowdSeparation::Accumulate(float x, float z, uint32_t begin, uint32_t end)
+{
+	const XMVECTOR px = XMVectorReplicate(x);
+	const XMVECTOR pz = XMVectorReplicate(z);
+	const XMVECTOR radiusSq = XMVectorReplicate(mRadius * mRadius);
+	const XMVECTOR invRadius = XMVectorReplicate(1.0f / mRadius);
+	const XMVECTOR epsilon = XMVectorReplicate(1.0e-4f);
+	const XMVECTOR lane = XMVectorSet(0.0f, 1.0f, 2.0f, 3.0f);
+
+	XMVECTOR sumX = XMVectorZero();
+	XMVECTOR sumZ = XMVectorZero();
+	for (uint32_t k = begin; k < end; k += 4)
+	{
+		XMVECTOR dx = px - XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&mSortedX[k]));
+		XMVECTOR dz = pz - XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&mSortedZ[k]));
+		XMVECTOR distSq = dx * dx + dz * dz;
+
+		// ݰ ̰, ڱ ڽ ƴϰ,  Ŷ  ȿ ִ ĭ .
+		XMVECTOR mask = XMVectorAndInt(XMVectorLess(distSq, radiusSq), XMVectorGreater(distSq, epsilon));
+		mask = XMVectorAndInt(mask, XMVectorLess(lane, XMVectorReplicate((float)(end - k))));
+
+		// (dx / d) * (1 - d / R) = dx * (1 / d - 1 / R)
+		XMVECTOR weight = XMVectorReciprocalSqrtEst(distSq) - invRadius;
+		weight = XMVectorSelect(XMVectorZero(), weight, mask);
+		sumX += dx * weight;
+		sumZ += dz * weight;
+	}
+
+	XMVECTOR one = XMVectorSplatOne();
+	return XMVectorSet(XMVectorGetX(XMVector4Dot(sumX, one)), 0.0f, XMVectorGetX(XMVector4Dot(sumZ, one)), 0.0f);
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "stdafx.h"
+
+// Ʈ ġ ʰ о и .
+// ġ  ؽ(ī ) Ŷ  , ֺ 9ĭ 4 SIMD  ȴ´.
+class CrowdSeparation
+{
+public:
+	CrowdSeparation(float radius = 12.0f);
+
+	// positions  xz  . separations  Ʈ  1  о  .
+	void Solve(const vector<XMFLOAT3>& positions, vector<XMFLOAT3>& separations);
+private:
+	uint32_t HashCell(int cellX, int cellZ);
+	void BuildHash(const vector<XMFLOAT3>& positions);
+	XMVECTOR Accumulate(float x, float z, uint32_t begin, uint32_t end);
+private:
+	static constexpr uint32_t PADDING = 4;	// 4    ġ ڸ
+
+	float mRadius = 12.0f;
+	float mInvCellSize = 1.0f / 12.0f;
+	uint32_t mBucketMask = 0;
+
+	// Ŷ  ĵ SoA
+	vector<float> mSortedX;
+	vector<float> mSortedZ;
+	vector<uint32_t> mBucketStart;	// ũ = Ŷ  + 1
+	vector<uint32_t> mBucketOf;		// Ʈ Ŷ
+	vector<uint32_t> mCursor;
+};
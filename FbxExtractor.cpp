@@ -357,6 +357,11 @@ vector<int>& FbxExtractor::GetBoneHierarchyIndex()
 	return mBoneHierarchyIndex;
 }
 
+vector<string>& FbxExtractor::GetBoneHierarchyName()
+{
+	return mBoneHierarchyName;
+}
+
 vector<vector<pair<int,float>>>& FbxExtractor::GetControlPointsWeight()
 {
 	return mControlPointsWeight;
@@ -372,6 +377,25 @@ unordered_map<string, AnimationClip>& FbxExtractor::GetAnimation()
 	return mAnimations;
 }
 
+void FbxExtractor::Extract(const string& fileName, bool onlyAnimation, bool zUp, FbxData& data)
+{
+	ImportFbxFile(fileName, onlyAnimation, zUp);
+	ExtractDataFromFbx();
+
+	if (onlyAnimation == false) data.vertices = move(mVertices);
+	data.boneHierarchy = move(mBoneHierarchyIndex);
+	data.boneNames = move(mBoneHierarchyName);
+	data.offsetMatrix = move(mOffsetMatrix);
+	data.animations = move(mAnimations);
+
+	ResetAndClear();
+}
+
+const string& FbxExtractor::GetDirectory()
+{
+	return mDirectory;
+}
+
 void FbxExtractor::ResetAndClear()
 {
 	mFbxScene->Destroy();
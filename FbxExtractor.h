@@ -6,6 +6,7 @@
 #include <stdexcept>
 #include <DirectXMath.h>
 #include "SkinnedData.h"
+#include "CookedAsset.h"
 #include "Info.h"
 
 template<typename T> using ptr = T*;
@@ -20,12 +21,16 @@ public:
 	~FbxExtractor();
 	void ImportFbxFile(const string&, bool ,bool);
 	void ExtractDataFromFbx();
+	//     ϰ  data  ű. ִϸ̼Ǹ    .
+	void Extract(const string& fileName, bool onlyAnimation, bool zUp, FbxData& data);
 	vector<Vertex>& GetVertices();
 	//vector<pair<string, int>>& GetBoneHierarchy();
 	vector<int>& GetBoneHierarchyIndex();
+	vector<string>& GetBoneHierarchyName();
 	vector<vector<pair<int, float>>>& GetControlPointsWeight();
 	vector<XMFLOAT4X4>& GetOffsetMatrix();
 	unordered_map<string, AnimationClip>& GetAnimation();
+	const string& GetDirectory();
 	void ResetAndClear();
 
 private:
@@ -74,6 +79,6 @@ private:
 	bool mNormalize;
 	bool mOnlyAnimation;
 
-	string mDirectory = "./Fbxs/";
+	string mDirectory = FBX_DIRECTORY;
 };
 
@@ -0,0 +1,186 @@
+#include "FlowField.h"
+#include "Scene.h"
+#include "Object.h"
+
+//  4 ¿,  4 밢
+static const int sOffsetX[8] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+static const int sOffsetZ[8] = { 0, 0, 1, -1, 1, 1, -1, -1 };
+
+FlowField::FlowField(Scene* parent) :
+	mParent{ parent }
+{
+}
+
+void FlowField::Reset()
+{
+	mReady = false;
+	mGoalCell = -1;
+}
+
+void FlowField::Update(vector<Object*>& objects)
+{
+	if (!mReady)
+	{
+		//  ִ  . OBB  ù OnUpdate Ŀ ȿϴ.
+		if (!mParent->GetObj<TerrainObject>()) return;
+		BuildGrid(objects);
+	}
+
+	AIScheduler& scheduler = mParent->GetAIScheduler();
+	if (!scheduler.HasPlayer()) return;
+
+	XMFLOAT3 playerPos;
+	XMStoreFloat3(&playerPos, scheduler.GetPlayerPosition());
+	int cell = GetCellIndex(playerPos.x, playerPos.z);
+	if (cell < 0 || cell == mGoalCell) return;
+	Integrate(cell);
+}
+
+bool FlowField::GetDirection(XMVECTOR pos, XMVECTOR& dir)
+{
+	if (!mReady || mGoalCell < 0) return false;
+
+	int cell = GetCellIndex(XMVectorGetX(pos), XMVectorGetZ(pos));
+	if (cell < 0 || cell == mGoalCell) return false;
+
+	int8_t d = mDirection[cell];
+	if (d == NO_DIRECTION) return false;
+
+	dir = XMVector3Normalize(XMVectorSet((float)sOffsetX[d], 0.0f, (float)sOffsetZ[d], 0.0f));
+	return true;
+}
+
+bool FlowField::IsReady()
+{
+	return mReady;
+}
+
+void FlowField::BuildGrid(vector<Object*>& objects)
+{
+	TerrainData& terrain = mParent->GetResourceManager().GetTerrainData();
+	mWidth = terrain.terrainWidth - 1;
+	mHeight = terrain.terrainHeight - 1;
+	mCellSize = (float)terrain.terrainScale;
+
+	int cellCount = mWidth * mHeight;
+	mBlocked.assign(cellCount, 0);
+	mDistance.assign(cellCount, UNREACHABLE);
+	mDirection.assign(cellCount, NO_DIRECTION);
+	mOpen.resize(cellCount);
+
+	for (Object* obj : objects)
+	{
+		if (!obj->GetValid()) continue;
+		if (!IsStaticObstacle(obj)) continue;
+		Collider* collider = obj->GetComponent<Collider>();
+		if (!collider) continue;
+		RasterizeOBB(collider->GetOBB());
+	}
+
+	mGoalCell = -1;
+	mReady = true;
+}
+
+void FlowField::RasterizeOBB(const BoundingOrientedBox& obb)
+{
+	XMFLOAT3 corners[BoundingOrientedBox::CORNER_COUNT];
+	obb.GetCorners(corners);
+
+	float minX = corners[0].x, maxX = corners[0].x;
+	float minZ = corners[0].z, maxZ = corners[0].z;
+	for (XMFLOAT3& corner : corners)
+	{
+		minX = min(minX, corner.x);
+		maxX = max(maxX, corner.x);
+		minZ = min(minZ, corner.z);
+		maxZ = max(maxZ, corner.z);
+	}
+
+	int x0 = max(0, (int)floorf((minX - mAgentRadius) / mCellSize));
+	int x1 = min(mWidth - 1, (int)floorf((maxX + mAgentRadius) / mCellSize));
+	int z0 = max(0, (int)floorf((minZ - mAgentRadius) / mCellSize));
+	int z1 = min(mHeight - 1, (int)floorf((maxZ + mAgentRadius) / mCellSize));
+
+	// ĭ Ʈ ŭ Ǯ ڿ OBB  ġ  ĭ̴.
+	float half = mCellSize * 0.5f + mAgentRadius;
+	for (int z = z0; z <= z1; ++z)
+	{
+		for (int x = x0; x <= x1; ++x)
+		{
+			BoundingBox cellBox{ XMFLOAT3{ (x + 0.5f) * mCellSize, obb.Center.y, (z + 0.5f) * mCellSize }, XMFLOAT3{ half, half, half } };
+			if (obb.Intersects(cellBox)) mBlocked[z * mWidth + x] = 1;
+		}
+	}
+}
+
+void FlowField::Integrate(int goalCell)
+{
+	mGoalCell = goalCell;
+	std::fill(mDistance.begin(), mDistance.end(), UNREACHABLE);
+
+	// ǥ ĭ 4 BFS. ǥ ĭ  ־ δ .
+	int head = 0;
+	int tail = 0;
+	mDistance[goalCell] = 0;
+	mOpen[tail++] = goalCell;
+	while (head < tail)
+	{
+		int cell = mOpen[head++];
+		int x = cell % mWidth;
+		int z = cell / mWidth;
+		uint32_t next = mDistance[cell] + 1;
+		for (int i = 0; i < 4; ++i)
+		{
+			int nx = x + sOffsetX[i];
+			int nz = z + sOffsetZ[i];
+			if (nx < 0 || nz < 0 || nx >= mWidth || nz >= mHeight) continue;
+			int n = nz * mWidth + nx;
+			if (mBlocked[n] || mDistance[n] != UNREACHABLE) continue;
+			mDistance[n] = next;
+			mOpen[tail++] = n;
+		}
+	}
+
+	//  ĭ Ÿ   ̿ Ų.  ĭ   ´.
+	for (int z = 0; z < mHeight; ++z)
+	{
+		for (int x = 0; x < mWidth; ++x)
+		{
+			int cell = z * mWidth + x;
+			uint32_t bestDist = mDistance[cell];
+			int8_t best = NO_DIRECTION;
+			for (int i = 0; i < 8; ++i)
+			{
+				int nx = x + sOffsetX[i];
+				int nz = z + sOffsetZ[i];
+				if (nx < 0 || nz < 0 || nx >= mWidth || nz >= mHeight) continue;
+				int n = nz * mWidth + nx;
+				if (mBlocked[n]) continue;
+				// 밢 𼭸  ʵ 翷  շ  
+				if (i >= 4 && (mBlocked[z * mWidth + nx] || mBlocked[nz * mWidth + x])) continue;
+				if (mDistance[n] < bestDist)
+				{
+					bestDist = mDistance[n];
+					best = (int8_t)i;
+				}
+			}
+			mDirection[cell] = best;
+		}
+	}
+}
+
+int FlowField::GetCellIndex(float x, float z)
+{
+	if (x < 0.0f || z < 0.0f) return -1;
+	int cellX = (int)(x / mCellSize);
+	int cellZ = (int)(z / mCellSize);
+	if (cellX >= mWidth || cellZ >= mHeight) return -1;
+	return cellZ * mWidth + cellX;
+}
+
+bool FlowField::IsStaticObstacle(Object* obj)
+{
+	if (dynamic_cast<TreeObject*>(obj)) return true;
+	if (dynamic_cast<TestObject*>(obj)) return true;
+	return false;
+}
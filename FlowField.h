@@ -0,0 +1,47 @@
+#pragma once
+#include <DirectXCollision.h>
+#include "stdafx.h"
+
+class Scene;
+class Object;
+
+//    ÷̾ ϴ  帧.
+// ÷̾ ٸ ĭ Űܰ    BFS(O(ĭ )) ٽ ϰ,
+//  ȣ̴ ڱ ĭ ⸸ о .
+class FlowField
+{
+public:
+	FlowField(Scene* parent);
+	FlowField(const FlowField&) = delete;
+	FlowField& operator=(const FlowField&) = delete;
+	~FlowField() = default;
+
+	void Reset();
+	void Update(vector<Object*>& objects);
+	bool GetDirection(XMVECTOR pos, XMVECTOR& dir);
+	bool IsReady();
+private:
+	void BuildGrid(vector<Object*>& objects);
+	void RasterizeOBB(const BoundingOrientedBox& obb);
+	void Integrate(int goalCell);
+	int GetCellIndex(float x, float z);
+	bool IsStaticObstacle(Object* obj);
+private:
+	static constexpr uint32_t UNREACHABLE = 0xffffffff;
+	static constexpr int8_t NO_DIRECTION = -1;
+
+	Scene* mParent = nullptr;
+
+	int mWidth = 0;			// ĭ  (  - 1)
+	int mHeight = 0;
+	float mCellSize = 0.0f;
+	float mAgentRadius = 3.0f;	// ֹ ̸ŭ Ǯ ´
+
+	vector<uint8_t> mBlocked;
+	vector<uint32_t> mDistance;
+	vector<int8_t> mDirection;	// ̿ 8  ϳ ε
+	vector<int> mOpen;			// BFS ť. ũ ĭ  
+
+	int mGoalCell = -1;
+	bool mReady = false;
+};
@@ -1,5 +1,18 @@
 #pragma once
 #include "stdafx.h"
+#define MAX_BONE 90
+#define FNV_OFFSET_BASIS 14695981039346656037ull
+
+// FNV-1a. ̾ ؽϷ   hash  ѱ
+inline uint64_t HashFnv1a(const void* data, size_t size, uint64_t hash = FNV_OFFSET_BASIS)
+{
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
 
 struct Vertex
 {
@@ -10,12 +23,14 @@ struct Vertex
 	int boneIndex[4];
 };
 
+// Ű ȷƮ AnimationSystem  ȭ ۿ ְ ⿡ ġ д.
 struct ObjectCB
 {
     XMFLOAT4X4 world;
-	XMFLOAT4X4 finalTransform[90];
 	int isAnimate;
-	int padding0[3];
+	UINT paletteOffset;	// ȷƮ   ù  ġ (float4 )
+	int skinningMode;	// SkinningMode
+	int padding0;
 	float powValue;
 	float ambiantValue;
 	float padding1[2];
@@ -36,6 +51,8 @@ struct SubMeshData
 	UINT startVertexLocation;
 	UINT startIndexLocation;
 	UINT baseVertexLocation;
+	DXGI_FORMAT indexFormat;	// R16_UINT  Scene ε  16 Ʈ  
+	UINT skinVertexLocation;	// Ų Ʈ  ġ. -1 ̸ Ų 
 };
 
 enum CollisionState {
@@ -45,6 +62,28 @@ enum CollisionState {
 	EXIT           // 浹 
 };
 
+// ĳ ִϸ̼ . ¸  Ŭ GetAnimStates   ̸ ã д. (AnimationSet::BindStates)
+enum BoyAnim {
+	BOY_IDLE,      // 1P(boy-idle).fbx (̷)
+	BOY_WALK,
+	BOY_RUN,
+	BOY_PICKUP,
+	BOY_ATTACK,
+	BOY_HIT,
+	BOY_DYING,
+	BOY_THROW
+};
+
+enum TigerAnim {
+	TIGER_MESH,    // 0113_tiger.fbx (̷)
+	TIGER_IDLE,
+	TIGER_WALK,
+	TIGER_RUN,
+	TIGER_ATTACK,
+	TIGER_HIT,
+	TIGER_DYING
+};
+
 enum class ePass
 {
 	Shadow,
@@ -1,9 +1,30 @@
 ﻿#include "stdafx.h"
 #include "Framework.h"
+#include "AssetCooker.h"
+#include <thread>
+
+// -cook [-force] [-sdk] : 창을 띄우지 않고 에셋만 쿡하고 끝낸다. fbx 는 NativeFbxImporter 로 먼저 읽고, -sdk 면 모두 FBX SDK 로 읽는다.
+// -validate : Fbxs 폴더의 fbx 를 FBX SDK 와 NativeFbxImporter 로 모두 읽어서 비교하고, 다른 원본은 SDK 로 읽도록 기록한다.
+// -checknative : SDK 없이 NativeFbxImporter 로만 읽어서 검사하고, 검사에 걸린 원본은 SDK 로 읽도록 기록한다.
+// -animreport : Fbxs 폴더의 클립을 압축해 보고 키 메모리가 얼마나 주는지 적는다. 쿡된 파일은 바꾸지 않는다.
+static int RunCooker(const char* cmdLine)
+{
+    if (!AttachConsole(ATTACH_PARENT_PROCESS)) AllocConsole();
+    FILE* console = nullptr;
+    freopen_s(&console, "CONOUT$", "w", stdout);
+
+    AssetCooker cooker{ thread::hardware_concurrency(), strstr(cmdLine, "-sdk") != nullptr };
+    if (strstr(cmdLine, "-validate")) return cooker.Validate() ? 0 : 1;
+    if (strstr(cmdLine, "-checknative")) return cooker.CheckNative() ? 0 : 1;
+    if (strstr(cmdLine, "-animreport")) return cooker.ReportAnimation() ? 0 : 1;
+    return cooker.Run(strstr(cmdLine, "-force") != nullptr) ? 0 : 1;
+}
 
 _Use_decl_annotations_
-int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int nCmdShow)
+int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR lpCmdLine, int nCmdShow)
 {
+    if (strstr(lpCmdLine, "-cook") || strstr(lpCmdLine, "-validate") || strstr(lpCmdLine, "-checknative") || strstr(lpCmdLine, "-animreport")) return RunCooker(lpCmdLine);
+
     Framework framework;
     framework.OnInit(hInstance, 1280, 720);
     ShowWindow(framework.GetHWnd(), nCmdShow);
@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <cmath>
+#include "MeshOptimizer.h"
+
+static_assert(sizeof(Vertex) == 64, "Vertex  е  Ʈ 񱳷 ĥ  ");
+
+namespace
+{
+	uint64_t HashVertex(const Vertex& vertex)
+	{
+		//  е  4 Ʈ  Ƿ Ʈ  ؽص ȴ
+		return HashFnv1a(&vertex, sizeof(Vertex));
+	}
+
+	//  ó ĳø FIFO  䳻 .  ð ֱ size  ̸ ĳÿ ִ
+	class FifoCache
+	{
+	public:
+		FifoCache(size_t vertexCount, UINT size) : mStamps(vertexCount, 0), mSize{ size }, mTime{ size } {}
+
+		// ̽ 1
+		UINT Access(uint32_t vertex)
+		{
+			if (mTime - mStamps[vertex] < mSize) return 0;
+			mStamps[vertex] = ++mTime;
+			return 1;
+		}
+		UINT AccessTriangle(const uint32_t* triangle)
+		{
+			return Access(triangle[0]) + Access(triangle[1]) + Access(triangle[2]);
+		}
+		void Reset()
+		{
+			mTime += mSize;
+		}
+	private:
+		vector<uint64_t> mStamps;
+		uint64_t mSize;
+		uint64_t mTime;
+	};
+}
+
+MeshOptimizer::Report MeshOptimizer::Optimize(vector<Vertex>& vertices, vector<uint32_t>& indices)
+{
+	Report report;
+	report.rawVertexCount = WeldVertices(vertices, indices);
+	if (indices.empty()) return report;
+
+	report.before = AnalyzeVertexCache(indices, vertices.size());
+	OptimizeVertexCache(indices, vertices.size());
+	OptimizeOverdraw(indices, vertices);
+	OptimizeVertexFetch(vertices, indices);
+	report.after = AnalyzeVertexCache(indices, vertices.size());
+	return report;
+}
+
+size_t MeshOptimizer::WeldVertices(vector<Vertex>& vertices, vector<uint32_t>& indices)
+{
+	size_t vertexCount = vertices.size();
+	indices.resize(vertexCount);
+	if (vertexCount == 0) return 0;
+
+	//  ּ ؽ ǥ. ĭ ģ  ȣ + 1  ΰ 0   ĭ̴
+	size_t tableSize = 1;
+	while (tableSize < vertexCount * 2) tableSize <<= 1;
+	vector<uint32_t> table(tableSize, 0);
+
+	vector<Vertex> welded;
+	welded.reserve(vertexCount);
+	for (size_t i = 0; i < vertexCount; ++i) {
+		const Vertex& vertex = vertices[i];
+		size_t slot = HashVertex(vertex) & (tableSize - 1);
+		while (table[slot] != 0 && memcmp(&welded[table[slot] - 1], &vertex, sizeof(Vertex)) != 0) {
+			slot = (slot + 1) & (tableSize - 1);
+		}
+		if (table[slot] == 0) {
+			welded.push_back(vertex);
+			table[slot] = (uint32_t)welded.size();
+		}
+		indices[i] = table[slot] - 1;
+	}
+
+	welded.shrink_to_fit();
+	vertices = move(welded);
+	return vertexCount;
+}
+
+void MeshOptimizer::OptimizeVertexCache(vector<uint32_t>& indices, size_t vertexCount, UINT cacheSize)
+{
+	size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0) return;
+
+	//     ﰢ ϰ    ﰢ 
+	vector<uint32_t> liveCount(vertexCount, 0);
+	for (uint32_t index : indices) ++liveCount[index];
+	vector<uint32_t> offsets(vertexCount + 1, 0);
+	for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] = offsets[v] + liveCount[v];
+	vector<uint32_t> adjacency(indices.size());
+	{
+		vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < triangleCount * 3; ++i) adjacency[cursor[indices[i]]++] = (uint32_t)(i / 3);
+	}
+
+	vector<uint64_t> cacheTime(vertexCount, 0);
+	uint64_t time = cacheSize + 1;
+	vector<bool> emitted(triangleCount, false);
+	vector<uint32_t> deadEnd;
+	vector<uint32_t> candidates;
+	vector<uint32_t> result;
+	result.reserve(triangleCount * 3);
+	size_t cursor = 0;
+
+	//  ִ ﰢ  . ٸ ̸ ֱٿ  ,  ȣ  ã´
+	auto SkipDeadEnd = [&]() -> int64_t {
+		while (!deadEnd.empty()) {
+			uint32_t vertex = deadEnd.back();
+			deadEnd.pop_back();
+			if (liveCount[vertex] > 0) return vertex;
+		}
+		for (; cursor < vertexCount; ++cursor) {
+			if (liveCount[cursor] > 0) return (int64_t)cursor;
+		}
+		return -1;
+	};
+
+	int64_t fanning = SkipDeadEnd();
+	while (fanning >= 0) {
+		candidates.clear();
+		for (uint32_t a = offsets[fanning]; a < offsets[fanning + 1]; ++a) {
+			uint32_t triangle = adjacency[a];
+			if (emitted[triangle]) continue;
+			emitted[triangle] = true;
+			for (int k = 0; k < 3; ++k) {
+				uint32_t vertex = indices[triangle * 3 + k];
+				result.push_back(vertex);
+				deadEnd.push_back(vertex);
+				candidates.push_back(vertex);
+				--liveCount[vertex];
+				if (time - cacheTime[vertex] > cacheSize) cacheTime[vertex] = time++;
+			}
+		}
+
+		// ä  Ƶ ĳÿ       
+		int64_t next = -1;
+		int64_t bestPriority = -1;
+		for (uint32_t vertex : candidates) {
+			if (liveCount[vertex] == 0) continue;
+			int64_t priority = 0;
+			if (time - cacheTime[vertex] + 2 * liveCount[vertex] <= cacheSize) priority = (int64_t)(time - cacheTime[vertex]);
+			if (priority > bestPriority) {
+				bestPriority = priority;
+				next = vertex;
+			}
+		}
+		fanning = next >= 0 ? next : SkipDeadEnd();
+	}
+
+	indices = move(result);
+}
+
+void MeshOptimizer::OptimizeOverdraw(vector<uint32_t>& indices, const vector<Vertex>& vertices, float threshold, UINT cacheSize)
+{
+	size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0) return;
+
+	//    ̽ ﰢ ĳð  ϴ ̶ ڸ⸸ ص ذ 
+	vector<size_t> hardClusters;
+	FifoCache cache{ vertices.size(), cacheSize };
+	for (size_t t = 0; t < triangleCount; ++t) {
+		if (cache.AccessTriangle(&indices[t * 3]) == 3 || t == 0) hardClusters.push_back(t);
+	}
+	hardClusters.push_back(triangleCount);
+
+	//  ȿ ݱ ACMR   ü threshold  ̸    ڸ
+	vector<size_t> clusters;
+	for (size_t c = 0; c + 1 < hardClusters.size(); ++c) {
+		size_t start = hardClusters[c];
+		size_t end = hardClusters[c + 1];
+
+		cache.Reset();
+		UINT clusterMisses = 0;
+		for (size_t t = start; t < end; ++t) clusterMisses += cache.AccessTriangle(&indices[t * 3]);
+		float limit = threshold * clusterMisses / float(end - start);
+
+		cache.Reset();
+		clusters.push_back(start);
+		size_t softStart = start;
+		UINT misses = 0;
+		for (size_t t = start; t + 1 < end; ++t) {
+			misses += cache.AccessTriangle(&indices[t * 3]);
+			if (misses / float(t + 1 - softStart) <= limit) {
+				clusters.push_back(t + 1);
+				softStart = t + 1;
+				misses = 0;
+				cache.Reset();
+			}
+		}
+	}
+	clusters.push_back(triangleCount);
+
+	//    ߽ɰ . ޽ ߽ɿ ٱ  ϼ  ׸
+	XMVECTOR meshCenter = XMVectorZero();
+	for (const Vertex& vertex : vertices) meshCenter += XMLoadFloat3(&vertex.position);
+	meshCenter /= (float)max(vertices.size(), size_t(1));
+
+	struct Cluster
+	{
+		size_t start;
+		size_t end;
+		float key;
+	};
+	vector<Cluster> sorted;
+	for (size_t c = 0; c + 1 < clusters.size(); ++c) {
+		XMVECTOR center = XMVectorZero();
+		XMVECTOR normal = XMVectorZero();
+		float totalArea = 0.0f;
+		for (size_t t = clusters[c]; t < clusters[c + 1]; ++t) {
+			XMVECTOR p0 = XMLoadFloat3(&vertices[indices[t * 3 + 0]].position);
+			XMVECTOR p1 = XMLoadFloat3(&vertices[indices[t * 3 + 1]].position);
+			XMVECTOR p2 = XMLoadFloat3(&vertices[indices[t * 3 + 2]].position);
+			XMVECTOR cross = XMVector3Cross(p1 - p0, p2 - p0);
+			float area = XMVectorGetX(XMVector3Length(cross));
+			center += (p0 + p1 + p2) * (area / 3.0f);
+			normal += cross;
+			totalArea += area;
+		}
+		if (totalArea > 0.0f) center /= totalArea;
+		float key = XMVectorGetX(XMVector3Dot(center - meshCenter, XMVector3Normalize(normal)));
+		sorted.push_back(Cluster{ clusters[c], clusters[c + 1], isfinite(key) ? key : 0.0f });
+	}
+	stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b) { return a.key > b.key; });
+
+	vector<uint32_t> result;
+	result.reserve(indices.size());
+	for (const Cluster& cluster : sorted) {
+		result.insert(result.end(), indices.begin() + cluster.start * 3, indices.begin() + cluster.end * 3);
+	}
+	indices = move(result);
+}
+
+void MeshOptimizer::OptimizeVertexFetch(vector<Vertex>& vertices, vector<uint32_t>& indices)
+{
+	const uint32_t unused = ~0u;
+	vector<uint32_t> remap(vertices.size(), unused);
+	vector<Vertex> reordered;
+	reordered.reserve(vertices.size());
+	for (uint32_t& index : indices) {
+		if (remap[index] == unused) {
+			remap[index] = (uint32_t)reordered.size();
+			reordered.push_back(vertices[index]);
+		}
+		index = remap[index];
+	}
+	//  ﰢ  ʴ  
+	vertices = move(reordered);
+}
+
+MeshOptimizer::CacheStats MeshOptimizer::AnalyzeVertexCache(const vector<uint32_t>& indices, size_t vertexCount, UINT cacheSize)
+{
+	CacheStats stats;
+	if (indices.empty() || vertexCount == 0) return stats;
+
+	FifoCache cache{ vertexCount, cacheSize };
+	UINT misses = 0;
+	for (uint32_t index : indices) misses += cache.Access(index);
+	stats.acmr = misses / float(indices.size() / 3);
+	stats.atvr = misses / float(vertexCount);
+	return stats;
+}
+
+bool MeshOptimizer::FitsIndex16(size_t vertexCount)
+{
+	return vertexCount <= 0x10000;
+}
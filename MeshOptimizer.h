@@ -0,0 +1,42 @@
+#pragma once
+#include "stdafx.h"
+#include "Info.h"
+#define VERTEX_CACHE_SIZE 16	//  ĳ 䳻  FIFO ũ
+#define OVERDRAW_THRESHOLD 1.05f	//    ڸ  ϴ ACMR  
+
+//   ޽ø ׸  ٵ´. FbxExtractor  NativeFbxImporter   Ȱ .
+namespace MeshOptimizer
+{
+	//  ĳ ȿ. ACMR  ﰢ, ATVR   ĳ ̽ .     ATVR  ּڰ 1
+	struct CacheStats
+	{
+		float acmr = 0.0f;
+		float atvr = 0.0f;
+	};
+
+	// Optimize   .  α׿ 
+	struct Report
+	{
+		size_t rawVertexCount = 0;	// ġ  (  )
+		CacheStats before;			// ģ ,  ﰢ 
+		CacheStats after;
+	};
+
+	// WeldVertices, OptimizeVertexCache, OptimizeOverdraw, OptimizeVertexFetch  ʷ Ѵ.
+	Report Optimize(vector<Vertex>& vertices, vector<uint32_t>& indices);
+
+	//   ϳ ִ  Ʈ   ϳ ġ ﰢ ε .
+	//   ó   . ִ  ġ   
+	size_t WeldVertices(vector<Vertex>& vertices, vector<uint32_t>& indices);
+	// Tipsify. ĳÿ   ѷ ﰢ ä÷ ̾  ﰢ  ٲ۴.
+	void OptimizeVertexCache(vector<uint32_t>& indices, size_t vertexCount, UINT cacheSize = VERTEX_CACHE_SIZE);
+	// ĳ  ũ ġ ʴ  ﰢ  ڸ, ٱ    ׷ Ѵ.
+	// OptimizeVertexCache  .
+	void OptimizeOverdraw(vector<uint32_t>& indices, const vector<Vertex>& vertices, float threshold = OVERDRAW_THRESHOLD, UINT cacheSize = VERTEX_CACHE_SIZE);
+	// ε ó Ű   ٽ Ƽ  ۸ տ а Ѵ.
+	void OptimizeVertexFetch(vector<Vertex>& vertices, vector<uint32_t>& indices);
+	CacheStats AnalyzeVertexCache(const vector<uint32_t>& indices, size_t vertexCount, UINT cacheSize = VERTEX_CACHE_SIZE);
+
+	// 16 Ʈ ε  ų   true
+	bool FitsIndex16(size_t vertexCount);
+}
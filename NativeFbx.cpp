@@ -0,0 +1,406 @@
+#include "NativeFbx.h"
+
+namespace
+{
+	const char sMagic[] = "Kaydara FBX Binary  ";	// ڿ 0x00 0x1A 0x00
+	const size_t sHeaderSize = 27;
+
+	template<typename T>
+	T ReadValue(const uint8_t* data)
+	{
+		T value;
+		memcpy(&value, data, sizeof(T));
+		return value;
+	}
+
+	// deflate Ʈ б.  Ʈ д´.
+	class BitReader
+	{
+	public:
+		BitReader(const uint8_t* data, size_t size) : mData{ data }, mSize{ size } {}
+
+		bool Bits(int count, uint32_t& value)
+		{
+			while (mBitCount < count) {
+				if (mOffset >= mSize) return false;
+				mBitBuffer |= uint32_t(mData[mOffset++]) << mBitCount;
+				mBitCount += 8;
+			}
+			value = mBitBuffer & ((1u << count) - 1);
+			mBitBuffer >>= count;
+			mBitCount -= count;
+			return true;
+		}
+		void AlignToByte()
+		{
+			mBitBuffer = 0;
+			mBitCount = 0;
+		}
+		bool Bytes(uint8_t* dst, size_t count)
+		{
+			if (mOffset + count > mSize) return false;
+			memcpy(dst, mData + mOffset, count);
+			mOffset += count;
+			return true;
+		}
+	private:
+		const uint8_t* mData;
+		size_t mSize;
+		size_t mOffset = 0;
+		uint32_t mBitBuffer = 0;
+		int mBitCount = 0;
+	};
+
+	// (canonical)  ǥ. ̺ ڵ    ĵ ɺ.
+	struct Huffman
+	{
+		uint16_t counts[16];
+		uint16_t symbols[288];
+
+		bool Build(const uint8_t* lengths, int count)
+		{
+			memset(counts, 0, sizeof(counts));
+			for (int i = 0; i < count; ++i) ++counts[lengths[i]];
+			if (counts[0] == count) return true;	// ڵ尡  ǥ (Ÿ ڵ尡 ϳ  )
+
+			int left = 1;
+			for (int length = 1; length < 16; ++length) {
+				left <<= 1;
+				left -= counts[length];
+				if (left < 0) return false;	// ڵ尡 ģ
+			}
+
+			uint16_t offsets[16];
+			offsets[1] = 0;
+			for (int length = 1; length < 15; ++length) offsets[length + 1] = offsets[length] + counts[length];
+			for (int i = 0; i < count; ++i) {
+				if (lengths[i] != 0) symbols[offsets[lengths[i]]++] = uint16_t(i);
+			}
+			return true;
+		}
+
+		bool Decode(BitReader& bits, int& symbol)const
+		{
+			int code = 0;
+			int first = 0;
+			int index = 0;
+			for (int length = 1; length < 16; ++length) {
+				uint32_t bit;
+				if (!bits.Bits(1, bit)) return false;
+				code |= int(bit);
+				int count = counts[length];
+				if (code - count < first) {
+					symbol = symbols[index + (code - first)];
+					return true;
+				}
+				index += count;
+				first += count;
+				first <<= 1;
+				code <<= 1;
+			}
+			return false;
+		}
+	};
+
+	const uint16_t sLengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const uint8_t sLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	const uint16_t sDistanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	const uint8_t sDistanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+	bool InflateCodes(BitReader& bits, const Huffman& lengthCodes, const Huffman& distanceCodes, uint8_t* dst, size_t dstSize, size_t& out)
+	{
+		while (true) {
+			int symbol;
+			if (!lengthCodes.Decode(bits, symbol)) return false;
+			if (symbol < 256) {
+				if (out >= dstSize) return false;
+				dst[out++] = uint8_t(symbol);
+				continue;
+			}
+			if (symbol == 256) return true;
+
+			symbol -= 257;
+			if (symbol >= 29) return false;
+			uint32_t extra;
+			if (!bits.Bits(sLengthExtra[symbol], extra)) return false;
+			size_t length = sLengthBase[symbol] + extra;
+
+			if (!distanceCodes.Decode(bits, symbol) || symbol >= 30) return false;
+			if (!bits.Bits(sDistanceExtra[symbol], extra)) return false;
+			size_t distance = sDistanceBase[symbol] + extra;
+			if (distance > out || out + length > dstSize) return false;
+
+			// ĥ  Ƿ  Ʈ Ѵ.
+			for (size_t i = 0; i < length; ++i, ++out) dst[out] = dst[out - distance];
+		}
+	}
+
+	bool InflateDynamic(BitReader& bits, Huffman& lengthCodes, Huffman& distanceCodes)
+	{
+		uint32_t literalCount, distanceCount, codeCount;
+		if (!bits.Bits(5, literalCount) || !bits.Bits(5, distanceCount) || !bits.Bits(4, codeCount)) return false;
+		literalCount += 257;
+		distanceCount += 1;
+		codeCount += 4;
+		if (literalCount > 286 || distanceCount > 30) return false;
+
+		static const uint8_t order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+		uint8_t lengths[288 + 32]{};
+		for (uint32_t i = 0; i < codeCount; ++i) {
+			uint32_t length;
+			if (!bits.Bits(3, length)) return false;
+			lengths[order[i]] = uint8_t(length);
+		}
+		Huffman codeLengthCodes;
+		if (!codeLengthCodes.Build(lengths, 19)) return false;
+
+		uint32_t index = 0;
+		memset(lengths, 0, sizeof(lengths));
+		while (index < literalCount + distanceCount) {
+			int symbol;
+			if (!codeLengthCodes.Decode(bits, symbol)) return false;
+			if (symbol < 16) {
+				lengths[index++] = uint8_t(symbol);
+				continue;
+			}
+			uint8_t length = 0;
+			uint32_t repeat;
+			if (symbol == 16) {
+				if (index == 0) return false;
+				length = lengths[index - 1];
+				if (!bits.Bits(2, repeat)) return false;
+				repeat += 3;
+			}
+			else if (symbol == 17) {
+				if (!bits.Bits(3, repeat)) return false;
+				repeat += 3;
+			}
+			else {
+				if (!bits.Bits(7, repeat)) return false;
+				repeat += 11;
+			}
+			if (index + repeat > literalCount + distanceCount) return false;
+			while (repeat--) lengths[index++] = length;
+		}
+		if (lengths[256] == 0) return false;	//   ڵ尡 
+
+		return lengthCodes.Build(lengths, literalCount) && distanceCodes.Build(lengths + literalCount, distanceCount);
+	}
+}
+
+bool NativeFbx::Property::IsArray()const
+{
+	return type == 'f' || type == 'd' || type == 'l' || type == 'i' || type == 'b';
+}
+
+int64_t NativeFbx::Property::AsInt()const
+{
+	switch (type) {
+	case 'Y': return ReadValue<int16_t>(data);
+	case 'C': return *data != 0;
+	case 'I': return ReadValue<int32_t>(data);
+	case 'L': return ReadValue<int64_t>(data);
+	case 'F': return int64_t(ReadValue<float>(data));
+	case 'D': return int64_t(ReadValue<double>(data));
+	default: return 0;
+	}
+}
+
+double NativeFbx::Property::AsDouble()const
+{
+	switch (type) {
+	case 'F': return ReadValue<float>(data);
+	case 'D': return ReadValue<double>(data);
+	default: return double(AsInt());
+	}
+}
+
+string NativeFbx::Property::AsString()const
+{
+	if (type != 'S' && type != 'R') return string{};
+	return string{ reinterpret_cast<const char*>(data), length };
+}
+
+const NativeFbx::Node* NativeFbx::Node::Find(const char* childName)const
+{
+	for (const Node& child : children) {
+		if (child.name == childName) return &child;
+	}
+	return nullptr;
+}
+
+bool NativeFbx::Reader::Parse(const uint8_t* data, size_t size)
+{
+	mData = data;
+	mSize = size;
+	mRoot = Node{};
+	mError.clear();
+
+	if (size < sHeaderSize || memcmp(data, sMagic, sizeof(sMagic) - 1) != 0) return Fail("̳ʸ FBX  ƴ");
+	mVersion = ReadValue<uint32_t>(data + 23);
+	if (mVersion < 7000 || mVersion >= 8000) return Fail("FBX 7.x  ƴ (" + to_string(mVersion) + ")");
+
+	size_t offset = sHeaderSize;
+	while (true) {
+		Node node;
+		bool isNull = false;
+		if (!ReadNode(offset, node, isNull)) return false;
+		if (isNull) break;
+		mRoot.children.push_back(move(node));
+	}
+	return true;
+}
+
+uint32_t NativeFbx::Reader::GetVersion()const
+{
+	return mVersion;
+}
+
+const NativeFbx::Node& NativeFbx::Reader::GetRoot()const
+{
+	return mRoot;
+}
+
+const string& NativeFbx::Reader::GetError()const
+{
+	return mError;
+}
+
+bool NativeFbx::Reader::ReadNode(size_t& offset, Node& node, bool& isNull)
+{
+	// 7.5   Ӹ ũ ʵ尡 64 Ʈ.
+	bool wide = mVersion >= 7500;
+	size_t headerSize = wide ? 25 : 13;
+	if (offset + headerSize > mSize) return Fail(" Ӹ ߸");
+
+	uint64_t endOffset, propertyCount;
+	if (wide) {
+		endOffset = ReadValue<uint64_t>(mData + offset);
+		propertyCount = ReadValue<uint64_t>(mData + offset + 8);
+	}
+	else {
+		endOffset = ReadValue<uint32_t>(mData + offset);
+		propertyCount = ReadValue<uint32_t>(mData + offset + 4);
+	}
+	uint8_t nameLength = mData[offset + headerSize - 1];
+	offset += headerSize;
+
+	//  ˸  
+	isNull = endOffset == 0;
+	if (isNull) return true;
+	if (endOffset > mSize || endOffset < offset + nameLength) return Fail("  ġ ߸");
+
+	node.name.assign(reinterpret_cast<const char*>(mData + offset), nameLength);
+	offset += nameLength;
+
+	// Ӽ   ڵ 1 Ʈ̴.   ū  ޸𸮸  ʰ  ũ ´
+	if (propertyCount > endOffset - offset) return Fail("Ӽ   ũ⺸ ŭ");
+	node.properties.resize(size_t(propertyCount));
+	for (Property& property : node.properties) {
+		if (!ReadProperty(offset, property)) return false;
+	}
+
+	while (offset < endOffset) {
+		Node child;
+		bool childIsNull = false;
+		if (!ReadNode(offset, child, childIsNull)) return false;
+		if (childIsNull) break;
+		node.children.push_back(move(child));
+	}
+	if (offset > endOffset) return Fail("尡  ġ  : " + node.name);
+	offset = size_t(endOffset);
+	return true;
+}
+
+bool NativeFbx::Reader::ReadProperty(size_t& offset, Property& property)
+{
+	if (offset >= mSize) return Fail("Ӽ ߸");
+	property.type = char(mData[offset++]);
+
+	size_t valueSize = 0;
+	switch (property.type) {
+	case 'Y': valueSize = 2; break;
+	case 'C': valueSize = 1; break;
+	case 'I': case 'F': valueSize = 4; break;
+	case 'D': case 'L': valueSize = 8; break;
+	case 'S': case 'R':
+		if (offset + 4 > mSize) return Fail("ڿ ̰ ߸");
+		property.length = ReadValue<uint32_t>(mData + offset);
+		offset += 4;
+		valueSize = property.length;
+		break;
+	case 'f': case 'd': case 'l': case 'i': case 'b':
+		if (offset + 12 > mSize) return Fail("迭 Ӹ ߸");
+		property.length = ReadValue<uint32_t>(mData + offset);
+		property.encoding = ReadValue<uint32_t>(mData + offset + 4);
+		property.compressedLength = ReadValue<uint32_t>(mData + offset + 8);
+		offset += 12;
+		valueSize = property.compressedLength;
+		break;
+	default:
+		return Fail(string{ "   Ӽ  : " } + property.type);
+	}
+
+	if (offset + valueSize > mSize) return Fail("Ӽ  ߸");
+	property.data = mData + offset;
+	offset += valueSize;
+	return true;
+}
+
+bool NativeFbx::Reader::Fail(const string& error)
+{
+	mError = error;
+	return false;
+}
+
+bool NativeFbx::Inflate(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+	// zlib Ӹ : deflate ̰, ̸    ʾƾ Ѵ.
+	if (srcSize < 2) return false;
+	if ((src[0] & 0x0F) != 8 || ((src[0] << 8) | src[1]) % 31 != 0 || (src[1] & 0x20)) return false;
+
+	BitReader bits{ src + 2, srcSize - 2 };
+	size_t out = 0;
+	uint32_t last = 0;
+	while (!last) {
+		uint32_t type;
+		if (!bits.Bits(1, last) || !bits.Bits(2, type)) return false;
+
+		if (type == 0) {
+			bits.AlignToByte();
+			uint8_t header[4];
+			if (!bits.Bytes(header, 4)) return false;
+			uint16_t length = uint16_t(header[0] | (header[1] << 8));
+			uint16_t inverse = uint16_t(header[2] | (header[3] << 8));
+			if (length != uint16_t(~inverse) || out + length > dstSize) return false;
+			if (!bits.Bytes(dst + out, length)) return false;
+			out += length;
+		}
+		else if (type == 1) {
+			static Huffman fixedLengthCodes, fixedDistanceCodes;
+			static bool fixedBuilt = [] {
+				uint8_t lengths[288];
+				int i = 0;
+				for (; i < 144; ++i) lengths[i] = 8;
+				for (; i < 256; ++i) lengths[i] = 9;
+				for (; i < 280; ++i) lengths[i] = 7;
+				for (; i < 288; ++i) lengths[i] = 8;
+				fixedLengthCodes.Build(lengths, 288);
+				for (i = 0; i < 30; ++i) lengths[i] = 5;
+				fixedDistanceCodes.Build(lengths, 30);
+				return true;
+			}();
+			(void)fixedBuilt;
+			if (!InflateCodes(bits, fixedLengthCodes, fixedDistanceCodes, dst, dstSize, out)) return false;
+		}
+		else if (type == 2) {
+			Huffman lengthCodes, distanceCodes;
+			if (!InflateDynamic(bits, lengthCodes, distanceCodes)) return false;
+			if (!InflateCodes(bits, lengthCodes, distanceCodes, dst, dstSize, out)) return false;
+		}
+		else {
+			return false;
+		}
+	}
+	return out == dstSize;
+}
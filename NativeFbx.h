@@ -0,0 +1,106 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// FBX SDK  ̳ʸ FBX 7.x  д´.
+//  ü ޸( MappedFile)  ä  Ʈ , Ӽ  ʿ   ڸ д´.
+//  迭(zlib) Inflate  Ǭ.
+namespace NativeFbx
+{
+	//  迭 Ǯ   ޸ ѵ. Ӹ  Ϸ ū ޸𸮸  ʰ Ѵ.
+	constexpr size_t MAX_ARRAY_BYTES = size_t(1) << 28;
+
+	struct Property
+	{
+		char type = 0;		// Y C I F D L : , S R : ڿ/Ʈ, f d l i b : 迭
+		const uint8_t* data = nullptr;	// ̳ ڿ ٷ  ڸ, 迭 () ҵ
+		uint32_t length = 0;	// ڿ Ʈ , 迭  
+		uint32_t encoding = 0;	// 迭. 1 ̸ zlib
+		uint32_t compressedLength = 0;
+
+		bool IsArray()const;
+		int64_t AsInt()const;
+		double AsDouble()const;
+		string AsString()const;
+		//   ޶ T  ٲ㼭 д´.  Ǯ  false
+		template<typename T> bool GetArray(vector<T>& out)const;
+	};
+
+	struct Node
+	{
+		string name;
+		vector<Property> properties;
+		vector<Node> children;
+
+		const Node* Find(const char* childName)const;	//  nullptr
+	};
+
+	class Reader
+	{
+	public:
+		// data  Reader  ű⼭  Property     ־ Ѵ.
+		bool Parse(const uint8_t* data, size_t size);
+		uint32_t GetVersion()const;
+		const Node& GetRoot()const;		// ֻ  children  ִ
+		const string& GetError()const;
+	private:
+		bool ReadNode(size_t& offset, Node& node, bool& isNull);
+		bool ReadProperty(size_t& offset, Property& property);
+		bool Fail(const string& error);
+	private:
+		const uint8_t* mData = nullptr;
+		size_t mSize = 0;
+		uint32_t mVersion = 0;
+		Node mRoot;
+		string mError;
+	};
+
+	// zlib Ʈ ϳ dst  Ȯ dstSize Ʈ Ǭ.
+	bool Inflate(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+
+	template<typename T>
+	bool Property::GetArray(vector<T>& out)const
+	{
+		size_t elementSize = 0;
+		switch (type) {
+		case 'f': case 'i': elementSize = 4; break;
+		case 'd': case 'l': elementSize = 8; break;
+		case 'b': elementSize = 1; break;
+		default: return false;
+		}
+
+		//  Ʈ  Ӹ length  Ƿ   Ʈ (compressedLength)  
+		size_t byteSize = elementSize * length;
+		vector<uint8_t> inflated;
+		const uint8_t* elements = data;
+		if (encoding == 0) {
+			if (compressedLength < byteSize) return false;
+		}
+		else if (encoding == 1) {
+			if (byteSize > MAX_ARRAY_BYTES) return false;
+			inflated.resize(byteSize);
+			if (!Inflate(data, compressedLength, inflated.data(), inflated.size())) return false;
+			elements = inflated.data();
+		}
+		else {
+			return false;
+		}
+
+		out.resize(length);
+		for (uint32_t i = 0; i < length; ++i) {
+			const uint8_t* element = elements + elementSize * i;
+			switch (type) {
+			case 'f': { float v; memcpy(&v, element, 4); out[i] = (T)v; break; }
+			case 'd': { double v; memcpy(&v, element, 8); out[i] = (T)v; break; }
+			case 'i': { int32_t v; memcpy(&v, element, 4); out[i] = (T)v; break; }
+			case 'l': { int64_t v; memcpy(&v, element, 8); out[i] = (T)v; break; }
+			case 'b': out[i] = (T)(*element != 0); break;
+			}
+		}
+		return true;
+	}
+}
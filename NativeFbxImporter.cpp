@@ -0,0 +1,841 @@
+#include "NativeFbxImporter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const int64_t sTicksPerSecond = 46186158000;	// FbxTime 
+	const double sDegreeToRadian = 3.14159265358979323846 / 180.0;
+	const string sNameSeparator{ "\x00\x01", 2 };
+
+	// FbxTime::EMode . 0 ̸    
+	const double sFrameRates[] = { 30.0, 120.0, 100.0, 60.0, 50.0, 48.0, 30.0, 0.0, 0.0, 0.0, 25.0, 24.0, 1000.0, 0.0, 0.0, 96.0, 72.0, 0.0 };
+}
+
+bool NativeFbxImporter::Import(const string& path, bool onlyAnimation, bool zUp, FbxData& data)
+{
+	//  ʹ  д ȸ ȿϴ.   
+	mError.clear();
+	mZUp = zUp;
+	Clear();
+	bool result = Read(path, onlyAnimation, data);
+	Clear();
+	return result;
+}
+
+const string& NativeFbxImporter::GetError()
+{
+	return mError;
+}
+
+bool NativeFbxImporter::Check(const FbxData& data, string& report)
+{
+	string error;
+	auto finite = [](const float* values, int count) {
+		for (int i = 0; i < count; ++i) if (isfinite(values[i]) == false) return false;
+		return true;
+	};
+
+	size_t boneCount = data.boneNames.size();
+	if (data.boneHierarchy.size() != boneCount) error += "      ٸ";
+	for (size_t i = 0; i < data.boneHierarchy.size(); ++i) {
+		// θ  ;  տ   ִ
+		if (data.boneHierarchy[i] >= (int)i) { error += " θ ڽĺ ڿ "; break; }
+	}
+
+	float weightError = 0.0f;
+	for (const Vertex& vertex : data.vertices) {
+		if (finite(&vertex.position.x, 3) == false || finite(&vertex.normal.x, 3) == false || finite(&vertex.uv.x, 2) == false) { error += "   "; break; }
+		if (boneCount == 0) continue;
+		const float* weight = &vertex.weight.x;
+		float sum = 0.0f;
+		for (int i = 0; i < 4; ++i) {
+			sum += weight[i];
+			if (weight[i] > 0.0f && (vertex.boneIndex[i] < 0 || (size_t)vertex.boneIndex[i] >= boneCount)) { error += "  ȣ  "; break; }
+		}
+		weightError = max(weightError, fabsf(sum - 1.0f));
+	}
+	if (weightError > 1e-4f) error += " ġ  1  ƴ";
+	if (data.indices.size() % 3 != 0) error += " ε ﰢ  ƴ";
+	for (uint32_t index : data.indices) {
+		if (index >= data.vertices.size()) { error += " ε  "; break; }
+	}
+
+	size_t keyCount = 0;
+	for (auto& [name, clip] : data.animations) {
+		if (clip.BoneAnimations.size() != boneCount) { error += " " + name + "    ٸ"; continue; }
+		for (const BoneAnimation& bone : clip.BoneAnimations) {
+			keyCount += bone.Keyframes.size();
+			if (bone.Keyframes.size() != clip.BoneAnimations[0].Keyframes.size()) { error += " " + name + "  Ű   ٸ"; break; }
+			bool valid = true;
+			for (const Keyframe& key : bone.Keyframes) {
+				valid = valid && isfinite(key.TimePos) && finite(&key.Translation.x, 3) && finite(&key.Scale.x, 3) && finite(&key.RotationQuat.x, 4);
+			}
+			if (valid == false) { error += " " + name + "    Ű"; break; }
+		}
+	}
+
+	char buffer[192];
+	sprintf_s(buffer, "vertices %zu, indices %zu, bones %zu, clips %zu, keys %zu, weight error %.1e",
+		data.vertices.size(), data.indices.size(), boneCount, data.animations.size(), keyCount, weightError);
+	report = buffer + error;
+	return error.empty();
+}
+
+bool NativeFbxImporter::Read(const string& path, bool onlyAnimation, FbxData& data)
+{
+	MappedFile file;
+	if (file.Open(path) == false) return Fail("    " + path);
+
+	NativeFbx::Reader reader;
+	if (reader.Parse(file.GetData(), (size_t)file.GetSize()) == false) return Fail(reader.GetError());
+
+	const NativeFbx::Node& root = reader.GetRoot();
+	const NativeFbx::Node* objects = root.Find("Objects");
+	const NativeFbx::Node* connections = root.Find("Connections");
+	if (objects == nullptr || connections == nullptr) return Fail("Objects  Connections  ");
+
+	if (ReadGlobalSettings(root) == false) return false;
+	ReadTakes(root);
+	CollectObjects(*objects);
+	CollectConnections(*connections);
+
+	for (int64_t child : mRootChildren) {
+		TraverseForSkeleton(child);
+	}
+
+	bool found = false;
+	for (int64_t child : mRootChildren) {
+		if (TraverseForMesh(child, found) == false) return false;
+	}
+
+	if (mResult.boneNames.empty() == false && ExtractAnimation() == false) return false;
+
+	// FbxExtractor::Extract ó ִϸ̼Ǹ    
+	if (onlyAnimation) mResult.vertices.clear();
+	data = move(mResult);
+	return true;
+}
+
+void NativeFbxImporter::Clear()
+{
+	mObjects.clear();
+	mObjectOrder.clear();
+	mModels.clear();
+	mRootChildren.clear();
+	mConnections.clear();
+	mCurves.clear();
+	mTakes.clear();
+	mResult = FbxData{};
+	mControlPointsWeight.clear();
+}
+
+bool NativeFbxImporter::Fail(const string& error)
+{
+	mError = error;
+	return false;
+}
+
+bool NativeFbxImporter::ReadGlobalSettings(const NativeFbx::Node& root)
+{
+	const NativeFbx::Node* settings = root.Find("GlobalSettings");
+	if (settings == nullptr) return Fail("GlobalSettings  ");
+
+	auto readInt = [&](const char* name, int64_t defaultValue) {
+		const NativeFbx::Node* p = FindProperty70(*settings, name);
+		return (p != nullptr && p->properties.size() > 4) ? p->properties[4].AsInt() : defaultValue;
+	};
+
+	int64_t timeMode = readInt("TimeMode", 0);
+	if (timeMode < 0 || timeMode >= (int64_t)size(sFrameRates) || sFrameRates[timeMode] == 0.0) {
+		return Fail(" ʴ TimeMode " + to_string(timeMode));
+	}
+	mFrameTicks = (int64_t)(sTicksPerSecond / sFrameRates[timeMode]);
+
+	//  Y , +Z , X ʸ ޴´.  Ʈ fbx   ̷
+	if (readInt("UpAxis", 1) != 1 || readInt("UpAxisSign", 1) != 1 ||
+		readInt("FrontAxis", 2) != 2 || readInt("FrontAxisSign", 1) != 1 || readInt("CoordAxis", 0) != 0) {
+		return Fail("Y  ƴ  ");
+	}
+
+	// ConvertSceneAxisSystem  ȸ. Z  ٲ  Y -> Z, Z -> Y, X -> -X
+	mAxisConversion = Identity();
+	if (mZUp) {
+		mAxisConversion.m[0][0] = -1.0;
+		mAxisConversion.m[1][1] = 0.0; mAxisConversion.m[1][2] = 1.0;
+		mAxisConversion.m[2][2] = 0.0; mAxisConversion.m[2][1] = 1.0;
+	}
+	return true;
+}
+
+void NativeFbxImporter::ReadTakes(const NativeFbx::Node& root)
+{
+	const NativeFbx::Node* takes = root.Find("Takes");
+	if (takes == nullptr) return;
+
+	for (auto& take : takes->children) {
+		if (take.name != "Take" || take.properties.empty()) continue;
+		const NativeFbx::Node* localTime = take.Find("LocalTime");
+		if (localTime == nullptr || localTime->properties.size() < 2) continue;
+		mTakes[take.properties[0].AsString()] = Take{ localTime->properties[0].AsInt(), localTime->properties[1].AsInt() };
+	}
+}
+
+void NativeFbxImporter::CollectObjects(const NativeFbx::Node& objects)
+{
+	for (auto& object : objects.children) {
+		if (object.properties.empty()) continue;
+		int64_t id = object.properties[0].AsInt();
+		mObjects[id] = &object;
+		mObjectOrder.push_back(id);
+
+		if (object.name == "Model") {
+			Model& model = mModels[id];
+			model.node = &object;
+			model.name = ObjectName(object);
+			model.skeleton = ObjectClass(object) == "LimbNode" || ObjectClass(object) == "Root" || ObjectClass(object) == "Limb";
+			ReadProperties(object, model);
+		}
+		else if (object.name == "AnimationCurve") {
+			Curve& curve = mCurves[id];
+			const NativeFbx::Node* times = object.Find("KeyTime");
+			const NativeFbx::Node* values = object.Find("KeyValueFloat");
+			if (times == nullptr || values == nullptr || times->properties.empty() || values->properties.empty() ||
+				times->properties[0].GetArray(curve.times) == false || values->properties[0].GetArray(curve.values) == false ||
+				curve.times.size() != curve.values.size()) {
+				mCurves.erase(id);
+			}
+		}
+	}
+}
+
+void NativeFbxImporter::CollectConnections(const NativeFbx::Node& connections)
+{
+	for (auto& c : connections.children) {
+		if (c.name != "C" || c.properties.size() < 3) continue;
+		Connection connection{ c.properties[1].AsInt(), c.properties[2].AsInt(), {} };
+		if (c.properties.size() > 3) connection.property = c.properties[3].AsString();
+		mConnections.push_back(connection);
+
+		//  .  Ӽ(NodeAttribute)    ̷ Ѵ
+		auto child = mModels.find(connection.child);
+		if (child == mModels.end()) {
+			auto model = mModels.find(connection.parent);
+			auto object = mObjects.find(connection.child);
+			if (model != mModels.end() && object != mObjects.end()) {
+				if (object->second->name == "NodeAttribute") {
+					string type = ObjectClass(*object->second);
+					model->second.skeleton = type == "LimbNode" || type == "Root" || type == "Limb";
+				}
+				else if (object->second->name == "Geometry" && model->second.geometry == 0) {
+					model->second.geometry = connection.child;
+				}
+			}
+			continue;
+		}
+		if (connection.property.empty() == false) continue;
+
+		if (connection.parent == 0) {
+			child->second.parent = 0;
+			mRootChildren.push_back(connection.child);
+		}
+		else {
+			auto parent = mModels.find(connection.parent);
+			if (parent == mModels.end()) continue;
+			child->second.parent = connection.parent;
+			parent->second.children.push_back(connection.child);
+		}
+	}
+}
+
+void NativeFbxImporter::TraverseForSkeleton(int64_t id)
+{
+	const Model& model = mModels[id];
+	if (model.skeleton) {
+		int parentIndex = -1;
+		auto parent = mModels.find(model.parent);
+		if (parent != mModels.end() && parent->second.skeleton) parentIndex = FindBoneIndex(parent->second.name);
+		mResult.boneHierarchy.push_back(parentIndex);
+		mResult.boneNames.push_back(model.name);
+	}
+
+	for (int64_t child : model.children) {
+		TraverseForSkeleton(child);
+	}
+}
+
+bool NativeFbxImporter::TraverseForMesh(int64_t id, bool& found)
+{
+	const Model& model = mModels[id];
+	if (found == false && model.geometry != 0) {
+		auto geometry = mObjects.find(model.geometry);
+		if (geometry != mObjects.end() && ObjectClass(*geometry->second) == "Mesh") {
+			found = true;
+			if (ExtractMesh(*geometry->second) == false) return false;
+		}
+	}
+
+	for (int64_t child : model.children) {
+		if (TraverseForMesh(child, found) == false) return false;
+	}
+	return true;
+}
+
+bool NativeFbxImporter::ExtractMesh(const NativeFbx::Node& geometry)
+{
+	const NativeFbx::Node* verticesNode = geometry.Find("Vertices");
+	const NativeFbx::Node* indicesNode = geometry.Find("PolygonVertexIndex");
+	if (verticesNode == nullptr || indicesNode == nullptr || verticesNode->properties.empty() || indicesNode->properties.empty()) {
+		return Fail("޽ Vertices  PolygonVertexIndex  ");
+	}
+
+	vector<double> controlPoints;
+	vector<int> polygonVertices;
+	if (verticesNode->properties[0].GetArray(controlPoints) == false || indicesNode->properties[0].GetArray(polygonVertices) == false) {
+		return Fail("޽ 迭   ");
+	}
+	size_t controlPointCount = controlPoints.size() / 3;
+
+	// ﰢ ƴϸ ä÷ . corners     ȣ /UV  ״ ã´
+	// FbxExtractor ó ù ︸  Ѵ
+	vector<int> corners;
+	corners.reserve(polygonVertices.size());
+	size_t polygonStart = 0;
+	bool triangulate = polygonVertices.size() < 3 || polygonVertices[2] >= 0;
+	for (size_t i = 0; i < polygonVertices.size(); ++i) {
+		if (polygonVertices[i] >= 0) continue;
+		if (triangulate) {
+			for (size_t j = polygonStart + 1; j + 1 <= i; ++j) {
+				corners.push_back((int)polygonStart);
+				corners.push_back((int)j);
+				corners.push_back((int)j + 1);
+			}
+		}
+		else {
+			for (size_t j = polygonStart; j <= i; ++j) corners.push_back((int)j);
+		}
+		polygonStart = i + 1;
+	}
+	for (int& index : polygonVertices) {
+		if (index < 0) index = ~index;
+		if ((size_t)index >= controlPointCount) return Fail("Ʈ Ʈ ȣ  ");
+	}
+
+	// ̾ .  ٰ ƴϸ SDK  ñ
+	auto readLayer = [&](const char* layerName, const char* valueName, const char* indexName, int stride,
+		vector<double>& values, vector<int>& indices, bool& exist) {
+		exist = false;
+		const NativeFbx::Node* layer = geometry.Find(layerName);
+		if (layer == nullptr) return true;
+		exist = true;
+
+		const NativeFbx::Node* mapping = layer->Find("MappingInformationType");
+		const NativeFbx::Node* reference = layer->Find("ReferenceInformationType");
+		const NativeFbx::Node* valueNode = layer->Find(valueName);
+		if (mapping == nullptr || reference == nullptr || valueNode == nullptr ||
+			mapping->properties.empty() || reference->properties.empty() || valueNode->properties.empty()) return Fail(string{ layerName } + "   ");
+		if (mapping->properties[0].AsString() != "ByPolygonVertex") return Fail(string{ layerName } + "  ByPolygonVertex  ƴ");
+		if (valueNode->properties[0].GetArray(values) == false) return Fail(string{ layerName } + "    ");
+
+		string referenceMode = reference->properties[0].AsString();
+		if (referenceMode == "Direct") {
+			indices.resize(polygonVertices.size());
+			for (size_t i = 0; i < indices.size(); ++i) indices[i] = (int)i;
+		}
+		else if (referenceMode == "IndexToDirect" || referenceMode == "Index") {
+			const NativeFbx::Node* indexNode = layer->Find(indexName);
+			if (indexNode == nullptr || indexNode->properties.empty() || indexNode->properties[0].GetArray(indices) == false) return Fail(string{ layerName } + " ε   ");
+		}
+		else {
+			return Fail(string{ layerName } + "   " + referenceMode);
+		}
+
+		if (indices.size() != polygonVertices.size()) return Fail(string{ layerName } + "     ٸ");
+		for (int index : indices) {
+			if (index < 0 || (size_t)index * stride + stride > values.size()) return Fail(string{ layerName } + " ε  ");
+		}
+		return true;
+	};
+
+	vector<double> normals, uvs;
+	vector<int> normalIndices, uvIndices;
+	bool hasNormal, hasUV;
+	if (readLayer("LayerElementNormal", "Normals", "NormalsIndex", 3, normals, normalIndices, hasNormal) == false) return false;
+	if (hasNormal == false) return Fail(" ");
+	if (readLayer("LayerElementUV", "UV", "UVIndex", 2, uvs, uvIndices, hasUV) == false) return false;
+
+	bool bone = mResult.boneNames.empty() == false;
+	if (bone) {
+		if (ExtractSkin(geometry.properties[0].AsInt(), controlPointCount) == false) return false;
+		NormalizeWeight();
+	}
+
+	vector<Vertex>& vertices = mResult.vertices;
+	vertices.resize(corners.size());
+	for (size_t i = 0; i < corners.size(); ++i) {
+		int corner = corners[i];
+		int controlPoint = polygonVertices[corner];
+
+		vertices[i].position.x = (float)controlPoints[controlPoint * 3 + 0];
+		vertices[i].position.y = (float)controlPoints[controlPoint * 3 + 1];
+		vertices[i].position.z = (float)controlPoints[controlPoint * 3 + 2];
+
+		int n = normalIndices[corner];
+		vertices[i].normal.x = (float)normals[n * 3 + 0];
+		vertices[i].normal.y = (float)normals[n * 3 + 1];
+		vertices[i].normal.z = (float)normals[n * 3 + 2];
+
+		if (hasUV) {
+			int t = uvIndices[corner];
+			vertices[i].uv.x = (float)uvs[t * 2 + 0];
+			vertices[i].uv.y = 1 - (float)uvs[t * 2 + 1];
+		}
+		else {
+			vertices[i].uv.x = 0.5f;
+			vertices[i].uv.y = 0.5f;
+		}
+
+		if (bone) {
+			auto& weights = mControlPointsWeight[controlPoint];
+			vertices[i].weight = XMFLOAT4{ weights[0].second, weights[1].second, weights[2].second, weights[3].second };
+			for (int j = 0; j < 4; ++j) vertices[i].boneIndex[j] = weights[j].first;
+		}
+	}
+	return true;
+}
+
+bool NativeFbxImporter::ExtractSkin(int64_t geometryId, size_t controlPointCount)
+{
+	mControlPointsWeight.resize(controlPointCount);
+	mResult.offsetMatrix.resize(mResult.boneNames.size());
+
+	for (int64_t skin : FindChildren(geometryId, "Deformer")) {
+		if (ObjectClass(*mObjects[skin]) != "Skin") continue;
+
+		for (int64_t clusterId : FindChildren(skin, "Deformer")) {
+			const NativeFbx::Node& cluster = *mObjects[clusterId];
+			if (ObjectClass(cluster) != "Cluster") continue;
+
+			vector<int64_t> links = FindChildren(clusterId, "Model");
+			if (links.empty()) continue;
+			int linkIndex = FindBoneIndex(mModels[links[0]].name);
+			if (linkIndex < 0) continue;
+
+			vector<double> transform, transformLink, weights;
+			vector<int> indices;
+			const NativeFbx::Node* transformNode = cluster.Find("Transform");
+			const NativeFbx::Node* transformLinkNode = cluster.Find("TransformLink");
+			if (transformNode == nullptr || transformLinkNode == nullptr || transformNode->properties.empty() || transformLinkNode->properties.empty() ||
+				transformNode->properties[0].GetArray(transform) == false || transformLinkNode->properties[0].GetArray(transformLink) == false ||
+				transform.size() != 16 || transformLink.size() != 16) {
+				return Fail("Ŭ    ");
+			}
+
+			// FbxAMatrix  TransformLink.Inverse() * Transform.   ġ  ݴ
+			mResult.offsetMatrix[linkIndex] = ToFloat4x4(Multiply(FromArray(transform), Inverse(FromArray(transformLink))));
+
+			const NativeFbx::Node* indexNode = cluster.Find("Indexes");
+			const NativeFbx::Node* weightNode = cluster.Find("Weights");
+			if (indexNode == nullptr || weightNode == nullptr) continue;
+			if (indexNode->properties.empty() || weightNode->properties.empty() ||
+				indexNode->properties[0].GetArray(indices) == false || weightNode->properties[0].GetArray(weights) == false || indices.size() != weights.size()) {
+				return Fail("Ŭ ġ   ");
+			}
+			for (size_t i = 0; i < indices.size(); ++i) {
+				if (indices[i] < 0 || (size_t)indices[i] >= controlPointCount) return Fail("Ŭ ȣ  ");
+				mControlPointsWeight[indices[i]].emplace_back(pair<int, float>{linkIndex, static_cast<float>(weights[i])});
+			}
+		}
+	}
+	return true;
+}
+
+void NativeFbxImporter::NormalizeWeight()
+{
+	// FbxExtractor::NormalizeWeight  . ū 4    1  ǰ Ѵ
+	for (auto& controlPointWeight : mControlPointsWeight) {
+		if (controlPointWeight.size() > 4) {
+			partial_sort(controlPointWeight.begin(), controlPointWeight.begin() + 4, controlPointWeight.end(),
+				[](const pair<int, float>& a, const pair<int, float>& b) {
+					return a.second > b.second;
+				});
+		}
+
+		controlPointWeight.resize(4);
+
+		float totalWeight{ 0.f };
+		for (auto& weight : controlPointWeight) {
+			totalWeight += weight.second;
+		}
+		for (auto& weight : controlPointWeight) {
+			weight.second /= totalWeight;
+		}
+	}
+}
+
+bool NativeFbxImporter::ExtractAnimation()
+{
+	for (int64_t stackId : mObjectOrder) {
+		const NativeFbx::Node& stack = *mObjects[stackId];
+		if (stack.name != "AnimationStack") continue;
+
+		string clipName = ObjectName(stack);
+		vector<int64_t> layers = FindChildren(stackId, "AnimationLayer");
+		if (layers.empty()) continue;
+
+		AnimationClip& clip = mResult.animations[clipName];
+
+		// ù ̾ Ŀ 带  Ӽ 
+		unordered_map<int64_t, array<Channel, 3>> channels;
+		for (int64_t curveNodeId : FindChildren(layers[0], "AnimationCurveNode")) {
+			for (auto& c : mConnections) {
+				if (c.child != curveNodeId || mModels.count(c.parent) == 0) continue;
+
+				int component = c.property == "Lcl Translation" ? 0 : c.property == "Lcl Rotation" ? 1 : c.property == "Lcl Scaling" ? 2 : -1;
+				if (component < 0) continue;
+
+				const Model& model = mModels[c.parent];
+				const double* modelValue = component == 0 ? model.translation : component == 1 ? model.rotation : model.scaling;
+				Channel& channel = channels[c.parent][component];
+				channel.animated = true;
+				const char* defaults[] = { "d|X", "d|Y", "d|Z" };
+				for (int axis = 0; axis < 3; ++axis) {
+					const NativeFbx::Node* p = FindProperty70(*mObjects[curveNodeId], defaults[axis]);
+					channel.value[axis] = (p != nullptr && p->properties.size() > 4) ? p->properties[4].AsDouble() : modelValue[axis];
+				}
+				for (auto& curveConnection : mConnections) {
+					if (curveConnection.parent != curveNodeId) continue;
+					for (int axis = 0; axis < 3; ++axis) {
+						if (curveConnection.property == defaults[axis]) channel.curves[axis] = FindCurve(curveConnection.child);
+					}
+				}
+			}
+		}
+
+		// ũ    ð  
+		Take take{};
+		auto takeInfo = mTakes.find(clipName);
+		if (takeInfo != mTakes.end()) {
+			take = takeInfo->second;
+		}
+		else {
+			const NativeFbx::Node* start = FindProperty70(stack, "LocalStart");
+			const NativeFbx::Node* stop = FindProperty70(stack, "LocalStop");
+			if (start == nullptr || stop == nullptr || start->properties.size() < 5 || stop->properties.size() < 5) return Fail(clipName + "  ð  ");
+			take = Take{ start->properties[4].AsInt(), stop->properties[4].AsInt() };
+		}
+
+		for (int64_t child : mRootChildren) {
+			TraverseForAnimation(child, channels, take.start / mFrameTicks, take.stop / mFrameTicks, clip);
+		}
+	}
+	return true;
+}
+
+void NativeFbxImporter::TraverseForAnimation(int64_t id, const unordered_map<int64_t, array<Channel, 3>>& channels, int64_t startFrame, int64_t stopFrame, AnimationClip& clip)
+{
+	const Model& model = mModels[id];
+	if (model.skeleton) {
+		// ִϸ̼  Ӽ   ״
+		Channel merged[3];
+		for (int axis = 0; axis < 3; ++axis) {
+			merged[0].value[axis] = model.translation[axis];
+			merged[1].value[axis] = model.rotation[axis];
+			merged[2].value[axis] = model.scaling[axis];
+		}
+		auto animated = channels.find(id);
+		if (animated != channels.end()) {
+			for (int component = 0; component < 3; ++component) {
+				if (animated->second[component].animated) merged[component] = animated->second[component];
+			}
+		}
+
+		BoneAnimation boneAnimation;
+		Keyframe keyframe;
+		for (int64_t frame = startFrame; frame < stopFrame; ++frame) {
+			int64_t time = frame * mFrameTicks;
+			keyframe.TimePos = static_cast<float>((double)time / sTicksPerSecond);
+			Decompose(EvaluateLocal(model, merged, time), keyframe);
+			boneAnimation.Keyframes.push_back(keyframe);
+		}
+		clip.BoneAnimations.push_back(boneAnimation);
+	}
+
+	for (int64_t child : model.children) {
+		TraverseForAnimation(child, channels, startFrame, stopFrame, clip);
+	}
+}
+
+NativeFbxImporter::Matrix NativeFbxImporter::EvaluateLocal(const Model& model, const Channel* channels, int64_t time)
+{
+	double values[3][3];
+	for (int component = 0; component < 3; ++component) {
+		for (int axis = 0; axis < 3; ++axis) {
+			const Curve* curve = channels[component].curves[axis];
+			values[component][axis] = curve != nullptr ? EvaluateCurve(*curve, time) : channels[component].value[axis];
+		}
+	}
+
+	// FBX  T * Roff * Rp * Rpre * R * Rpost^-1 * Rp^-1 * Soff * Sp * S * Sp^-1    
+	static const double zero[3]{};
+	int order = model.rotationActive ? model.rotationOrder : 0;
+	Matrix preRotation = EulerRotation(model.rotationActive ? model.preRotation : zero, 0);
+	Matrix postRotation = EulerRotation(model.rotationActive ? model.postRotation : zero, 0);
+
+	Matrix scalingPivot = Translation(model.scalingPivot);
+	Matrix rotationPivot = Translation(model.rotationPivot);
+	Matrix local = Inverse(scalingPivot);
+	local = Multiply(local, Scaling(values[2]));
+	local = Multiply(local, scalingPivot);
+	local = Multiply(local, Translation(model.scalingOffset));
+	local = Multiply(local, Inverse(rotationPivot));
+	local = Multiply(local, Inverse(postRotation));
+	local = Multiply(local, EulerRotation(values[1], order));
+	local = Multiply(local, preRotation);
+	local = Multiply(local, rotationPivot);
+	local = Multiply(local, Translation(model.rotationOffset));
+	local = Multiply(local, Translation(values[0]));
+
+	if (model.parent == 0) local = Multiply(local, mAxisConversion);
+	return local;
+}
+
+int NativeFbxImporter::FindBoneIndex(const string& name)
+{
+	int index{ 0 };
+	for (auto& n : mResult.boneNames) {
+		if (n == name) return index;
+		++index;
+	}
+	return -1;
+}
+
+vector<int64_t> NativeFbxImporter::FindChildren(int64_t parent, const char* nodeName)
+{
+	vector<int64_t> children;
+	for (auto& c : mConnections) {
+		if (c.parent != parent) continue;
+		auto object = mObjects.find(c.child);
+		if (object != mObjects.end() && object->second->name == nodeName) children.push_back(c.child);
+	}
+	return children;
+}
+
+const NativeFbxImporter::Curve* NativeFbxImporter::FindCurve(int64_t id)
+{
+	auto curve = mCurves.find(id);
+	return curve != mCurves.end() && curve->second.times.empty() == false ? &curve->second : nullptr;
+}
+
+string NativeFbxImporter::ObjectName(const NativeFbx::Node& node)
+{
+	if (node.properties.size() < 2) return {};
+	string name = node.properties[1].AsString();
+	size_t separator = name.find(sNameSeparator);
+	return separator == string::npos ? name : name.substr(0, separator);
+}
+
+string NativeFbxImporter::ObjectClass(const NativeFbx::Node& node)
+{
+	return node.properties.size() < 3 ? string{} : node.properties[2].AsString();
+}
+
+const NativeFbx::Node* NativeFbxImporter::FindProperty70(const NativeFbx::Node& node, const char* name)
+{
+	const NativeFbx::Node* properties = node.Find("Properties70");
+	if (properties == nullptr) return nullptr;
+	for (auto& p : properties->children) {
+		if (p.properties.empty() == false && p.properties[0].AsString() == name) return &p;
+	}
+	return nullptr;
+}
+
+bool NativeFbxImporter::ReadVector(const NativeFbx::Node& node, const char* name, double* out)
+{
+	const NativeFbx::Node* p = FindProperty70(node, name);
+	if (p == nullptr || p->properties.size() < 7) return false;
+	for (int axis = 0; axis < 3; ++axis) out[axis] = p->properties[4 + axis].AsDouble();
+	return true;
+}
+
+void NativeFbxImporter::ReadProperties(const NativeFbx::Node& node, Model& model)
+{
+	ReadVector(node, "Lcl Translation", model.translation);
+	ReadVector(node, "Lcl Rotation", model.rotation);
+	ReadVector(node, "Lcl Scaling", model.scaling);
+	ReadVector(node, "PreRotation", model.preRotation);
+	ReadVector(node, "PostRotation", model.postRotation);
+	ReadVector(node, "RotationOffset", model.rotationOffset);
+	ReadVector(node, "RotationPivot", model.rotationPivot);
+	ReadVector(node, "ScalingOffset", model.scalingOffset);
+	ReadVector(node, "ScalingPivot", model.scalingPivot);
+
+	const NativeFbx::Node* p = FindProperty70(node, "RotationOrder");
+	if (p != nullptr && p->properties.size() > 4) model.rotationOrder = (int)p->properties[4].AsInt();
+	p = FindProperty70(node, "RotationActive");
+	if (p != nullptr && p->properties.size() > 4) model.rotationActive = p->properties[4].AsInt() != 0;
+}
+
+double NativeFbxImporter::EvaluateCurve(const Curve& curve, int64_t time)
+{
+	if (time <= curve.times.front()) return curve.values.front();
+	if (time >= curve.times.back()) return curve.values.back();
+
+	size_t next = upper_bound(curve.times.begin(), curve.times.end(), time) - curve.times.begin();
+	size_t prev = next - 1;
+	double t = double(time - curve.times[prev]) / double(curve.times[next] - curve.times[prev]);
+	return curve.values[prev] + (curve.values[next] - curve.values[prev]) * t;
+}
+
+NativeFbxImporter::Matrix NativeFbxImporter::Identity()
+{
+	Matrix result{};
+	for (int i = 0; i < 4; ++i) result.m[i][i] = 1.0;
+	return result;
+}
+
+NativeFbxImporter::Matrix NativeFbxImporter::Multiply(const Matrix& a, const Matrix& b)
+{
+	Matrix result{};
+	for (int row = 0; row < 4; ++row) {
+		for (int col = 0; col < 4; ++col) {
+			for (int k = 0; k < 4; ++k) result.m[row][col] += a.m[row][k] * b.m[k][col];
+		}
+	}
+	return result;
+}
+
+NativeFbxImporter::Matrix NativeFbxImporter::Inverse(const Matrix& matrix)
+{
+	// κ ǹ 콺 
+	Matrix a = matrix;
+	Matrix result = Identity();
+	for (int col = 0; col < 4; ++col) {
+		int pivot = col;
+		for (int row = col + 1; row < 4; ++row) {
+			if (fabs(a.m[row][col]) > fabs(a.m[pivot][col])) pivot = row;
+		}
+		if (a.m[pivot][col] == 0.0) return Identity();
+		swap(a.m[pivot], a.m[col]);
+		swap(result.m[pivot], result.m[col]);
+
+		double scale = 1.0 / a.m[col][col];
+		for (int k = 0; k < 4; ++k) {
+			a.m[col][k] *= scale;
+			result.m[col][k] *= scale;
+		}
+		for (int row = 0; row < 4; ++row) {
+			if (row == col) continue;
+			double factor = a.m[row][col];
+			for (int k = 0; k < 4; ++k) {
+				a.m[row][k] -= factor * a.m[col][k];
+				result.m[row][k] -= factor * result.m[col][k];
+			}
+		}
+	}
+	return result;
+}
+
+NativeFbxImporter::Matrix NativeFbxImporter::Translation(const double* t)
+{
+	Matrix result = Identity();
+	for (int axis = 0; axis < 3; ++axis) result.m[3][axis] = t[axis];
+	return result;
+}
+
+NativeFbxImporter::Matrix NativeFbxImporter::Scaling(const double* s)
+{
+	Matrix result = Identity();
+	for (int axis = 0; axis < 3; ++axis) result.m[axis][axis] = s[axis];
+	return result;
+}
+
+NativeFbxImporter::Matrix NativeFbxImporter::EulerRotation(const double* degrees, int order)
+{
+	Matrix axes[3];
+	for (int axis = 0; axis < 3; ++axis) {
+		double c = cos(degrees[axis] * sDegreeToRadian);
+		double s = sin(degrees[axis] * sDegreeToRadian);
+		int u = (axis + 1) % 3;
+		int v = (axis + 2) % 3;
+		axes[axis] = Identity();
+		axes[axis].m[u][u] = c; axes[axis].m[u][v] = s;
+		axes[axis].m[v][u] = -s; axes[axis].m[v][v] = c;
+	}
+
+	// EFbxRotationOrder. XYZ  X    ( Ϳ ʺ Ѵ)
+	static const int orders[][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 2, 0 }, { 1, 0, 2 }, { 2, 0, 1 }, { 2, 1, 0 }, { 0, 1, 2 } };
+	const int* sequence = orders[(order >= 0 && order < 7) ? order : 0];
+	return Multiply(Multiply(axes[sequence[0]], axes[sequence[1]]), axes[sequence[2]]);
+}
+
+NativeFbxImporter::Matrix NativeFbxImporter::FromArray(const vector<double>& values)
+{
+	Matrix result{};
+	for (int i = 0; i < 16; ++i) result.m[i / 4][i % 4] = values[i];
+	return result;
+}
+
+XMFLOAT4X4 NativeFbxImporter::ToFloat4x4(const Matrix& matrix)
+{
+	XMFLOAT4X4 result;
+	for (int row = 0; row < 4; ++row) {
+		for (int col = 0; col < 4; ++col) result.m[row][col] = static_cast<float>(matrix.m[row][col]);
+	}
+	return result;
+}
+
+void NativeFbxImporter::Decompose(const Matrix& matrix, Keyframe& keyframe)
+{
+	keyframe.Translation = XMFLOAT3{ (float)matrix.m[3][0], (float)matrix.m[3][1], (float)matrix.m[3][2] };
+
+	double r[3][3];
+	double scale[3];
+	for (int row = 0; row < 3; ++row) {
+		scale[row] = sqrt(matrix.m[row][0] * matrix.m[row][0] + matrix.m[row][1] * matrix.m[row][1] + matrix.m[row][2] * matrix.m[row][2]);
+	}
+	double determinant =
+		matrix.m[0][0] * (matrix.m[1][1] * matrix.m[2][2] - matrix.m[1][2] * matrix.m[2][1]) -
+		matrix.m[0][1] * (matrix.m[1][0] * matrix.m[2][2] - matrix.m[1][2] * matrix.m[2][0]) +
+		matrix.m[0][2] * (matrix.m[1][0] * matrix.m[2][1] - matrix.m[1][1] * matrix.m[2][0]);
+	if (determinant < 0.0) {
+		for (double& s : scale) s = -s;
+	}
+	for (int row = 0; row < 3; ++row) {
+		for (int col = 0; col < 3; ++col) r[row][col] = scale[row] != 0.0 ? matrix.m[row][col] / scale[row] : 0.0;
+	}
+	keyframe.Scale = XMFLOAT3{ (float)scale[0], (float)scale[1], (float)scale[2] };
+
+	//   ȸ Ŀ  (XMQuaternionRotationMatrix   Ģ)
+	double x, y, z, w;
+	double trace = r[0][0] + r[1][1] + r[2][2];
+	if (trace > 0.0) {
+		double s = sqrt(trace + 1.0) * 2.0;
+		w = 0.25 * s;
+		x = (r[1][2] - r[2][1]) / s;
+		y = (r[2][0] - r[0][2]) / s;
+		z = (r[0][1] - r[1][0]) / s;
+	}
+	else if (r[0][0] > r[1][1] && r[0][0] > r[2][2]) {
+		double s = sqrt(1.0 + r[0][0] - r[1][1] - r[2][2]) * 2.0;
+		x = 0.25 * s;
+		w = (r[1][2] - r[2][1]) / s;
+		y = (r[0][1] + r[1][0]) / s;
+		z = (r[2][0] + r[0][2]) / s;
+	}
+	else if (r[1][1] > r[2][2]) {
+		double s = sqrt(1.0 + r[1][1] - r[0][0] - r[2][2]) * 2.0;
+		y = 0.25 * s;
+		w = (r[2][0] - r[0][2]) / s;
+		x = (r[0][1] + r[1][0]) / s;
+		z = (r[1][2] + r[2][1]) / s;
+	}
+	else {
+		double s = sqrt(1.0 + r[2][2] - r[0][0] - r[1][1]) * 2.0;
+		z = 0.25 * s;
+		w = (r[0][1] - r[1][0]) / s;
+		x = (r[2][0] + r[0][2]) / s;
+		y = (r[1][2] + r[2][1]) / s;
+	}
+	keyframe.RotationQuat = XMFLOAT4{ (float)x, (float)y, (float)z, (float)w };
+}
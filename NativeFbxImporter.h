@@ -0,0 +1,113 @@
+#pragma once
+#include <array>
+#include <unordered_map>
+#include "NativeFbx.h"
+#include "CookedAsset.h"
+
+// NativeFbx    Ʈ FbxExtractor::Extract   FbxData  .
+// ( ), Ų Ŭ,  , ũ Ӹ  Ű   Ģ ̴´.
+//   ʰ false  ش. ȣ  FBX SDK  ٽ  ȴ.
+// - FBX 7.x ̳ʸ ƴ  (6.x, ASCII)
+// -  ٰ ƴ /UV (SDK    )
+//  ȯ ConvertScene ó  Ʈ ٷ Ʒ 忡 ȸ δ. ( ǥ ٲ ʴ´)
+// Ű   ̴.  Ʈ ũ Ӹ Ű ־ Ű ġ д´.
+class NativeFbxImporter
+{
+public:
+	bool Import(const string& path, bool onlyAnimation, bool zUp, FbxData& data);
+	const string& GetError();
+	// SDK    ִ  ˻. ε  ȣ ,  , ġ ,   ,   Ű .
+	//   Ƽ   ̰  ϸ SDK  ٽ д´. report    ´
+	static bool Check(const FbxData& data, string& report);
+private:
+	struct Matrix
+	{
+		double m[4][4];		// FbxAMatrix   ġ.   ̰ 4  ̵̴
+	};
+	struct Curve
+	{
+		vector<int64_t> times;
+		vector<float> values;
+	};
+	struct Channel
+	{
+		bool animated = false;	// ù ̾ Ŀ 尡 ִ
+		double value[3]{};		// Ŀ갡   
+		const Curve* curves[3]{};
+	};
+	struct Model
+	{
+		const NativeFbx::Node* node = nullptr;
+		string name;
+		int64_t parent = 0;		// 0 ̸  Ʈ
+		vector<int64_t> children;
+		int64_t geometry = 0;
+		bool skeleton = false;
+		double translation[3]{}, rotation[3]{}, scaling[3]{ 1.0, 1.0, 1.0 };
+		double preRotation[3]{}, postRotation[3]{};
+		double rotationOffset[3]{}, rotationPivot[3]{}, scalingOffset[3]{}, scalingPivot[3]{};
+		int rotationOrder = 0;
+		bool rotationActive = false;
+	};
+	struct Connection
+	{
+		int64_t child;
+		int64_t parent;
+		string property;	// OP Ḹ
+	};
+	struct Take
+	{
+		int64_t start;
+		int64_t stop;
+	};
+
+	bool Read(const string& path, bool onlyAnimation, FbxData& data);
+	void Clear();
+	bool Fail(const string& error);
+	bool ReadGlobalSettings(const NativeFbx::Node& root);
+	void ReadTakes(const NativeFbx::Node& root);
+	void CollectObjects(const NativeFbx::Node& objects);
+	void CollectConnections(const NativeFbx::Node& connections);
+	void TraverseForSkeleton(int64_t id);
+	bool TraverseForMesh(int64_t id, bool& found);
+	bool ExtractMesh(const NativeFbx::Node& geometry);
+	bool ExtractSkin(int64_t geometryId, size_t controlPointCount);
+	void NormalizeWeight();
+	bool ExtractAnimation();
+	void TraverseForAnimation(int64_t id, const unordered_map<int64_t, array<Channel, 3>>& channels, int64_t startFrame, int64_t stopFrame, AnimationClip& clip);
+	Matrix EvaluateLocal(const Model& model, const Channel* channels, int64_t time);
+	int FindBoneIndex(const string& name);
+	vector<int64_t> FindChildren(int64_t parent, const char* nodeName);	//  
+	const Curve* FindCurve(int64_t id);
+
+	static string ObjectName(const NativeFbx::Node& node);
+	static string ObjectClass(const NativeFbx::Node& node);
+	static const NativeFbx::Node* FindProperty70(const NativeFbx::Node& node, const char* name);
+	static bool ReadVector(const NativeFbx::Node& node, const char* name, double* out);
+	static void ReadProperties(const NativeFbx::Node& node, Model& model);
+	static double EvaluateCurve(const Curve& curve, int64_t time);
+	static Matrix Identity();
+	static Matrix Multiply(const Matrix& a, const Matrix& b);	// a  b
+	static Matrix Inverse(const Matrix& matrix);
+	static Matrix Translation(const double* t);
+	static Matrix Scaling(const double* s);
+	static Matrix EulerRotation(const double* degrees, int order);
+	static Matrix FromArray(const vector<double>& values);
+	static XMFLOAT4X4 ToFloat4x4(const Matrix& matrix);
+	static void Decompose(const Matrix& matrix, Keyframe& keyframe);
+private:
+	string mError;
+	bool mZUp = true;
+	unordered_map<int64_t, const NativeFbx::Node*> mObjects;
+	vector<int64_t> mObjectOrder;
+	unordered_map<int64_t, Model> mModels;
+	vector<int64_t> mRootChildren;
+	vector<Connection> mConnections;
+	unordered_map<int64_t, Curve> mCurves;
+	unordered_map<string, Take> mTakes;
+	Matrix mAxisConversion{};
+	int64_t mFrameTicks = 0;
+
+	FbxData mResult;
+	vector<vector<pair<int, float>>> mControlPointsWeight;
+};
@@ -63,6 +63,31 @@ void Object::OnProcessCollision(Object& other, XMVECTOR collisionNormal, float p
     }
 }
 
+void Object::OnTrigger(Object& other)
+{
+}
+
+void Object::LandOnGround()
+{
+    // ݴ ƮŴ о⿡  Ƿ  ̳ ü 鿡   ̿ ´
+    Gravity* gravity = GetComponent<Gravity>();
+    Collider* collider = GetComponent<Collider>();
+    if (!gravity || !collider || m_parent_id != -1) return;
+
+    Transform* transform = GetComponent<Transform>();
+    XMFLOAT3 p;
+    XMStoreFloat3(&p, transform->GetPosition());
+    float ground = m_scene->GetGroundHeight(p.x, p.z, collider->GetAABB().Center.y);
+    if (p.y > ground) return;
+    p.y = ground;
+    transform->SetPosition(XMLoadFloat3(&p));
+    gravity->ResetElapseTime();
+}
+
+void Object::OnProjectileHit()
+{
+}
+
 void Object::LateUpdate(GameTimer& gTimer)
 {
     Transform* transform = GetComponent<Transform>();
@@ -102,7 +127,9 @@ void Object::LateUpdate(GameTimer& gTimer)
     }
     memcpy(m_mappedData, &XMMatrixTranspose(adjustM * world), sizeof(XMMATRIX));
 
-    ProcessAnimation(gTimer);
+    // ȷƮ  Ʈ LateUpdate    AnimationSystem  Ѳ .
+    int isAnimate = GetComponent<Animation>() ? true : false;
+    memcpy(m_mappedData + sizeof(XMMATRIX), &isAnimate, sizeof(int));
 
     Texture* texture = GetComponent<Texture>();
     float powValue = 1.0f;
@@ -111,8 +138,8 @@ void Object::LateUpdate(GameTimer& gTimer)
         ambiantValue = texture->mAmbiantValue;
         powValue = texture->mPowValue;
     }
-    memcpy(m_mappedData + sizeof(XMFLOAT4X4) * 91 + sizeof(int) * 4, &powValue, sizeof(float));
-    memcpy(m_mappedData + sizeof(XMFLOAT4X4) * 91 + sizeof(int) * 4 + sizeof(float), &ambiantValue, sizeof(float));
+    memcpy(m_mappedData + sizeof(XMFLOAT4X4) + sizeof(int) * 4, &powValue, sizeof(float));
+    memcpy(m_mappedData + sizeof(XMFLOAT4X4) + sizeof(int) * 4 + sizeof(float), &ambiantValue, sizeof(float));
 }
 
 void Object::OnRender(ID3D12Device* device, ID3D12GraphicsCommandList* commandList)
@@ -129,12 +156,7 @@ void Object::OnRender(ID3D12Device* device, ID3D12GraphicsCommandList* commandLi
     commandList->SetGraphicsRootConstantBufferView(2, m_constantBuffer.Get()->GetGPUVirtualAddress());
 
     SubMeshData& data = m_scene->GetResourceManager().GetSubMeshData(mesh->mName);
-    if (data.startIndexLocation == -1) {
-        commandList->DrawInstanced(data.vertexCountPerInstance, 1, data.startVertexLocation, 0);
-    }
-    else {
-        commandList->DrawIndexedInstanced(data.indexCountPerInstance, 1, data.startIndexLocation, data.baseVertexLocation, 0);
-    }
+    m_scene->DrawSubMesh(commandList, data, 1);
 
 }
 
@@ -160,22 +182,10 @@ void Object::AddComponent(Component* component)
     m_components.push_back(component);
 }
 
-void Object::ProcessAnimation(GameTimer& gTimer)
+void Object::SetPalette(UINT offset, int skinningMode)
 {
-    Animation* animation = GetComponent<Animation>();
-    int isAnimate = false;
-    if (animation) {
-        isAnimate = true;
-        vector<XMFLOAT4X4> finalTransforms{ 90 };
-        SkinnedData& animData = m_scene->GetResourceManager().GetAnimationData(animation->mCurrentFileName);
-        animation->mAnimationTime += gTimer.DeltaTime();
-        string clipName = "Take 001";
-        if (animation->mAnimationTime >= animData.GetClipEndTime(clipName)) animation->mAnimationTime = 0.0f;
-        animData.GetFinalTransforms(clipName, animation->mAnimationTime, finalTransforms);
-        memcpy(m_mappedData + sizeof(XMMATRIX), finalTransforms.data(), sizeof(XMMATRIX) * 90); // ó Ű ּ
-    }
-    memcpy(m_mappedData + sizeof(XMMATRIX) * 91, &isAnimate, sizeof(int));
-
+    memcpy(m_mappedData + sizeof(XMMATRIX) + sizeof(int), &offset, sizeof(UINT));
+    memcpy(m_mappedData + sizeof(XMMATRIX) + sizeof(int) * 2, &skinningMode, sizeof(int));
 }
 
 uint32_t Object::GetId()
@@ -204,17 +214,20 @@ void PlayerObject::OnUpdate(GameTimer& gTimer)
 void PlayerObject::OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration)
 {
     Transform* transform = GetComponent<Transform>();
-    
-    PlayerAttackObject* pa = dynamic_cast<PlayerAttackObject*>(&other);
-    if (pa) return;
+    XMVECTOR pos = transform->GetPosition();
+    pos -= collisionNormal * penetration;
+    transform->SetPosition(pos);
 
-    TigerAttackObject* ta = dynamic_cast<TigerAttackObject*>(&other);
-    if (ta) // ȣ ݿ ...
-    {
-        Hit();
-        return;
+    float similarity = XMVectorGetX(XMVector3Dot(XMVECTOR{ 0.0f, 1.0f, 0.0f, 0.0f }, -collisionNormal));
+    Gravity* gravity = GetComponent<Gravity>();
+    if (gravity && similarity > 0.80f) {
+        gravity->ResetElapseTime();
+        mIsJumpping = false;
     }
+}
 
+void PlayerObject::OnTrigger(Object& other)
+{
     TigerLeather* leather = dynamic_cast<TigerLeather*>(&other);
     if (leather)
     {
@@ -222,12 +235,6 @@ void PlayerObject::OnProcessCollision(Object& other, XMVECTOR collisionNormal, f
         return;
     }
 
-    AxeObject* axe = dynamic_cast<AxeObject*>(&other);
-    if (axe)
-    {
-        return;
-    }
-
     RiceCakeObject* riceCake = dynamic_cast<RiceCakeObject*>(&other);
     if (riceCake)
     {
@@ -235,17 +242,6 @@ void PlayerObject::OnProcessCollision(Object& other, XMVECTOR collisionNormal, f
         mRiceCake = mRiceCake > 4 ? 4 : mRiceCake;
         return;
     }
-
-    XMVECTOR pos = transform->GetPosition();
-    pos -= collisionNormal * penetration;
-    transform->SetPosition(pos);
-
-    float similarity = XMVectorGetX(XMVector3Dot(XMVECTOR{ 0.0f, 1.0f, 0.0f, 0.0f }, -collisionNormal));
-    Gravity* gravity = GetComponent<Gravity>();
-    if (gravity && similarity > 0.80f) {
-        gravity->ResetElapseTime();
-        mIsJumpping = false;
-    }
 }
 
 int PlayerObject::GetRiceCakeCount()
@@ -322,19 +318,19 @@ void PlayerObject::ProcessInput(const GameTimer& gTimer)
     }
 }
 
-void PlayerObject::ChangeState(string fileName)
+void PlayerObject::ChangeState(int state)
 {
     Animation* anim = GetComponent<Animation>();
-    if(anim->ResetAnim(fileName, 0.0f)) mElapseTime = 0.0f;
+    if(anim->ResetAnim(state, 0.0f)) mElapseTime = 0.0f;
 }
 
 void PlayerObject::MoveAndRotate(float deltaTime)
 {
     Animation* anim = GetComponent<Animation>();
-    if (anim->mCurrentFileName == "boy_attack(45).fbx") return;
-    if (anim->mCurrentFileName == "boy_throw.fbx") return;
-    if (anim->mCurrentFileName == "boy_hit.fbx") return;
-    if (anim->mCurrentFileName == "boy_dying_fix.fbx") return;
+    if (anim->mCurrentAnim == BOY_ATTACK) return;
+    if (anim->mCurrentAnim == BOY_THROW) return;
+    if (anim->mCurrentAnim == BOY_HIT) return;
+    if (anim->mCurrentAnim == BOY_DYING) return;
 
     Transform* transform = GetComponent<Transform>();
     CameraObject* cameraObj = m_scene->GetObj<CameraObject>();
@@ -370,31 +366,31 @@ void PlayerObject::MoveAndRotate(float deltaTime)
 void PlayerObject::Idle()
 {
     Animation* anim = GetComponent<Animation>();
-    if (anim->mCurrentFileName == "boy_attack(45).fbx") return;
-    if (anim->mCurrentFileName == "boy_throw.fbx") return;
-    if (anim->mCurrentFileName == "boy_hit.fbx") return;
-    if (anim->mCurrentFileName == "boy_dying_fix.fbx") return;
-    ChangeState("1P(boy-idle).fbx");
+    if (anim->mCurrentAnim == BOY_ATTACK) return;
+    if (anim->mCurrentAnim == BOY_THROW) return;
+    if (anim->mCurrentAnim == BOY_HIT) return;
+    if (anim->mCurrentAnim == BOY_DYING) return;
+    ChangeState(BOY_IDLE);
 }
 
 void PlayerObject::Walk()
 {
     Animation* anim = GetComponent<Animation>();
-    if (anim->mCurrentFileName == "boy_attack(45).fbx") return;
-    if (anim->mCurrentFileName == "boy_throw.fbx") return;
-    if (anim->mCurrentFileName == "boy_hit.fbx") return;
-    if (anim->mCurrentFileName == "boy_dying_fix.fbx") return;
-    ChangeState("boy_walk_fix.fbx");
+    if (anim->mCurrentAnim == BOY_ATTACK) return;
+    if (anim->mCurrentAnim == BOY_THROW) return;
+    if (anim->mCurrentAnim == BOY_HIT) return;
+    if (anim->mCurrentAnim == BOY_DYING) return;
+    ChangeState(BOY_WALK);
 }
 
 void PlayerObject::Run()
 {
     Animation* anim = GetComponent<Animation>();
-    if (anim->mCurrentFileName == "boy_attack(45).fbx") return;
-    if (anim->mCurrentFileName == "boy_throw.fbx") return;
-    if (anim->mCurrentFileName == "boy_hit.fbx") return;
-    if (anim->mCurrentFileName == "boy_dying_fix.fbx") return;
-    ChangeState("boy_run_fix.fbx");
+    if (anim->mCurrentAnim == BOY_ATTACK) return;
+    if (anim->mCurrentAnim == BOY_THROW) return;
+    if (anim->mCurrentAnim == BOY_HIT) return;
+    if (anim->mCurrentAnim == BOY_DYING) return;
+    ChangeState(BOY_RUN);
 }
 
 void PlayerObject::Jump()
@@ -404,8 +400,8 @@ void PlayerObject::Jump()
     Gravity* gravity = GetComponent<Gravity>();
     Animation* anim = GetComponent<Animation>();
     if (!gravity) return;
-    if (anim->mCurrentFileName == "boy_hit.fbx") return;
-    if (anim->mCurrentFileName == "boy_dying_fix.fbx") return;
+    if (anim->mCurrentAnim == BOY_HIT) return;
+    if (anim->mCurrentAnim == BOY_DYING) return;
     gravity->SetVerticalSpeed(40.0f);
     gravity->ResetElapseTime();
 }
@@ -413,43 +409,43 @@ void PlayerObject::Jump()
 void PlayerObject::Attack()
 {
     Animation* anim = GetComponent<Animation>();
-    if (anim->mCurrentFileName == "boy_throw.fbx") return;
-    if (anim->mCurrentFileName == "boy_hit.fbx") return;
-    if (anim->mCurrentFileName == "boy_dying_fix.fbx") return;
+    if (anim->mCurrentAnim == BOY_THROW) return;
+    if (anim->mCurrentAnim == BOY_HIT) return;
+    if (anim->mCurrentAnim == BOY_DYING) return;
     if (mAttackTime < 1.0) return;
-    ChangeState("boy_attack(45).fbx");
+    ChangeState(BOY_ATTACK);
 }
 
 void PlayerObject::Throw()
 {
     Animation* anim = GetComponent<Animation>();
-    if (anim->mCurrentFileName == "boy_attack(45).fbx") return;
-    if (anim->mCurrentFileName == "boy_hit.fbx") return;
-    if (anim->mCurrentFileName == "boy_dying_fix.fbx") return;
+    if (anim->mCurrentAnim == BOY_ATTACK) return;
+    if (anim->mCurrentAnim == BOY_HIT) return;
+    if (anim->mCurrentAnim == BOY_DYING) return;
     if (mAttackTime < 1.0) return;
     if (mRiceCake < 1) return;
-    ChangeState("boy_throw.fbx");
+    ChangeState(BOY_THROW);
 }
 
 void PlayerObject::TimeOut()
 {
     Animation* anim = GetComponent<Animation>();
-    if (anim->mCurrentFileName == "boy_attack(45).fbx" || anim->mCurrentFileName == "boy_throw.fbx")
+    if (anim->mCurrentAnim == BOY_ATTACK || anim->mCurrentAnim == BOY_THROW)
     {
         mIsFired = false;
         mAttackTime = 0.0f;
-        ChangeState("1P(boy-idle).fbx");
+        ChangeState(BOY_IDLE);
         return;
     }
 
-    if (anim->mCurrentFileName == "boy_hit.fbx")
+    if (anim->mCurrentAnim == BOY_HIT)
     {
         mIsHitted = false;
-        ChangeState("1P(boy-idle).fbx");
+        ChangeState(BOY_IDLE);
         return;
     }
 
-    if (anim->mCurrentFileName == "boy_dying_fix.fbx")
+    if (anim->mCurrentAnim == BOY_DYING)
     {
         m_scene->ResetLeatherCount();
         m_scene->SetStage(L"Base");
@@ -463,31 +459,30 @@ void PlayerObject::Fire()
     mIsFired = true;
 
     Animation* anim = GetComponent<Animation>();
-    if (anim->mCurrentFileName == "boy_attack(45).fbx" )
+    if (anim->mCurrentAnim == BOY_ATTACK )
     {
-        Object* obj = new PlayerAttackObject(m_scene, m_scene->AllocateId(), m_id);
-        obj->AddComponent(new Transform{ {0.0f, 8.0f, 8.0f} });
-        obj->AddComponent(new Collider{ {0.0f, 0.0f, 0.0f}, {6.0f, 8.0f, 6.0f} });
-        m_scene->AddObj(obj);
+        auto onHit = [](Object& target)
+            {
+                TigerObject* tiger = dynamic_cast<TigerObject*>(&target);
+                if (tiger)
+                {
+                    tiger->Hit();
+                    return;
+                }
+                TreeObject* tree = dynamic_cast<TreeObject*>(&target);
+                if (tree) tree->DropRiceCake();
+            };
+        m_scene->AddHitbox(m_id, { 0.0f, 8.0f, 8.0f }, { 6.0f, 8.0f, 6.0f }, 0.1f, onHit);
     }
 
-    if (anim->mCurrentFileName == "boy_throw.fbx")
+    if (anim->mCurrentAnim == BOY_THROW)
     {
         --mRiceCake;
 
         Transform* transform = GetComponent<Transform>();
         XMVECTOR pos = transform->GetPosition();
         XMVECTOR offset = XMVector3TransformNormal(XMVECTOR{ 4.0f, 15.0f, 8.0f }, transform->GetRotationM());
-        float scale = 0.03f;
-        RiceCakeProjectileObject* obj = new RiceCakeProjectileObject(m_scene, m_scene->AllocateId());
-        obj->SetDir(XMLoadFloat3(&mCameraLookDir));
-        obj->AddComponent(new Transform{ pos + offset});
-        obj->AddComponent(new AdjustTransform{ {-20.0f * scale, 22.0f * scale, 0.0f}, {0.0f, 0.0f, -90.0f}, {scale, scale, scale} });
-        obj->AddComponent(new Mesh{ "ricecake.fbx" });
-        obj->AddComponent(new Texture{ L"RiceCakePink", 1.0f, 0.4f });
-        obj->AddComponent(new Gravity);
-        obj->AddComponent(new Collider{ {0.0f, 30.0f * scale, 0.0f}, {25.0f * scale, 30.0f * scale, 25.0f * scale} });
-        m_scene->AddObj(obj);
+        m_scene->GetProjectileSystem().Spawn(m_id, pos + offset, XMLoadFloat3(&mCameraLookDir));
     }
 }
 
@@ -501,24 +496,24 @@ void PlayerObject::Hit()
         Dead();
         return;
     }
-    ChangeState("boy_hit.fbx");
+    ChangeState(BOY_HIT);
 }
 
 void PlayerObject::Dead()
 {
-    ChangeState("boy_dying_fix.fbx");
+    ChangeState(BOY_DYING);
 }
 
 void PlayerObject::CalcTime(float deltaTime)
 {
     Animation* anim = GetComponent<Animation>();
-    if (anim->mCurrentFileName == "boy_attack(45).fbx") 
+    if (anim->mCurrentAnim == BOY_ATTACK) 
     {
         mElapseTime += deltaTime;
         if (mElapseTime > 0.5f) Fire();
         if (mElapseTime > 1.0f) TimeOut();
     }
-    else if (anim->mCurrentFileName == "boy_throw.fbx")
+    else if (anim->mCurrentAnim == BOY_THROW)
     {
         mElapseTime += deltaTime;
         if (mElapseTime > 0.7f) Fire();
@@ -529,13 +524,13 @@ void PlayerObject::CalcTime(float deltaTime)
         mAttackTime += deltaTime;
     }
 
-    if (anim->mCurrentFileName == "boy_hit.fbx")
+    if (anim->mCurrentAnim == BOY_HIT)
     {
         mElapseTime += deltaTime;
         if (mElapseTime > 1.0f) TimeOut();
     }
 
-    if (anim->mCurrentFileName == "boy_dying_fix.fbx")
+    if (anim->mCurrentAnim == BOY_DYING)
     {
         mElapseTime += deltaTime;
         if (mElapseTime > 2.0f) TimeOut();
@@ -641,50 +636,52 @@ void CameraObject::ProcessInput()
 
 void TigerObject::OnUpdate(GameTimer& gTimer)
 {
-    CalcTime(gTimer.DeltaTime());
-    TigerBehavior(gTimer);
+    float deltaTime = gTimer.DeltaTime();
+    CalcTime(deltaTime);
+    if (mThinkState.think)
+    {
+        float thinkTime = mThinkState.accumTime;
+        mThinkState.accumTime = 0.0f;
+        Think(thinkTime);
+        // Far  Think ϴ ӿ и ðŭ   δ.
+        if (mThinkState.lod == eAILod::Far) Move(thinkTime);
+    }
+    if (mThinkState.lod != eAILod::Far) Move(deltaTime);
     Object::OnUpdate(gTimer);
 }
 
 void TigerObject::OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration)
 {
-    TigerAttackObject* ta = dynamic_cast<TigerAttackObject*>(&other);
-    if (ta) return;
-
-    PlayerAttackObject* pa = dynamic_cast<PlayerAttackObject*>(&other);
-    if (pa)
-    {
-        Hit();
-        return;
-    }
-
-    RiceCakeProjectileObject* rc = dynamic_cast<RiceCakeProjectileObject*>(&other);
-    if (rc)
-    {
-        HitByRiceCake();
-        return;
-    }
-
     Transform* transform = GetComponent<Transform>();
     XMVECTOR pos = transform->GetPosition();
     pos += -collisionNormal * penetration;
     transform->SetPosition(pos);
 }
 
+void TigerObject::OnProjectileHit()
+{
+    HitByRiceCake();
+}
+
 int TigerObject::GetLife()
 {
     return mLife;
 }
 
-void TigerObject::TigerBehavior(GameTimer& gTimer)
+AIThinkState& TigerObject::GetThinkState()
+{
+    return mThinkState;
+}
+
+void TigerObject::Think(float deltaTime)
 {
     Transform* transform = GetComponent<Transform>();
     Animation* anim = GetComponent<Animation>();
+    AIScheduler& scheduler = m_scene->GetAIScheduler();
+    if (!scheduler.HasPlayer()) return;
 
     XMVECTOR pos = transform->GetPosition();
-    PlayerObject* player = m_scene->GetObj<PlayerObject>();
-    Transform* playerTransform = player->GetComponent<Transform>();
-    XMVECTOR playerPos = playerTransform->GetPosition();
+    XMVECTOR playerPos = scheduler.GetPlayerPosition();
     float result = XMVectorGetX(XMVector3Length(playerPos - pos));
     XMVECTOR dir = XMVector3Normalize(playerPos - pos);
     float yaw = atan2f(XMVectorGetX(dir), XMVectorGetZ(dir)) * 180 / 3.141592f;
@@ -694,7 +691,7 @@ void TigerObject::TigerBehavior(GameTimer& gTimer)
         if (result < 17.0f) // Ž ȿ ÷̾ ְ, ſ ٸ....
         {
             Attack();
-            if (anim->mCurrentFileName == "0208_tiger_attack.fbx" && mElapseTime == 0)
+            if (anim->mCurrentAnim == TIGER_ATTACK && mElapseTime == 0)
             {
                 transform->SetRotation({ 0.0f, yaw, 0.0f });
             }
@@ -702,9 +699,16 @@ void TigerObject::TigerBehavior(GameTimer& gTimer)
         else // Ž ȿ ÷̾ , ſ  ʴٸ...
         {
             Run();
-            if (anim->mCurrentFileName == "0722_tiger_run.fbx") 
+            if (anim->mCurrentAnim == TIGER_RUN) 
             {
-                transform->SetPosition(pos + dir * mRunSpeed * gTimer.DeltaTime());
+                // 帧  ֹ ư ,  ÷̾   ޸.
+                XMVECTOR moveDir = dir;
+                if (m_scene->GetFlowField().GetDirection(pos, moveDir))
+                {
+                    yaw = atan2f(XMVectorGetX(moveDir), XMVectorGetZ(moveDir)) * 180 / 3.141592f;
+                }
+                XMStoreFloat3(&mMoveDir, moveDir);
+                mMoveSpeed = mRunSpeed;
                 transform->SetRotation({ 0.0f, yaw, 0.0f });
             }
         }
@@ -712,9 +716,9 @@ void TigerObject::TigerBehavior(GameTimer& gTimer)
     else // ÷̾ Ž  ۿ ִ.
     {
         Walk();
-        if (anim->mCurrentFileName == "0113_tiger_walk.fbx")
+        if (anim->mCurrentAnim == TIGER_WALK)
         {
-            mSearchTime += gTimer.DeltaTime();
+            mSearchTime += deltaTime;
             if (mSearchTime > 3.0f)
             {
                 mSearchTime = 0.0f;
@@ -723,65 +727,84 @@ void TigerObject::TigerBehavior(GameTimer& gTimer)
             }
 
             XMVECTOR dir = XMVector3TransformNormal({ 0.0f, 0.0f, 1.0f }, transform->GetRotationM());
-            dir = XMVector3Normalize(dir);
-            XMVECTOR pos = transform->GetPosition();
-            pos += dir * mWalkSpeed * gTimer.DeltaTime();
-            transform->SetPosition(pos);
+            XMStoreFloat3(&mMoveDir, XMVector3Normalize(dir));
+            mMoveSpeed = mWalkSpeed;
         }
     }
 }
 
+void TigerObject::SetSeparation(const XMFLOAT3& separation)
+{
+    mSeparation = separation;
+}
 
-void TigerObject::ChangeState(string fileName)
+void TigerObject::Move(float deltaTime)
+{
+    // и     ؼ ȣ̳ ġ ʰ Ѵ.
+    XMVECTOR velocity = XMLoadFloat3(&mSeparation) * mSeparationSpeed;
+    if (mMoveSpeed != 0.0f) velocity += XMLoadFloat3(&mMoveDir) * mMoveSpeed;
+    if (XMVector3Equal(velocity, XMVectorZero())) return;
+
+    Transform* transform = GetComponent<Transform>();
+    XMVECTOR pos = transform->GetPosition();
+    pos += velocity * deltaTime;
+    transform->SetPosition(pos);
+}
+
+void TigerObject::ChangeState(int state)
 {
     Animation* anim = GetComponent<Animation>();
-    if (anim->ResetAnim(fileName, 0.0f)) mElapseTime = 0.0f;
+    if (anim->ResetAnim(state, 0.0f))
+    {
+        mElapseTime = 0.0f;
+        mMoveSpeed = 0.0f; // ̵ run/walk  Think  ٽ 
+    }
 }
 
 void TigerObject::Walk()
 {
     Animation* anim = GetComponent<Animation>();
-    if (anim->mCurrentFileName == "0208_tiger_attack.fbx") return;
-    if (anim->mCurrentFileName == "0208_tiger_hit.fbx") return;
-    if (anim->mCurrentFileName == "0208_tiger_dying.fbx") return;
-    ChangeState("0113_tiger_walk.fbx");
+    if (anim->mCurrentAnim == TIGER_ATTACK) return;
+    if (anim->mCurrentAnim == TIGER_HIT) return;
+    if (anim->mCurrentAnim == TIGER_DYING) return;
+    ChangeState(TIGER_WALK);
 }
 
 void TigerObject::Run()
 {
     Animation* anim = GetComponent<Animation>();
-    if (anim->mCurrentFileName == "0208_tiger_attack.fbx") return;
-    if (anim->mCurrentFileName == "0208_tiger_hit.fbx") return;
-    if (anim->mCurrentFileName == "0208_tiger_dying.fbx") return;
+    if (anim->mCurrentAnim == TIGER_ATTACK) return;
+    if (anim->mCurrentAnim == TIGER_HIT) return;
+    if (anim->mCurrentAnim == TIGER_DYING) return;
     if (mAttackTime < 2.0f) return;
-    ChangeState("0722_tiger_run.fbx");
+    ChangeState(TIGER_RUN);
 }
 
 void TigerObject::Attack()
 {
     Animation* anim = GetComponent<Animation>();
-    if (anim->mCurrentFileName == "0208_tiger_hit.fbx") return;
-    if (anim->mCurrentFileName == "0208_tiger_dying.fbx") return;
+    if (anim->mCurrentAnim == TIGER_HIT) return;
+    if (anim->mCurrentAnim == TIGER_DYING) return;
     if (mAttackTime < 2.0f) return;
-    ChangeState("0208_tiger_attack.fbx");
+    ChangeState(TIGER_ATTACK);
 }
 void TigerObject::TimeOut()
 {
     Animation* anim = GetComponent<Animation>();
-    if (anim->mCurrentFileName == "0208_tiger_attack.fbx") 
+    if (anim->mCurrentAnim == TIGER_ATTACK) 
     {
         mIsFired = false;
         mAttackTime = 0.0f;
-        ChangeState("0722_tiger_idle2.fbx");
+        ChangeState(TIGER_IDLE);
     }
 
-    if (anim->mCurrentFileName == "0208_tiger_hit.fbx")
+    if (anim->mCurrentAnim == TIGER_HIT)
     {
         mIsHitted = false;
-        ChangeState("0722_tiger_idle2.fbx");
+        ChangeState(TIGER_IDLE);
     }
 
-    if (anim->mCurrentFileName == "0208_tiger_dying.fbx")
+    if (anim->mCurrentAnim == TIGER_DYING)
     {
         CreateLeather();
         Delete();
@@ -793,10 +816,12 @@ void TigerObject::Fire()
     if (mIsFired) return;
     mIsFired = true;
 
-    Object* obj = new TigerAttackObject(m_scene, m_scene->AllocateId(), m_id);
-    obj->AddComponent(new Transform{ {0.0f, 6.0f, 18.0f} });
-    obj->AddComponent(new Collider{ {0.0f, 0.0f, 0.0f}, {4.0f, 6.0f, 8.0f} });
-    m_scene->AddObj(obj);
+    auto onHit = [](Object& target)
+        {
+            PlayerObject* player = dynamic_cast<PlayerObject*>(&target);
+            if (player) player->Hit(); // ȣ ݿ ...
+        };
+    m_scene->AddHitbox(m_id, { 0.0f, 6.0f, 18.0f }, { 4.0f, 6.0f, 8.0f }, 0.1f, onHit);
 }
 
 void TigerObject::Hit()
@@ -809,7 +834,7 @@ void TigerObject::Hit()
         Dead();
         return;
     }
-    ChangeState("0208_tiger_hit.fbx");
+    ChangeState(TIGER_HIT);
 }
 
 void TigerObject::HitByRiceCake()
@@ -822,19 +847,19 @@ void TigerObject::HitByRiceCake()
         Dead();
         return;
     }
-    ChangeState("0208_tiger_hit.fbx");
+    ChangeState(TIGER_HIT);
 }
 
 void TigerObject::Dead()
 {
-    ChangeState("0208_tiger_dying.fbx");
+    ChangeState(TIGER_DYING);
 }
 
 void TigerObject::CalcTime(float deltaTime) 
 {
     Animation* anim = GetComponent<Animation>();
     
-    if (anim->mCurrentFileName == "0208_tiger_attack.fbx")
+    if (anim->mCurrentAnim == TIGER_ATTACK)
     {
         mElapseTime += deltaTime;
         if (mElapseTime >= 0.4f) Fire();
@@ -845,13 +870,13 @@ void TigerObject::CalcTime(float deltaTime)
         mAttackTime += deltaTime;
     }
 
-    if (anim->mCurrentFileName == "0208_tiger_hit.fbx")
+    if (anim->mCurrentAnim == TIGER_HIT)
     {
         mElapseTime += deltaTime;
         if (mElapseTime > 0.8f) TimeOut();
     }
 
-    if (anim->mCurrentFileName == "0208_tiger_dying.fbx")
+    if (anim->mCurrentAnim == TIGER_DYING)
     {
         mElapseTime += deltaTime;
         if (mElapseTime > 1.9f) TimeOut();
@@ -871,24 +896,11 @@ void TigerObject::CreateLeather()
     objectPtr->AddComponent(new Mesh{ "tiger_leather.fbx" });
     objectPtr->AddComponent(new Texture{ L"tigerLeather", 1.0f, 0.6f });
     objectPtr->AddComponent(new Collider{ {0.0f, 100.0f * scale, 0.0f}, {90.0f * scale, 100.0f * scale, 20.0f * scale} });
+    objectPtr->GetComponent<Collider>()->SetTrigger(true);
     objectPtr->AddComponent(new Gravity);
     m_scene->AddObj(objectPtr);
 }
 
-void TigerAttackObject::OnUpdate(GameTimer& gTimer)
-{
-    mElapseTime += gTimer.DeltaTime();
-    if (mElapseTime >= 0.1) Delete();
-    Object::OnUpdate(gTimer);
-}
-
-void PlayerAttackObject::OnUpdate(GameTimer& gTimer)
-{
-    mElapseTime += gTimer.DeltaTime();
-    if (mElapseTime >= 0.1) Delete();
-    Object::OnUpdate(gTimer);
-}
-
 void TigerMockup::OnUpdate(GameTimer& gTimer)
 {
     static float randYaw = uid(dre);
@@ -910,18 +922,13 @@ void TigerMockup::OnUpdate(GameTimer& gTimer)
     Object::OnUpdate(gTimer);
 }
 
-void TigerMockup::OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration)
+void TigerMockup::OnTrigger(Object& other)
 {
     PlayerObject* player = dynamic_cast<PlayerObject*>(&other);
     if (player)
     {
         m_scene->SetStage(L"Hunting");
     }
-
-    Transform* transform = GetComponent<Transform>();
-    XMVECTOR pos = transform->GetPosition();
-    pos += -collisionNormal * penetration;
-    transform->SetPosition(pos);
 }
 
 void TigerLeather::OnUpdate(GameTimer& gTimer)
@@ -936,12 +943,18 @@ void TigerLeather::OnUpdate(GameTimer& gTimer)
     Object::OnUpdate(gTimer);
 }
 
-void TigerLeather::OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration)
+void TigerLeather::OnTrigger(Object& other)
 {
     PlayerObject* player = dynamic_cast<PlayerObject*>(&other);
     if (player) Delete();
 }
 
+void TigerLeather::LateUpdate(GameTimer& gTimer)
+{
+    LandOnGround();
+    Object::LateUpdate(gTimer);
+}
+
 void RotPlatformObject::OnUpdate(GameTimer& gTimer)
 {
     Transform* transform = GetComponent<Transform>();
@@ -978,7 +991,7 @@ void AxeObject::OnUpdate(GameTimer& gTimer)
     }
 }
 
-void AxeObject::OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration)
+void AxeObject::OnTrigger(Object& other)
 {
     PlayerObject* player = dynamic_cast<PlayerObject*>(&other);
     if (player)
@@ -991,61 +1004,43 @@ void AxeObject::OnProcessCollision(Object& other, XMVECTOR collisionNormal, floa
 
         m_scene->SetStage(L"End");
     }
-    Object::OnProcessCollision(other, collisionNormal, penetration);
 }
 
-void RiceCakeObject::OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration)
+void AxeObject::LateUpdate(GameTimer& gTimer)
 {
-    PlayerAttackObject* pa = dynamic_cast<PlayerAttackObject*>(&other);
-    if (pa) return;
-    TigerAttackObject* ta = dynamic_cast<TigerAttackObject*>(&other);
-    if (ta) return;
-    RiceCakeObject* riceCake = dynamic_cast<RiceCakeObject*>(&other);
-    if (riceCake)
-    {
-        Transform* transform = GetComponent<Transform>();
-        XMVECTOR pos = transform->GetPosition();
-        pos -= collisionNormal * penetration;
-        transform->SetPosition(pos);
-        return;
-    }
-    Delete();
-    Object::OnProcessCollision(other, collisionNormal, penetration);
+    LandOnGround();
+    Object::LateUpdate(gTimer);
 }
 
-void TreeObject::OnUpdate(GameTimer& gTimer)
+void RiceCakeObject::OnTrigger(Object& other)
 {
-    mCollisionByPlayerAttack = mCollisionByPlayerAttack >> 4;
-    Object::OnUpdate(gTimer);
+    PlayerObject* player = dynamic_cast<PlayerObject*>(&other);
+    if (player) Delete();
 }
 
-void TreeObject::OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration)
+void RiceCakeObject::LateUpdate(GameTimer& gTimer)
 {
-    PlayerAttackObject* pa = dynamic_cast<PlayerAttackObject*>(&other);
-    if (pa) { mCollisionByPlayerAttack |= (unsigned char)0x80; }
-
-    Object::OnProcessCollision(other, collisionNormal, penetration);
+    LandOnGround();
+    Object::LateUpdate(gTimer);
 }
 
-void TreeObject::LateUpdate(GameTimer& gTimer)
+void TreeObject::DropRiceCake()
 {
-    if (mCollisionByPlayerAttack == (unsigned char)0x80)
-    {
-        Transform* transform = GetComponent<Transform>();
-        XMVECTOR pos = transform->GetPosition();
-        float yaw = uid(dre);
-        XMVECTOR offset = XMVector3TransformNormal(XMVECTOR{ 0.0f, 50.0f, 20.0f }, XMMatrixRotationY(yaw));
-        float scale = 0.03f;
-        Object* obj = new RiceCakeObject(m_scene, m_scene->AllocateId());
-        obj->AddComponent(new Transform{ pos + offset });
-        obj->AddComponent(new AdjustTransform{ {-20.0f * scale, 22.0f * scale, 0.0f}, {0.0f, 0.0f, -90.0f}, {scale, scale, scale} });
-        obj->AddComponent(new Mesh{ "ricecake.fbx" });
-        obj->AddComponent(new Texture{ L"RiceCakePink", 1.0f, 0.4f });
-        obj->AddComponent(new Gravity);
-        obj->AddComponent(new Collider{ {0.0f, 30.0f * scale, 0.0f}, {25.0f * scale, 30.0f * scale, 25.0f * scale} });
-        m_scene->AddObj(obj);
-    }
-    Object::LateUpdate(gTimer);
+    // ÷̾  Ʈڽ ϳ   Ҹ.
+    Transform* transform = GetComponent<Transform>();
+    XMVECTOR pos = transform->GetPosition();
+    float yaw = uid(dre);
+    XMVECTOR offset = XMVector3TransformNormal(XMVECTOR{ 0.0f, 50.0f, 20.0f }, XMMatrixRotationY(yaw));
+    float scale = 0.03f;
+    Object* obj = new RiceCakeObject(m_scene, m_scene->AllocateId());
+    obj->AddComponent(new Transform{ pos + offset });
+    obj->AddComponent(new AdjustTransform{ {-20.0f * scale, 22.0f * scale, 0.0f}, {0.0f, 0.0f, -90.0f}, {scale, scale, scale} });
+    obj->AddComponent(new Mesh{ "ricecake.fbx" });
+    obj->AddComponent(new Texture{ L"RiceCakePink", 1.0f, 0.4f });
+    obj->AddComponent(new Gravity);
+    obj->AddComponent(new Collider{ {0.0f, 30.0f * scale, 0.0f}, {25.0f * scale, 30.0f * scale, 25.0f * scale} });
+    obj->GetComponent<Collider>()->SetTrigger(true);
+    m_scene->AddObj(obj);
 }
 
 void GoToBaseObject::OnUpdate(GameTimer& gTimer)
@@ -1059,24 +1054,22 @@ void GoToBaseObject::OnUpdate(GameTimer& gTimer)
     Object::OnUpdate(gTimer);
 }
 
-void GoToBaseObject::OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration)
+void GoToBaseObject::OnTrigger(Object& other)
 {
     PlayerObject* player = dynamic_cast<PlayerObject*>(&other);
     if (player && m_scene->HasEnoughLeather())
     {
         m_scene->SetStage(L"Base");
     }
-    Object::OnProcessCollision(other, collisionNormal, penetration);
 }
 
-void GodObject::OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration)
+void GodObject::OnTrigger(Object& other)
 {
     PlayerObject* player = dynamic_cast<PlayerObject*>(&other);
     if (player && m_scene->HasEnoughLeather())
     {
         m_scene->SetStage(L"God");
     }
-    Object::OnProcessCollision(other, collisionNormal, penetration);
 }
 
 void TitleQuadObject::OnUpdate(GameTimer& gTimer)
@@ -1088,7 +1081,7 @@ void TitleQuadObject::OnUpdate(GameTimer& gTimer)
     }
 }
 
-void SisterObject::OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration)
+void SisterObject::OnTrigger(Object& other)
 {
     PlayerObject* player = dynamic_cast<PlayerObject*>(&other);
     if (player && !mIsQuadAble)
@@ -1102,8 +1095,6 @@ void SisterObject::OnProcessCollision(Object& other, XMVECTOR collisionNormal, f
         obj->AddComponent(new Texture{ L"Quest", -1.0f, 0.4f });
         m_scene->AddObj(obj);
     }
-
-    Object::OnProcessCollision(other, collisionNormal, penetration);
 }
 
 void SisterQuadObject::OnUpdate(GameTimer& gTimer)
@@ -1252,37 +1243,6 @@ void GrassGroupObject::RandomRot()
     transform->SetRotation({ 0.0f, yaw, 0.0f });
 }
 
-void RiceCakeProjectileObject::OnUpdate(GameTimer& gTimer)
-{
-    Transform* transform = GetComponent<Transform>();
-    XMVECTOR pos = transform->GetPosition();
-    
-    char outstatus = m_scene->ClampToBounds(pos, { 0.0f, 0.0f, 0.0f });
-    if (outstatus)
-    {
-        Delete();
-        return;
-    }
-
-    pos += XMLoadFloat3(&mDir) * mSpeed * gTimer.DeltaTime();
-    transform->SetPosition(pos);
-
-    Object::OnUpdate(gTimer);
-
-}
-
-void RiceCakeProjectileObject::OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration)
-{
-    TigerAttackObject* ta = dynamic_cast<TigerAttackObject*>(&other);
-    if (ta) return;
-    Delete();
-}
-
-void RiceCakeProjectileObject::SetDir(XMVECTOR dir)
-{
-    XMStoreFloat3(&mDir, dir);
-}
-
 void CrossHairQuadObject::OnUpdate(GameTimer& gTimer)
 {
     BYTE* keyState = m_scene->GetFramework()->GetKeyState();
@@ -1361,13 +1321,9 @@ void PuzzleCellObject::OnUpdate(GameTimer& gTimer)
     Object::OnUpdate(gTimer);
 }
 
-void PuzzleCellObject::OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration)
+void PuzzleCellObject::OnProjectileHit()
 {
-    RiceCakeProjectileObject* riceCake = dynamic_cast<RiceCakeProjectileObject*>(&other);
-    if (riceCake)
-    {
-        ++mStatus;
-    }
+    ++mStatus;
 }
 
 int PuzzleCellObject::GetStatus()
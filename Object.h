@@ -1,6 +1,7 @@
 #pragma once
 #include "stdafx.h"
 #include "Component.h"
+#include "AIScheduler.h"
 
 class GameTimer;
 class Scene;
@@ -12,9 +13,11 @@ public:
 	Object(Scene* scene, uint32_t id, uint32_t parentId = -1);
 	virtual void OnUpdate(GameTimer& gTimer);
 	virtual void OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration);
+	virtual void OnTrigger(Object& other);
+	virtual void OnProjectileHit();
 	virtual void LateUpdate(GameTimer& gTimer);
 	virtual void OnRender(ID3D12Device* device, ID3D12GraphicsCommandList * commandList);
-	void ProcessAnimation(GameTimer& gTimer);
+	void SetPalette(UINT offset, int skinningMode);
 	void BuildConstantBuffer(ID3D12Device* device);
 	void AddComponent(Component* component);
 	Scene* GetScene() { return m_scene; }
@@ -34,6 +37,8 @@ public:
 	}
 
 protected:
+	void LandOnGround();
+
 	Scene* m_scene = nullptr;
 	uint32_t m_id = -1;
 	uint32_t m_parent_id = -1;
@@ -51,11 +56,13 @@ public:
 	using Object::Object;
 	void OnUpdate(GameTimer& gTimer) override;
 	void OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration) override;
+	void OnTrigger(Object& other) override;
 	int GetRiceCakeCount();
 	int GetLifeCount();
+	void Hit();
 private:
 	void ProcessInput(const GameTimer& gTimer);
-	void ChangeState(string fileName);
+	void ChangeState(int state);
 	void MoveAndRotate(float deltaTime);
 	void Idle();
 	void Walk();
@@ -64,7 +71,6 @@ private:
 	void Attack();
 	void Throw();
 	void Fire();
-	void Hit();
 	void Dead();
 	void TimeOut();
 	void CalcTime(float deltaTime);
@@ -115,12 +121,7 @@ class TreeObject : public Object
 {
 public:
 	using Object::Object;
-	void OnUpdate(GameTimer& gTimer) override;
-	void OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration) override;
-	void LateUpdate(GameTimer& gTimer) override;
-
-private:
-	unsigned char mCollisionByPlayerAttack = (unsigned char)0x00;
+	void DropRiceCake();
 };
 
 class TigerObject : public Object
@@ -129,16 +130,20 @@ public:
 	using Object::Object;
 	void OnUpdate(GameTimer& gTimer) override;
 	void OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration) override;
+	void OnProjectileHit() override;
 	int GetLife();
+	AIThinkState& GetThinkState();
+	void SetSeparation(const XMFLOAT3& separation);
+	void Hit();
 private:
-	void TigerBehavior(GameTimer& gTimer);
-	void ChangeState(string fileName);
+	void Think(float deltaTime);
+	void Move(float deltaTime);
+	void ChangeState(int state);
 	void Walk();
 	void Run();
 	void Attack();
 	void TimeOut();
 	void Fire();
-	void Hit();
 	void HitByRiceCake();
 	void Dead();
 	void CalcTime(float deltaTime);
@@ -151,24 +156,12 @@ private:
 	bool mIsFired = false;
 	bool mIsHitted = false;
 	int mLife = 3;
-};
-
-class TigerAttackObject : public Object
-{
-public:
-	using Object::Object;
-	void OnUpdate(GameTimer& gTimer) override;
-private:
-	float mElapseTime = 0.0f;
-};
-
-class PlayerAttackObject : public Object
-{
-public:
-	using Object::Object;
-	void OnUpdate(GameTimer& gTimer) override;
-private:
-	float mElapseTime = 0.0f;
+	// Think   ̵. Think  ǳʶٴ ӿ Move    δ.
+	XMFLOAT3 mMoveDir{};
+	float mMoveSpeed = 0.0f;
+	XMFLOAT3 mSeparation{};
+	float mSeparationSpeed = 30.0f;
+	AIThinkState mThinkState{};
 };
 
 class TigerMockup : public Object
@@ -176,7 +169,7 @@ class TigerMockup : public Object
 public:
 	using Object::Object;
 	void OnUpdate(GameTimer& gTimer) override;
-	void OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration) override;
+	void OnTrigger(Object& other) override;
 private:
 	float mSearchTime = 0.0f;
 	float mWalkSpeed = 20.0f;
@@ -187,7 +180,8 @@ class TigerLeather : public Object
 public:
 	Object::Object;
 	void OnUpdate(GameTimer& gTimer) override;
-	void OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration) override;
+	void OnTrigger(Object& other) override;
+	void LateUpdate(GameTimer& gTimer) override;
 private:
 };
 
@@ -195,7 +189,7 @@ class SisterObject : public Object
 {
 public:
 	Object::Object;
-	void OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration) override;
+	void OnTrigger(Object& other) override;
 
 private:
 	bool mIsQuadAble = false;
@@ -205,7 +199,7 @@ class GodObject : public Object
 {
 public:
 	Object::Object;
-	void OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration) override;
+	void OnTrigger(Object& other) override;
 private:
 };
 
@@ -244,7 +238,8 @@ class AxeObject : public Object
 public:
 	Object::Object;
 	void OnUpdate(GameTimer& gTimer) override;
-	void OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration) override;
+	void OnTrigger(Object& other) override;
+	void LateUpdate(GameTimer& gTimer) override;
 private:
 };
 
@@ -252,20 +247,8 @@ class RiceCakeObject : public Object
 {
 public:
 	Object::Object;
-	void OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration) override;
-};
-
-class RiceCakeProjectileObject : public Object
-{
-public:
-	Object::Object;
-	void OnUpdate(GameTimer& gTimer) override;
-	void OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration) override;
-	void SetDir(XMVECTOR dir);
-	
-private:
-	XMFLOAT3 mDir{};
-	float mSpeed = 200.0f;
+	void OnTrigger(Object& other) override;
+	void LateUpdate(GameTimer& gTimer) override;
 };
 
 class GoToBaseObject : public Object
@@ -273,7 +256,7 @@ class GoToBaseObject : public Object
 public:
 	Object::Object;
 	void OnUpdate(GameTimer& gTimer) override;
-	void OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration) override;
+	void OnTrigger(Object& other) override;
 
 private:
 	float mElapseTime = 0.0f;
@@ -337,7 +320,7 @@ class PuzzleCellObject : public Object
 public:
 	Object::Object;
 	void OnUpdate(GameTimer& gTimer) override;
-	void OnProcessCollision(Object& other, XMVECTOR collisionNormal, float penetration) override;
+	void OnProjectileHit() override;
 	int GetStatus();
 	void SetStatus(int value);
 private:
@@ -0,0 +1,94 @@
+#include "PoseCache.h"
+
+PoseCache::PoseCache()
+{
+	mPalettes.resize(MAX_POSE_CACHE * PALETTE_ENTRY_SIZE);
+}
+
+void PoseCache::BeginFrame()
+{
+	// ĭ    ȣ ٸ  ĭ .
+	++mFrame;
+	mEntryCount = 0;
+}
+
+XMFLOAT4* PoseCache::Acquire(const SkinnedData& skeleton, ClipHandle clip, float& timePos, bool& isNew)
+{
+	uint32_t timeKey = 0;
+	if (mTimeStep > 0.0f)
+	{
+		int step = (int)floorf(timePos / mTimeStep + 0.5f);
+		timePos = step * mTimeStep;
+		timeKey = (uint32_t)step;
+	}
+	else
+	{
+		memcpy(&timeKey, &timePos, sizeof(uint32_t));
+	}
+
+	isNew = false;
+	++mLookupCount;
+	uint32_t hash = Hash(&skeleton, clip, timeKey);
+	for (uint32_t probe = 0; probe < POSE_CACHE_TABLE_SIZE; ++probe)
+	{
+		Slot& slot = mSlots[(hash + probe) & (POSE_CACHE_TABLE_SIZE - 1)];
+		if (slot.frame != mFrame)
+		{
+			if (mEntryCount > MAX_POSE_CACHE - 1) break; //   ĳ  
+			slot.frame = mFrame;
+			slot.skeleton = &skeleton;
+			slot.clip = clip;
+			slot.timeKey = timeKey;
+			slot.entry = mEntryCount++;
+			isNew = true;
+			return &mPalettes[slot.entry * PALETTE_ENTRY_SIZE];
+		}
+		if (slot.skeleton == &skeleton && slot.clip == clip && slot.timeKey == timeKey)
+		{
+			++mHitCount;
+			return &mPalettes[slot.entry * PALETTE_ENTRY_SIZE];
+		}
+	}
+	return nullptr;
+}
+
+void PoseCache::SetTimeStep(float timeStep)
+{
+	mTimeStep = timeStep;
+}
+
+float PoseCache::GetTimeStep()
+{
+	return mTimeStep;
+}
+
+float PoseCache::GetHitRate()
+{
+	if (mLookupCount == 0) return 0.0f;
+	return (float)mHitCount / (float)mLookupCount;
+}
+
+uint64_t PoseCache::GetHitCount()
+{
+	return mHitCount;
+}
+
+uint64_t PoseCache::GetLookupCount()
+{
+	return mLookupCount;
+}
+
+void PoseCache::ResetCounter()
+{
+	mHitCount = 0;
+	mLookupCount = 0;
+}
+
+uint32_t PoseCache::Hash(const SkinnedData* skeleton, ClipHandle clip, uint32_t timeKey)
+{
+	uint32_t h = (uint32_t)(reinterpret_cast<uintptr_t>(skeleton) >> 4);
+	h ^= (uint32_t)clip * 0x9e3779b1u;
+	h ^= timeKey * 0x85ebca6bu;
+	h ^= h >> 15;
+	return h;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "stdafx.h"
+#include "Info.h"
+#include "SkinnedData.h"
+#define MAX_POSE_CACHE 64
+#define POSE_CACHE_TABLE_SIZE 128
+#define PALETTE_ENTRY_SIZE (MAX_BONE * 3)	// float4 , SkinningMode   ū 
+
+//  ӿ  (̷, Ŭ, ð)  ϴ νϽ ȷƮ  .
+// ð  ָ   ð ݿøؼ       Ѵ.
+class PoseCache
+{
+public:
+	PoseCache();
+	void BeginFrame();
+	// (̷, Ŭ, ð)  ȷƮ ڸ ش. isNew ̸ ȣ  timePos  ؼ ä Ѵ.
+	// ĳð   nullptr. timePos  ð ݿ  ݿøȴ.
+	//  忡 θ, ä  ٸ 忡 ص ȴ.
+	// ڸ MAX_BONE  3x4   ũ.
+	XMFLOAT4* Acquire(const SkinnedData& skeleton, ClipHandle clip, float& timePos, bool& isNew);
+	void SetTimeStep(float timeStep);	// 0 ̸ ð Ȯ   
+	float GetTimeStep();
+	float GetHitRate();
+	uint64_t GetHitCount();
+	uint64_t GetLookupCount();
+	void ResetCounter();
+private:
+	uint32_t Hash(const SkinnedData* skeleton, ClipHandle clip, uint32_t timeKey);
+private:
+	struct Slot
+	{
+		uint32_t frame = 0;
+		const SkinnedData* skeleton = nullptr;
+		ClipHandle clip = -1;
+		uint32_t timeKey = 0;
+		uint32_t entry = 0;
+	};
+
+	uint32_t mFrame = 0;
+	uint32_t mEntryCount = 0;
+	float mTimeStep = 0.0f;
+	uint64_t mHitCount = 0;
+	uint64_t mLookupCount = 0;
+
+	Slot mSlots[POSE_CACHE_TABLE_SIZE]{};
+	vector<XMFLOAT4> mPalettes;	// MAX_POSE_CACHE * PALETTE_ENTRY_SIZE
+};
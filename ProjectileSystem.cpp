@@ -0,0 +1,234 @@
+#include "ProjectileSystem.h"
+#include "Scene.h"
+#include "Object.h"
+#include "DXSampleHelper.h"
+
+ProjectileSystem::ProjectileSystem(Scene* parent, ID3D12Device* device) :
+	mParent{ parent }
+{
+	//  RiceCakeProjectileObject  AdjustTransform   
+	float scale = 0.03f;
+	AdjustTransform adjust{ {-20.0f * scale, 22.0f * scale, 0.0f}, {0.0f, 0.0f, -90.0f}, {scale, scale, scale} };
+	XMStoreFloat4x4(&mAdjustT, XMMatrixTranspose(adjust.GetTransformM()));
+
+	BuildResource(device);
+}
+
+ProjectileSystem::~ProjectileSystem()
+{
+	if (mInstanceBuffer) mInstanceBuffer->Unmap(0, nullptr);
+	if (mConstantBuffer) mConstantBuffer->Unmap(0, nullptr);
+}
+
+void ProjectileSystem::Spawn(uint32_t ownerId, XMVECTOR pos, XMVECTOR dir)
+{
+	if (mCount > MAX_PROJECTILE - 1) throw; // 
+
+	XMFLOAT3 p{};
+	XMFLOAT3 v{};
+	XMStoreFloat3(&p, pos);
+	XMStoreFloat3(&v, XMVector3Normalize(dir) * mSpeed);
+
+	UINT i = mCount++;
+	mPosX[i] = mPrevX[i] = p.x;
+	mPosY[i] = mPrevY[i] = p.y;
+	mPosZ[i] = mPrevZ[i] = p.z;
+	mVelX[i] = v.x;
+	mVelY[i] = v.y;
+	mVelZ[i] = v.z;
+	mFallSpeed[i] = 0.0f;
+	mFallTime[i] = 0.0f;
+	mLifeTime[i] = 0.0f;
+	mOwnerId[i] = ownerId;
+	mDead[i] = false;
+}
+
+void ProjectileSystem::Clear()
+{
+	mCount = 0;
+}
+
+void ProjectileSystem::Update(float deltaTime)
+{
+	// . Gravity::ProcessGravity   Ͻ .
+	for (UINT i = 0; i < mCount; ++i)
+	{
+		mPrevX[i] = mPosX[i];
+		mPrevY[i] = mPosY[i];
+		mPrevZ[i] = mPosZ[i];
+
+		float gForce = mFallTime[i] == 0.0f ? 0.0f : 60.0f + 80.0f * mFallTime[i] * mFallTime[i];
+		mFallSpeed[i] -= gForce * deltaTime;
+		mFallTime[i] += deltaTime;
+		mLifeTime[i] += deltaTime;
+
+		mPosX[i] += mVelX[i] * deltaTime;
+		mPosY[i] += (mVelY[i] + mFallSpeed[i]) * deltaTime;
+		mPosZ[i] += mVelZ[i] * deltaTime;
+	}
+
+	// (  ) ų  ϸ .
+	for (UINT i = 0; i < mCount; ++i)
+	{
+		if (mLifeTime[i] > mMaxLifeTime)
+		{
+			mDead[i] = true;
+			continue;
+		}
+		XMVECTOR pos = XMVectorSet(mPosX[i], mPosY[i], mPosZ[i], 1.0f);
+		if (mParent->ClampToBounds(pos, { 0.0f, 0.0f, 0.0f })) mDead[i] = true;
+	}
+	RemoveDead();
+}
+
+void ProjectileSystem::ProcessCollision(vector<Object*>& objects)
+{
+	if (mCount == 0) return;
+
+	// ̹ ӿ    ŭ Ǯ OBB   ˻Ѵ.
+	for (Object* obj : objects)
+	{
+		if (!obj->GetValid()) continue;
+		Collider* collider = obj->GetComponent<Collider>();
+		if (!collider || !collider->IsActive() || collider->IsTrigger()) continue;
+
+		BoundingOrientedBox obb = collider->GetOBB();
+		obb.Extents.x += mRadius;
+		obb.Extents.y += mRadius;
+		obb.Extents.z += mRadius;
+
+		BoundingBox& aabb = collider->GetAABB();
+		float minX = aabb.Center.x - aabb.Extents.x - mRadius;
+		float maxX = aabb.Center.x + aabb.Extents.x + mRadius;
+		float minY = aabb.Center.y - aabb.Extents.y - mRadius;
+		float maxY = aabb.Center.y + aabb.Extents.y + mRadius;
+		float minZ = aabb.Center.z - aabb.Extents.z - mRadius;
+		float maxZ = aabb.Center.z + aabb.Extents.z + mRadius;
+
+		uint32_t id = obj->GetId();
+		for (UINT i = 0; i < mCount; ++i)
+		{
+			if (mDead[i] || mOwnerId[i] == id) continue;
+			if (max(mPrevX[i], mPosX[i]) < minX || min(mPrevX[i], mPosX[i]) > maxX) continue;
+			if (max(mPrevY[i], mPosY[i]) < minY || min(mPrevY[i], mPosY[i]) > maxY) continue;
+			if (max(mPrevZ[i], mPosZ[i]) < minZ || min(mPrevZ[i], mPosZ[i]) > maxZ) continue;
+
+			XMVECTOR from = XMVectorSet(mPrevX[i], mPrevY[i], mPrevZ[i], 1.0f);
+			XMVECTOR to = XMVectorSet(mPosX[i], mPosY[i], mPosZ[i], 1.0f);
+			XMVECTOR delta = to - from;
+			float length = XMVectorGetX(XMVector3Length(delta));
+
+			bool hit = obb.Contains(from) != DISJOINT;
+			if (!hit && length > 0.0f)
+			{
+				float dist = 0.0f;
+				hit = obb.Intersects(from, delta / length, dist) && dist <= length;
+			}
+			if (!hit) continue;
+
+			mDead[i] = true;
+			obj->OnProjectileHit();
+		}
+	}
+	RemoveDead();
+}
+
+void ProjectileSystem::UploadInstances()
+{
+	// ޽  Ŀ ̵ ϸ ǹǷ ġ  4 ٲ۴.
+	for (UINT i = 0; i < mCount; ++i)
+	{
+		XMFLOAT4X4 world = mAdjustT;
+		world._14 += mPosX[i];
+		world._24 += mPosY[i];
+		world._34 += mPosZ[i];
+		mMappedInstance[i] = world;
+	}
+}
+
+void ProjectileSystem::Render(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, ePass pass)
+{
+	if (mCount == 0) return;
+
+	auto& PSOs = mParent->GetPSOs();
+	commandList->SetPipelineState(PSOs.at(pass == ePass::Shadow ? "PSO_ShadowInstanced" : "PSO_OpaqueInstanced").Get());
+
+	int textureIndex = mParent->GetTextureIndex(L"RiceCakePink");
+	CD3DX12_GPU_DESCRIPTOR_HANDLE hDescriptor(mParent->GetDescriptorHeap()->GetGPUDescriptorHandleForHeapStart());
+	hDescriptor.Offset(1 + textureIndex, device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV));
+	commandList->SetGraphicsRootDescriptorTable(1, hDescriptor);
+	commandList->SetGraphicsRootConstantBufferView(2, mConstantBuffer->GetGPUVirtualAddress());
+	commandList->SetGraphicsRootShaderResourceView(4, mInstanceBuffer->GetGPUVirtualAddress());
+
+	SubMeshData& data = mParent->GetResourceManager().GetSubMeshData("ricecake.fbx");
+	mParent->DrawSubMesh(commandList, data, mCount);
+
+	commandList->SetPipelineState(PSOs.at(pass == ePass::Shadow ? "PSO_Shadow" : "PSO_Opaque").Get());
+}
+
+UINT ProjectileSystem::GetCount()
+{
+	return mCount;
+}
+
+void ProjectileSystem::RemoveDead()
+{
+	//  ĭ  ĭ .   ʴ´.
+	UINT i = 0;
+	while (i < mCount)
+	{
+		if (!mDead[i])
+		{
+			++i;
+			continue;
+		}
+		UINT last = --mCount;
+		mPosX[i] = mPosX[last];
+		mPosY[i] = mPosY[last];
+		mPosZ[i] = mPosZ[last];
+		mPrevX[i] = mPrevX[last];
+		mPrevY[i] = mPrevY[last];
+		mPrevZ[i] = mPrevZ[last];
+		mVelX[i] = mVelX[last];
+		mVelY[i] = mVelY[last];
+		mVelZ[i] = mVelZ[last];
+		mFallSpeed[i] = mFallSpeed[last];
+		mFallTime[i] = mFallTime[last];
+		mLifeTime[i] = mLifeTime[last];
+		mOwnerId[i] = mOwnerId[last];
+		mDead[i] = mDead[last];
+	}
+}
+
+void ProjectileSystem::BuildResource(ID3D12Device* device)
+{
+	// νϽ  .   GPU  ٸǷ ε  ϳ ϴ.
+	ThrowIfFailed(device->CreateCommittedResource(
+		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
+		D3D12_HEAP_FLAG_NONE,
+		&CD3DX12_RESOURCE_DESC::Buffer(sizeof(XMFLOAT4X4) * MAX_PROJECTILE),
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&mInstanceBuffer)));
+
+	CD3DX12_RANGE readRange(0, 0);
+	ThrowIfFailed(mInstanceBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mMappedInstance)));
+
+	//     ObjectCB. world  ̴ νϽ ķ ٲ.
+	const UINT constantBufferSize = mParent->CalcConstantBufferByteSize(sizeof(ObjectCB));
+	ThrowIfFailed(device->CreateCommittedResource(
+		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
+		D3D12_HEAP_FLAG_NONE,
+		&CD3DX12_RESOURCE_DESC::Buffer(constantBufferSize),
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&mConstantBuffer)));
+	ThrowIfFailed(mConstantBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mMappedConstant)));
+
+	ObjectCB objectCB{};
+	XMStoreFloat4x4(&objectCB.world, XMMatrixIdentity());
+	objectCB.isAnimate = 0;
+	objectCB.powValue = 1.0f;
+	objectCB.ambiantValue = 0.4f;
+	memcpy(mMappedConstant, &objectCB, sizeof(ObjectCB));
+}
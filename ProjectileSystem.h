@@ -0,0 +1,60 @@
+#pragma once
+#include "stdafx.h"
+#include "Info.h"
+#define MAX_PROJECTILE 4096
+
+class Scene;
+class Object;
+
+//   Object    óѴ.
+// ġ/ӵ/ SoA 迭  ũ  ΰ,  ĭ  ĭ ٲ㼭 .
+// ׸ νϽ   ε ۿ  ΰ DrawIndexedInstanced   .
+class ProjectileSystem
+{
+public:
+	ProjectileSystem(Scene* parent, ID3D12Device* device);
+	ProjectileSystem(const ProjectileSystem&) = delete;
+	ProjectileSystem& operator=(const ProjectileSystem&) = delete;
+	~ProjectileSystem();
+
+	void Spawn(uint32_t ownerId, XMVECTOR pos, XMVECTOR dir);
+	void Clear();
+	void Update(float deltaTime);
+	void ProcessCollision(vector<Object*>& objects);
+	void UploadInstances();
+	void Render(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, ePass pass);
+	UINT GetCount();
+private:
+	void RemoveDead();
+	void BuildResource(ID3D12Device* device);
+private:
+	Scene* mParent = nullptr;
+
+	UINT mCount = 0;
+	float mSpeed = 200.0f;
+	float mMaxLifeTime = 10.0f;
+	float mRadius = 0.75f;	//  Collider  xz  ũ
+
+	// SoA
+	float mPosX[MAX_PROJECTILE]{};
+	float mPosY[MAX_PROJECTILE]{};
+	float mPosZ[MAX_PROJECTILE]{};
+	float mPrevX[MAX_PROJECTILE]{};
+	float mPrevY[MAX_PROJECTILE]{};
+	float mPrevZ[MAX_PROJECTILE]{};
+	float mVelX[MAX_PROJECTILE]{};
+	float mVelY[MAX_PROJECTILE]{};
+	float mVelZ[MAX_PROJECTILE]{};
+	float mFallSpeed[MAX_PROJECTILE]{};	// Gravity Ʈ   Ǵ  ӵ
+	float mFallTime[MAX_PROJECTILE]{};
+	float mLifeTime[MAX_PROJECTILE]{};
+	uint32_t mOwnerId[MAX_PROJECTILE]{};
+	bool mDead[MAX_PROJECTILE]{};
+
+	XMFLOAT4X4 mAdjustT{};	//  ޽   (ġ )
+
+	ComPtr<ID3D12Resource> mInstanceBuffer;
+	XMFLOAT4X4* mMappedInstance = nullptr;
+	ComPtr<ID3D12Resource> mConstantBuffer;
+	UINT8* mMappedConstant = nullptr;
+};
@@ -1,38 +1,299 @@
 #include <fstream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
 #include "ResourceManager.h"
 
 ResourceManager::ResourceManager() : mFbxExtractor{ nullptr }, mVertexBuffer{}
 {
-	mFbxExtractor = make_unique<FbxExtractor>();
+	mCookManifest.Load(COOK_MANIFEST);
 }
 
 ResourceManager::~ResourceManager()
 {
 }
 
-void ResourceManager::LoadFbx(const string& fileName, bool onlyAnimation, bool zUp)
+//  fbx  ִϸ̼  ũ  ִ.
+static const string sClipName = "Take 001";
+
+//    Ű Ʈ    ġ  .
+template<typename T>
+static void CompactRanges(vector<T>& stream, vector<pair<UINT*, UINT>>& ranges)
+{
+	sort(ranges.begin(), ranges.end(), [](const pair<UINT*, UINT>& a, const pair<UINT*, UINT>& b) { return *a.first < *b.first; });
+	size_t write = 0;
+	for (auto& [start, count] : ranges) {
+		if (*start != write) move(stream.begin() + *start, stream.begin() + *start + count, stream.begin() + write);
+		*start = static_cast<UINT>(write);
+		write += count;
+	}
+	stream.resize(write);
+}
+
+//  GPU  δ. ġ 0 ̰ ĥ  Ʈ  ű.
+static void PackVertices(const vector<Vertex>& vertices, bool skinned, PreparedMesh& mesh)
+{
+	SubMeshData& subData = mesh.subData;
+	subData.vertexCountPerInstance = vertices.size();
+	subData.startVertexLocation = 0;
+	subData.startIndexLocation = -1;
+	subData.skinVertexLocation = skinned ? 0 : -1;
+	mesh.vertices.reserve(vertices.size());
+	for (const Vertex& vertex : vertices) mesh.vertices.push_back(VertexFormat::PackStatic(vertex));
+	if (skinned == false) return;
+	mesh.skinVertices.reserve(vertices.size());
+	for (const Vertex& vertex : vertices) mesh.skinVertices.push_back(VertexFormat::PackSkin(vertex));
+}
+
+// fbx ϳ  ̰ ε ũ⸦ .
+static void PackMesh(FbxData& data, PreparedMesh& mesh)
+{
+	SubMeshData& subData = mesh.subData;
+	PackVertices(data.vertices, VertexFormat::IsSkinned(data.vertices), mesh);
+	if (data.indices.empty() == false) {
+		// ε ޽  ȣ baseVertexLocation  Ű ׸
+		subData.indexCountPerInstance = data.indices.size();
+		subData.startIndexLocation = 0;
+		if (MeshOptimizer::FitsIndex16(data.vertices.size())) {
+			subData.indexFormat = DXGI_FORMAT_R16_UINT;
+			mesh.indices16.reserve(data.indices.size());
+			for (uint32_t index : data.indices) mesh.indices16.push_back(static_cast<uint16_t>(index));
+		}
+		else {
+			subData.indexFormat = DXGI_FORMAT_R32_UINT;
+			mesh.indices = move(data.indices);
+		}
+	}
+	data.vertices = vector<Vertex>{};
+	data.indices = vector<uint32_t>{};
+}
+
+// work(mainThread)  workerCount  忡 . ϳ θ .
+template<typename Work>
+static void RunWorkers(UINT workerCount, Work work)
+{
+	vector<thread> workers;
+	for (UINT i = 1; i < workerCount; ++i) workers.emplace_back(work, false);
+	work(true);
+	for (thread& worker : workers) worker.join();
+}
+
+void ResourceManager::LoadFbx(const string& fileName, bool onlyAnimation, bool zUp, const string& skeletonName)
+{
+	PreparedMeshes prepared{ { FbxAsset{ fileName, onlyAnimation, zUp, skeletonName } } };
+	PrepareMeshes(prepared, 1);
+	AddPreparedFbx(prepared, 0);
+}
+
+void ResourceManager::LoadFbxAssets(const vector<FbxAsset>& assets, UINT workerCount)
+{
+	PreparedMeshes prepared{ assets };
+	PrepareMeshes(prepared, workerCount);
+
+	// ̷   Ŭ ϵ麸 տ Ƿ   ġ ȴ.
+	auto start = chrono::steady_clock::now();
+	for (size_t i = 0; i < assets.size(); ++i) AddPreparedFbx(prepared, i);
+	float mergeSeconds = chrono::duration<float>(chrono::steady_clock::now() - start).count();
+
+	char buffer[128];
+	sprintf_s(buffer, "[Load] fbx %zu files : merge %.2fs\n", assets.size(), mergeSeconds);
+	OutputDebugStringA(buffer);
+}
+
+void ResourceManager::PrepareMeshes(PreparedMeshes& prepared, UINT workerCount)
+{
+	auto start = chrono::steady_clock::now();
+	const vector<FbxAsset>& assets = prepared.assets;
+
+	// ؽ  峢   Ƿ  θ 忡 Ѵ. ٲ   ϸ .
+	vector<uint64_t> sourceHashes;
+	for (const FbxAsset& asset : assets) {
+		string sourcePath = FBX_DIRECTORY + asset.fileName;
+		sourceHashes.push_back(mCookManifest.GetSourceHash(sourcePath, CookedAsset::GetImportSeed(asset.onlyAnimation, asset.zUp)));
+	}
+
+	// 1)   д´. ų  ٲ  ´
+	vector<FbxData> results(assets.size());
+	vector<uint8_t> imported(assets.size(), 0);	//   ٽ  Ѵ
+	prepared.meshes.assign(assets.size(), PreparedMesh{});
+	workerCount = max(1u, min(workerCount, (UINT)assets.size()));
+	atomic<UINT> next{ 0 };
+	RunWorkers(workerCount, [&](bool mainThread) {
+		// FbxManager  帶  д.  ϸ д   ʴ´.
+		unique_ptr<FbxExtractor> extractor;
+		for (UINT i = next++; i < assets.size(); i = next++) {
+			const FbxAsset& asset = assets[i];
+			if (CookedAsset::Load(CookedAsset::GetCookedPath(asset.fileName), sourceHashes[i], asset.onlyAnimation, asset.zUp, results[i]) == false) {
+				CookFbx(mainThread ? mFbxExtractor : extractor, asset.fileName, asset.onlyAnimation, asset.zUp, sourceHashes[i], results[i]);
+				imported[i] = 1;
+			}
+		}
+	});
+	float readSeconds = chrono::duration<float>(chrono::steady_clock::now() - start).count();
+
+	//  ޽ô ϳ       忡 
+	prepared.declaredMeshes.assign(prepared.declared.size(), PreparedMesh{});
+	for (size_t i = 0; i < prepared.declared.size(); ++i) {
+		auto source = mDeclaredSources.find(prepared.declared[i]);
+		if (source != mDeclaredSources.end()) VerifyRawFile(source->second);
+		mDeclaredMeshes.at(prepared.declared[i])(prepared.declaredMeshes[i]);
+	}
+
+	// 2) ̷ SkinnedData ڸ . ʿ ִ ̶  忡 Ѵ.
+	for (UINT i = 0; i < assets.size(); ++i) {
+		const FbxAsset& asset = assets[i];
+		FbxData& data = results[i];
+		if (data.boneHierarchy.empty()) continue;
+		if (asset.skeletonName.empty()) {
+			Skeleton& skeleton = prepared.skeletons[asset.fileName];
+			CookedAsset::MakeSkeleton(data, skeleton);
+			if (skeleton.BoneCount() > MAX_BONE) throw; // PoseCache ȷƮ  ĭ ũ ʰ
+		}
+		else {
+			size_t boneCount = data.boneHierarchy.size();
+			prepared.sharedBoneBytes[asset.fileName] = boneCount * (sizeof(int) + sizeof(XMFLOAT4X4));
+		}
+		prepared.animData[asset.fileName];
+	}
+
+	// 3) Ŭ  ״ SkinnedData  ѱ. ̷   ְ,  ̹ ö ִ. (LoadFbx)
+	//  ԰ų ٸ ̷,    ͸ ⼭  ؼ   ٽ .
+	next = 0;
+	RunWorkers(workerCount, [&](bool mainThread) {
+		unique_ptr<FbxExtractor> extractor;
+		for (UINT i = next++; i < assets.size(); i = next++) {
+			const FbxAsset& asset = assets[i];
+			FbxData& data = results[i];
+			const Skeleton* skeleton = nullptr;
+			if (data.boneHierarchy.empty() == false) {
+				const string& owner = asset.skeletonName.empty() ? asset.fileName : asset.skeletonName;
+				auto found = prepared.skeletons.find(owner);
+				skeleton = found != prepared.skeletons.end() ? &found->second : &mSkeletons.at(owner);
+				uint64_t bindHash = CookedAsset::GetBindHash(*skeleton, GetAnimationCompression());
+				if (data.bindHash != bindHash) {
+					if (data.bindHash != 0) {
+						//  Ŭ ǵ  Ƿ  ٽ ´
+						data = FbxData{};
+						CookFbx(mainThread ? mFbxExtractor : extractor, asset.fileName, asset.onlyAnimation, asset.zUp, sourceHashes[i], data);
+					}
+					SkinnedData::BindClips(*skeleton, data.boneNames, data.animations, GetAnimationCompression());
+					data.bindHash = bindHash;
+					imported[i] = 1;
+				}
+			}
+			if (imported[i]) {
+				string cookedPath = CookedAsset::GetCookedPath(asset.fileName);
+				CreateDirectoryA(COOKED_DIRECTORY, nullptr);
+				bool saved = CookedAsset::Save(cookedPath, data, sourceHashes[i], asset.onlyAnimation, asset.zUp);
+				OutputDebugStringA(("[Cook] " + asset.fileName + (saved ? " -> " + cookedPath : " :  ") + "\n").c_str());
+			}
+
+			if (skeleton) prepared.animData.at(asset.fileName).Set(*skeleton, data.animations);
+			if (asset.onlyAnimation == false) PackMesh(data, prepared.meshes[i]);
+			data = FbxData{};
+		}
+	});
+	float prepareSeconds = chrono::duration<float>(chrono::steady_clock::now() - start).count();
+
+	char buffer[128];
+	sprintf_s(buffer, "[Load] fbx %zu files, %u workers : read %.2fs, prepare %.2fs\n", assets.size(), workerCount, readSeconds, prepareSeconds);
+	OutputDebugStringA(buffer);
+}
+
+bool PreparedMeshes::IsEmpty()
 {
-	mFbxExtractor->ImportFbxFile(fileName, onlyAnimation, zUp);
-	mFbxExtractor->ExtractDataFromFbx();
+	return assets.empty() && declared.empty();
+}
 
-	if (onlyAnimation == false) {
-		vector<Vertex>& vertexData = mFbxExtractor->GetVertices();
-		SubMeshData subData{};
-		subData.vertexCountPerInstance = vertexData.size();
-		subData.startVertexLocation = mVertexBuffer.size();
-		subData.startIndexLocation = -1;
-		mSubMeshData[fileName] = subData;
-		mVertexBuffer.insert(mVertexBuffer.end(), vertexData.begin(), vertexData.end());
+int PreparedMeshes::Find(const string& fileName)
+{
+	for (size_t i = 0; i < assets.size(); ++i) {
+		if (assets[i].fileName == fileName) return (int)i;
 	}
+	return -1;
+}
 
-	SkinnedData animData;
-	animData.Set(mFbxExtractor->GetBoneHierarchyIndex(), mFbxExtractor->GetOffsetMatrix(), mFbxExtractor->GetAnimation());
-	mAnimData.emplace(fileName, animData);
+int PreparedMeshes::FindDeclared(const string& name)
+{
+	for (size_t i = 0; i < declared.size(); ++i) {
+		if (declared[i] == name) return (int)i;
+	}
+	return -1;
+}
 
-	mFbxExtractor->ResetAndClear();
+void ResourceManager::CookFbx(unique_ptr<FbxExtractor>& extractor, const string& fileName, bool onlyAnimation, bool zUp, uint64_t sourceHash, FbxData& data)
+{
+	if (sourceHash == 0) throw; //    ִ  ϵ 
+
+	// NativeFbxImporter   а,  аų ˻縦  ϰų -validate  SDK  ٸٰ   SDK  д´
+	bool imported = false;
+	if (mCookManifest.IsNativeRejected(FBX_DIRECTORY + fileName, sourceHash) == false) {
+		NativeFbxImporter importer;
+		string report;
+		imported = importer.Import(FBX_DIRECTORY + fileName, onlyAnimation, zUp, data);
+		if (!imported) OutputDebugStringA(("[Cook] " + fileName + " : " + importer.GetError() + ", FBX SDK  \n").c_str());
+		else if (!NativeFbxImporter::Check(data, report)) {
+			imported = false;
+			data = FbxData{};
+			OutputDebugStringA(("[Cook] " + fileName + " : ˻  " + report + ", FBX SDK  \n").c_str());
+		}
+	}
+	if (!imported) {
+		if (!extractor) extractor = make_unique<FbxExtractor>();
+		extractor->Extract(fileName, onlyAnimation, zUp, data);
+	}
+	MeshOptimizer::Report report = MeshOptimizer::Optimize(data.vertices, data.indices);
+	if (report.rawVertexCount > 0) {
+		char buffer[384];
+		sprintf_s(buffer, "[Mesh] %s : vertices %zu -> %zu (%.1f%%), indices %zu (%d bit), ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n", fileName.c_str(),
+			report.rawVertexCount, data.vertices.size(), 100.0f * data.vertices.size() / report.rawVertexCount, data.indices.size(),
+			MeshOptimizer::FitsIndex16(data.vertices.size()) ? 16 : 32, report.before.acmr, report.after.acmr, report.before.atvr, report.after.atvr);
+		OutputDebugStringA(buffer);
+	}
 }
 
-void ResourceManager::CreatePlane(const string& name, float size, float wrap)
+void ResourceManager::AddPreparedFbx(PreparedMeshes& prepared, size_t index)
+{
+	const FbxAsset& asset = prepared.assets[index];
+	if (asset.onlyAnimation == false) AddMesh(asset.fileName, prepared.meshes[index]);
+
+	//  ° űǷ SkinnedData  Ű ̷ ּҰ ٲ ʴ´
+	auto skeleton = prepared.skeletons.extract(asset.fileName);
+	if (skeleton.empty() == false) mSkeletons.insert(move(skeleton));
+	auto animNode = prepared.animData.extract(asset.fileName);
+	if (animNode.empty()) return;
+	auto shared = prepared.sharedBoneBytes.find(asset.fileName);
+	if (shared != prepared.sharedBoneBytes.end()) mSharedBoneBytes[asset.fileName] = shared->second;
+
+	const string& owner = asset.skeletonName.empty() ? asset.fileName : asset.skeletonName;
+	SkinnedData& animData = mAnimData.insert(move(animNode)).position->second;
+	if (animData.HasClip(sClipName) == false) return;
+	AnimationSet& animSet = mAnimSets[owner];
+	animSet.Add(asset.fileName, &animData, animData.FindClip(sClipName));
+	animSet.BindStates(GetAnimStates(owner));
+}
+
+void ResourceManager::AddMesh(const string& name, PreparedMesh& mesh)
+{
+	// ̹ ٿ  Ʈ  ̾ ̰ ġ ű
+	SubMeshData subData = mesh.subData;
+	subData.startVertexLocation = mVertexBuffer.size();
+	if (subData.skinVertexLocation != -1) subData.skinVertexLocation = mSkinVertexBuffer.size();
+	if (subData.startIndexLocation != -1) {
+		subData.startIndexLocation = subData.indexFormat == DXGI_FORMAT_R16_UINT ? mIndexBuffer16.size() : mIndexBuffer.size();
+		subData.baseVertexLocation = subData.startVertexLocation;
+	}
+	mVertexBuffer.insert(mVertexBuffer.end(), mesh.vertices.begin(), mesh.vertices.end());
+	mSkinVertexBuffer.insert(mSkinVertexBuffer.end(), mesh.skinVertices.begin(), mesh.skinVertices.end());
+	mIndexBuffer.insert(mIndexBuffer.end(), mesh.indices.begin(), mesh.indices.end());
+	mIndexBuffer16.insert(mIndexBuffer16.end(), mesh.indices16.begin(), mesh.indices16.end());
+	mSubMeshData[name] = subData;
+	if (mesh.terrain.terrainWidth > 0) mTerrainData = mesh.terrain;
+	mesh = PreparedMesh{};
+}
+
+void ResourceManager::CreatePlane(float size, float wrap, PreparedMesh& mesh)
 {
 	vector<Vertex> vertexData;
 
@@ -46,16 +307,10 @@ void ResourceManager::CreatePlane(const string& name, float size, float wrap)
 		vertexData.push_back(Vertex{ {0.0f, 0.0f, 0.0f},{0.0f,1.0f,0.0f},{0.0f,wrap} });
 	}
 
-	SubMeshData subData{};
-	subData.vertexCountPerInstance = vertexData.size();
-	subData.startVertexLocation = mVertexBuffer.size();
-	subData.startIndexLocation = -1;
-	mSubMeshData[name] = subData;
-
-	mVertexBuffer.insert(mVertexBuffer.end(), vertexData.begin(), vertexData.end());
+	PackVertices(vertexData, false, mesh);
 }
 
-void ResourceManager::CreateTerrain(const string& name, int maxHeight , int scale, int maxUV)
+void ResourceManager::CreateTerrain(const string& name, int maxHeight , int scale, int maxUV, PreparedMesh& mesh)
 {
 	ifstream in{ name };
 	if (!in) throw;
@@ -71,9 +326,9 @@ void ResourceManager::CreateTerrain(const string& name, int maxHeight , int scal
 	int width = sqrt(fileSize);
 	int height = sqrt(fileSize);
 
-	mTerrainData.terrainWidth = width;
-	mTerrainData.terrainHeight = height;
-	mTerrainData.terrainScale = scale;
+	mesh.terrain.terrainWidth = width;
+	mesh.terrain.terrainHeight = height;
+	mesh.terrain.terrainScale = scale;
 
 	float down{ 0.4f };
 	vector<float> heightData(width * height);
@@ -152,41 +407,256 @@ void ResourceManager::CreateTerrain(const string& name, int maxHeight , int scal
 		}
 	}
 
-	SubMeshData subData{};
-	subData.vertexCountPerInstance = vertices.size();
-	subData.indexCountPerInstance = indices.size();
-	subData.startVertexLocation = mVertexBuffer.size();
-	subData.startIndexLocation = mIndexBuffer.size();
-	subData.baseVertexLocation = mVertexBuffer.size();
-	mSubMeshData[name] = subData;
-
-	mVertexBuffer.insert(mVertexBuffer.end(), vertices.begin(), vertices.end());
-	//OutputDebugStringA(string{ "##### " + (to_string(mVertexBuffer.size()) + "\n") }.c_str());
-
-	mIndexBuffer.insert(mIndexBuffer.end(), indices.begin(), indices.end());
+	PackVertices(vertices, false, mesh);
+	mesh.subData.indexCountPerInstance = indices.size();
+	mesh.subData.startIndexLocation = 0;
+	mesh.subData.indexFormat = DXGI_FORMAT_R32_UINT;
+	mesh.indices = move(indices);
 }
 
-vector<Vertex>& ResourceManager::GetVertexBuffer()
+vector<StaticVertex>& ResourceManager::GetVertexBuffer()
 {
 	return mVertexBuffer;
 }
 
+vector<SkinVertex>& ResourceManager::GetSkinVertexBuffer()
+{
+	return mSkinVertexBuffer;
+}
+
 vector<uint32_t>& ResourceManager::GetIndexBuffer()
 {
 	return mIndexBuffer;
 }
 
-SubMeshData& ResourceManager::GetSubMeshData(string name)
+vector<uint16_t>& ResourceManager::GetIndexBuffer16()
+{
+	return mIndexBuffer16;
+}
+
+SubMeshData& ResourceManager::GetSubMeshData(const string& name)
 {
 	return mSubMeshData.at(name);
 }
 
-SkinnedData& ResourceManager::GetAnimationData(string name)
+SkinnedData& ResourceManager::GetAnimationData(const string& name)
 {
 	return mAnimData.at(name);
 }
 
+AnimationSet& ResourceManager::GetAnimationSet(const string& skeletonName)
+{
+	return mAnimSets.at(skeletonName);
+}
+
 TerrainData& ResourceManager::GetTerrainData()
 {
 	return mTerrainData;
 }
+
+void ResourceManager::SaveCookManifest()
+{
+	if (mCookManifest.IsDirty() == false) return;
+	CreateDirectoryA(COOKED_DIRECTORY, nullptr);
+	mCookManifest.Save(COOK_MANIFEST);
+}
+
+void ResourceManager::VerifyRawFile(const string& path)
+{
+	// fbx  ޸   Ƿ ٽ  ʰ,  Ҵٰ ˸
+	if (mCookManifest.IsRawFileCurrent(path)) return;
+	OutputDebugStringA(("[Cook] " + path + " :  ϰ ٸ, -cook    \n").c_str());
+}
+
+void ResourceManager::ReportAnimationMemory()
+{
+	//  ö ִ ϸ . ϸ 󸶳 پ Ŀ -animreport  .
+	size_t keyBytes = 0, sharedBoneBytes = 0;
+	for (auto& [name, animData] : mAnimData) keyBytes += animData.GetCompressedKeyBytes();
+	for (auto& [name, bytes] : mSharedBoneBytes) sharedBoneBytes += bytes;
+
+	if (keyBytes == 0) return;
+	OutputDebugStringA(("[AnimMemory] keys : " + to_string(keyBytes) + " bytes, compression "
+		+ (GetAnimationCompression().Enabled ? "on" : "off") + "\n").c_str());
+	OutputDebugStringA(("[AnimMemory] skeletons : " + to_string(mSkeletons.size()) + " shared by " + to_string(mAnimData.size())
+		+ " files, " + to_string(sharedBoneBytes) + " bytes of bone data not duplicated\n").c_str());
+}
+
+void ResourceManager::ReportVertexMemory()
+{
+	size_t packedBytes = mVertexBuffer.size() * sizeof(StaticVertex) + mSkinVertexBuffer.size() * sizeof(SkinVertex);
+	size_t fullBytes = mVertexBuffer.size() * sizeof(Vertex);
+	if (fullBytes == 0) return;
+	char buffer[256];
+	sprintf_s(buffer, "[VertexMemory] vertices %zu (skinned %zu) : %.2f MB -> %.2f MB (%zu%%)\n", mVertexBuffer.size(), mSkinVertexBuffer.size(),
+		fullBytes / 1048576.0f, packedBytes / 1048576.0f, packedBytes * 100 / fullBytes);
+	OutputDebugStringA(buffer);
+}
+
+void ResourceManager::DeclareMesh(const string& name, function<void(PreparedMesh&)> create, const string& sourcePath)
+{
+	mDeclaredMeshes[name] = move(create);
+	if (sourcePath.empty() == false) mDeclaredSources[name] = sourcePath;
+}
+
+void ResourceManager::AcquireMeshes(const vector<string>& names, PreparedMeshes* prepared)
+{
+	vector<string> loadKeys;
+	for (const string& name : names) {
+		const string& key = GetResidencyKey(name);
+		if (mResidencyRefs[key]++ == 0) loadKeys.push_back(key);
+	}
+	if (loadKeys.empty()) return;
+
+	// ̸    ͸ ⼭ .
+	vector<FbxAsset> assets = FindFbxAssets(loadKeys);
+	PreparedMeshes made;
+	for (const FbxAsset& asset : assets) {
+		if (prepared == nullptr || prepared->Find(asset.fileName) == -1) made.assets.push_back(asset);
+	}
+	for (const string& key : loadKeys) {
+		if (mDeclaredMeshes.count(key) && (prepared == nullptr || prepared->FindDeclared(key) == -1)) made.declared.push_back(key);
+	}
+	if (made.IsEmpty() == false) PrepareMeshes(made, thread::hardware_concurrency());
+	if (made.assets.empty() == false) SaveCookManifest();
+
+	// fbx    ģ.
+	auto start = chrono::steady_clock::now();
+	for (const FbxAsset& asset : assets) {
+		int index = made.Find(asset.fileName);
+		if (index != -1) AddPreparedFbx(made, index);
+		else AddPreparedFbx(*prepared, prepared->Find(asset.fileName));
+	}
+	size_t declaredCount = 0;
+	for (const string& key : loadKeys) {
+		if (mDeclaredMeshes.count(key) == 0) continue;
+		++declaredCount;
+		int index = made.FindDeclared(key);
+		if (index != -1) AddMesh(key, made.declaredMeshes[index]);
+		else AddMesh(key, prepared->declaredMeshes[prepared->FindDeclared(key)]);
+	}
+	float mergeSeconds = chrono::duration<float>(chrono::steady_clock::now() - start).count();
+
+	char buffer[128];
+	sprintf_s(buffer, "[Load] fbx %zu files, declared %zu (%zu made here) : merge %.2fs\n", assets.size(), declaredCount,
+		made.assets.size() + made.declared.size(), mergeSeconds);
+	OutputDebugStringA(buffer);
+	++mGeometryVersion;
+}
+
+PreparedMeshes ResourceManager::FindMissingMeshes(const vector<string>& names)
+{
+	vector<string> keys;
+	PreparedMeshes missing;
+	for (const string& name : names) {
+		const string& key = GetResidencyKey(name);
+		if (mResidencyRefs.count(key) || find(keys.begin(), keys.end(), key) != keys.end()) continue;
+		keys.push_back(key);
+		if (mDeclaredMeshes.count(key)) missing.declared.push_back(key);
+	}
+	missing.assets = FindFbxAssets(keys);
+	return missing;
+}
+
+void ResourceManager::ReleaseMeshes(const vector<string>& names)
+{
+	bool evicted = false;
+	for (const string& name : names) {
+		const string& key = GetResidencyKey(name);
+		auto it = mResidencyRefs.find(key);
+		if (it == mResidencyRefs.end() || it->second == 0) throw; // Acquire  Release
+		if (--it->second > 0) continue;
+		mResidencyRefs.erase(it);
+		Evict(key);
+		evicted = true;
+	}
+	if (evicted == false) return;
+	++mGeometryVersion;
+
+	//  ڸ  ΰ,  ڸ  ޽ú Ŀ  .
+	//    ޽ ġ ״ζ Scene  ڿ  ͸ GPU  ø ȴ.
+	size_t liveBytes = 0;
+	for (auto& [name, data] : mSubMeshData) {
+		liveBytes += data.vertexCountPerInstance * sizeof(StaticVertex);
+		if (data.skinVertexLocation != -1) liveBytes += data.vertexCountPerInstance * sizeof(SkinVertex);
+		if (data.startIndexLocation == -1) continue;
+		liveBytes += data.indexCountPerInstance * (data.indexFormat == DXGI_FORMAT_R16_UINT ? sizeof(uint16_t) : sizeof(uint32_t));
+	}
+	size_t totalBytes = mVertexBuffer.size() * sizeof(StaticVertex) + mSkinVertexBuffer.size() * sizeof(SkinVertex)
+		+ mIndexBuffer.size() * sizeof(uint32_t) + mIndexBuffer16.size() * sizeof(uint16_t);
+	if (totalBytes - liveBytes <= liveBytes) return;
+	CompactGeometry();
+	++mGeometryLayoutVersion;
+}
+
+bool ResourceManager::IsMeshResident(const string& name)
+{
+	return mSubMeshData.count(name) > 0;
+}
+
+uint64_t ResourceManager::GetGeometryVersion()
+{
+	return mGeometryVersion;
+}
+
+uint64_t ResourceManager::GetGeometryLayoutVersion()
+{
+	return mGeometryLayoutVersion;
+}
+
+const string& ResourceManager::GetResidencyKey(const string& name)
+{
+	auto declared = mDeclaredMeshes.find(name);
+	if (declared != mDeclaredMeshes.end()) return declared->first;
+	for (const FbxAsset& asset : GetFbxAssets()) {
+		if (asset.fileName == name) return asset.skeletonName.empty() ? asset.fileName : asset.skeletonName;
+	}
+	throw; // Ͽ  ޽
+}
+
+vector<FbxAsset> ResourceManager::FindFbxAssets(const vector<string>& keys)
+{
+	vector<FbxAsset> assets;
+	for (const FbxAsset& asset : GetFbxAssets()) {
+		const string& key = asset.skeletonName.empty() ? asset.fileName : asset.skeletonName;
+		if (find(keys.begin(), keys.end(), key) != keys.end()) assets.push_back(asset);
+	}
+	return assets;
+}
+
+void ResourceManager::Evict(const string& key)
+{
+	if (mDeclaredMeshes.count(key)) {
+		mSubMeshData.erase(key);
+		return;
+	}
+	for (const FbxAsset& asset : GetFbxAssets()) {
+		const string& owner = asset.skeletonName.empty() ? asset.fileName : asset.skeletonName;
+		if (owner != key) continue;
+		mSubMeshData.erase(asset.fileName);
+		mAnimData.erase(asset.fileName);
+		mSharedBoneBytes.erase(asset.fileName);
+	}
+	mAnimSets.erase(key);
+	mSkeletons.erase(key);
+}
+
+void ResourceManager::CompactGeometry()
+{
+	// ε ޽  ȣ ״ ΰ ġ 
+	vector<pair<UINT*, UINT>> vertexRanges, skinRanges, indexRanges, indexRanges16;
+	for (auto& [name, data] : mSubMeshData) {
+		vertexRanges.push_back({ &data.startVertexLocation, data.vertexCountPerInstance });
+		if (data.skinVertexLocation != -1) skinRanges.push_back({ &data.skinVertexLocation, data.vertexCountPerInstance });
+		if (data.startIndexLocation == -1) continue;
+		if (data.indexFormat == DXGI_FORMAT_R16_UINT) indexRanges16.push_back({ &data.startIndexLocation, data.indexCountPerInstance });
+		else indexRanges.push_back({ &data.startIndexLocation, data.indexCountPerInstance });
+	}
+	CompactRanges(mVertexBuffer, vertexRanges);
+	CompactRanges(mSkinVertexBuffer, skinRanges);
+	CompactRanges(mIndexBuffer, indexRanges);
+	CompactRanges(mIndexBuffer16, indexRanges16);
+	for (auto& [name, data] : mSubMeshData) {
+		if (data.startIndexLocation != -1) data.baseVertexLocation = data.startVertexLocation;
+	}
+}
@@ -1,6 +1,12 @@
 #pragma once
 #include "stdafx.h"
+#include <functional>
 #include "FbxExtractor.h"
+#include "NativeFbxImporter.h"
+#include "CookedAsset.h"
+#include "AssetCooker.h"
+#include "MeshOptimizer.h"
+#include "VertexFormat.h"
 #include "Info.h"
 
 struct TerrainData {
@@ -9,25 +15,108 @@ struct TerrainData {
 	int terrainScale;
 };
 
+// ġ  ޽ ϳ. ġ 0 ̰ ĥ  Ʈ  ű.
+struct PreparedMesh
+{
+	SubMeshData subData{};
+	vector<StaticVertex> vertices;
+	vector<SkinVertex> skinVertices;
+	vector<uint32_t> indices;
+	vector<uint16_t> indices16;
+	TerrainData terrain{};	// CreateTerrain   ޽ø ä
+};
+
+// ٸ 忡   ޽õ. fbx  а,  ̰,  Ŭ SkinnedData  Ѱ д.
+// DeclareMesh   ޽(, )  д.
+// AcquireMeshes   忡 Ʈ ̾ ̰  带 ű⸸ Ѵ.
+struct PreparedMeshes
+{
+	vector<FbxAsset> assets;
+	vector<string> declared;	// DeclareMesh   ̸
+	vector<PreparedMesh> meshes;	// assets   . ִϸ̼Ǹ ִ   ִ
+	vector<PreparedMesh> declaredMeshes;	// declared   
+	unordered_map<string, Skeleton> skeletons;
+	unordered_map<string, SkinnedData> animData;
+	unordered_map<string, size_t> sharedBoneBytes;
+
+	bool IsEmpty();
+	int Find(const string& fileName);	// assets  ȣ.  -1
+	int FindDeclared(const string& name);	// declared  ȣ.  -1
+};
+
 class ResourceManager
 {
 public:
 	ResourceManager();
 	~ResourceManager();
-	void LoadFbx(const string& fileName, bool onlyAnimation, bool zUp);
-	void CreatePlane(const string& name, float size, float wrap);
-	void CreateTerrain(const string& name, int maxheight, int scale, int maxUV);
-	vector<Vertex>& GetVertexBuffer();
+	// skeletonName       ̷ ǰ, ƴϸ ̹ ε ̷濡 ٴ´.
+	// Cooked     װ ؼ а, ų  Ǿ fbx  о  д.
+	void LoadFbx(const string& fileName, bool onlyAnimation, bool zUp, const string& skeletonName = "");
+	//  б(  Ǵ fbx ) ۾   ϰ,    ģ.
+	// ׷   ġ AnimationSet ȣ LoadFbx  ʷ θ Ͱ .
+	void LoadFbxAssets(const vector<FbxAsset>& assets, UINT workerCount);
+	//  а ġ     ؼ prepared  ä.    ResourceManager  ġ Ƿ
+	// ResourceManager  ġ ٸ ȣ ġ  ٸ 忡 ҷ ȴ.
+	void PrepareMeshes(PreparedMeshes& prepared, UINT workerCount);
+	// DeclareMesh  create  θ. ResourceManager  ġ Ƿ ٸ 忡 ҷ ȴ
+	static void CreatePlane(float size, float wrap, PreparedMesh& mesh);
+	static void CreateTerrain(const string& name, int maxheight, int scale, int maxUV, PreparedMesh& mesh);
+
+	//  Ŵ佺Ʈ  ޽   . ̸ fbx  ̸̳ DeclareMesh   ̸̴.
+	// ̷ ϰ  Ŭ ϵ    ö󰡰 . (AnimationSet  ¸ Ŭ ã д)
+	// ø  ڿ ٰ,  ڸ  ڸ    . ۰ ٲ GetGeometryVersion ,
+	// ܼ SubMeshData  ġ ٲ GetGeometryLayoutVersion  .
+	// create  CreatePlane, CreateTerrain  θ. sourcePath  create  д Ϸ,    ϰ ´ 
+	void DeclareMesh(const string& name, function<void(PreparedMesh&)> create, const string& sourcePath = "");
+	//   ø ó   д´. prepared  ̸   ޽ô ٽ  ʴ´.
+	void AcquireMeshes(const vector<string>& names, PreparedMeshes* prepared = nullptr);
+	//  ö   fbx ( )  ޽ ̸. PrepareMeshes  ѱ
+	PreparedMeshes FindMissingMeshes(const vector<string>& names);
+	void ReleaseMeshes(const vector<string>& names);	//   0    
+	bool IsMeshResident(const string& name);
+	uint64_t GetGeometryVersion();
+	uint64_t GetGeometryLayoutVersion();
+	vector<StaticVertex>& GetVertexBuffer();
+	vector<SkinVertex>& GetSkinVertexBuffer();	// Ų ޽ ġ  ȣ. SubMeshData::skinVertexLocation 
 	vector<uint32_t>& GetIndexBuffer();
-	SubMeshData& GetSubMeshData(string name);
-	SkinnedData& GetAnimationData(string name);
+	vector<uint16_t>& GetIndexBuffer16();	//  65536   fbx ޽ ε
+	SubMeshData& GetSubMeshData(const string& name);
+	SkinnedData& GetAnimationData(const string& name);
+	AnimationSet& GetAnimationSet(const string& skeletonName);
 	TerrainData& GetTerrainData();
+	void ReportAnimationMemory();
+	void ReportVertexMemory();
+	void SaveCookManifest();	// ε ߿  ؽð  Ǿ  
+	// ״ д (dds, ̸)  ϰ ٸ α׸ .  忡 ҷ ȴ
+	void VerifyRawFile(const string& path);
+private:
+	// fbx  ͼ  Ѵ. Ŭ   PrepareMeshes   Ϸ .
+	// extractor  ġ   忡 ҷ ȴ.
+	// extractor  SDK  о   ó .
+	void CookFbx(unique_ptr<FbxExtractor>& extractor, const string& fileName, bool onlyAnimation, bool zUp, uint64_t sourceHash, FbxData& data);
+	void AddPreparedFbx(PreparedMeshes& prepared, size_t index);
+	void AddMesh(const string& name, PreparedMesh& mesh);	// Ʈ  ̾ ̰ ġ ű
+	const string& GetResidencyKey(const string& name);	//  ö󰡰   ̸
+	vector<FbxAsset> FindFbxAssets(const vector<string>& keys);
+	void Evict(const string& key);
+	void CompactGeometry();
 private:
 	unique_ptr<FbxExtractor> mFbxExtractor;
-	vector<Vertex> mVertexBuffer;
+	vector<StaticVertex> mVertexBuffer;
+	vector<SkinVertex> mSkinVertexBuffer;
 	vector<uint32_t> mIndexBuffer;
+	vector<uint16_t> mIndexBuffer16;
 	unordered_map<string, SubMeshData> mSubMeshData;
+	unordered_map<string, Skeleton> mSkeletons;		// ̷  ̸ -> ̷
 	unordered_map<string, SkinnedData> mAnimData;
-	TerrainData mTerrainData;
+	unordered_map<string, AnimationSet> mAnimSets;	// ̷  ̸ ->  ĳ Ŭ
+	TerrainData mTerrainData{};
+	unordered_map<string, size_t> mSharedBoneBytes;	// Ŭ  ->  ͸   ־ٸ   ޸
+	CookManifest mCookManifest;
+	unordered_map<string, function<void(PreparedMesh&)>> mDeclaredMeshes;
+	unordered_map<string, string> mDeclaredSources;	//  ޽ -> д 
+	unordered_map<string, UINT> mResidencyRefs;	//  ̸ ->  
+	uint64_t mGeometryVersion = 0;
+	uint64_t mGeometryLayoutVersion = 0;
 };
 
@@ -11,8 +11,15 @@ std::random_device rd1;
 default_random_engine dre1(rd1());
 uniform_int_distribution uid1(0, 1);
 
+//   ۾ 忡 AddObj  ť  ⿡ ִ´
+static thread_local vector<Object*>* sStageBuildObjects = nullptr;
+
 Scene::~Scene()
 {
+    if (m_stageBuild) {
+        WaitStageBuild();
+        for (Object* obj : m_stageBuild->objects) delete obj;
+    }
     OnDestroy();
     DeleteCurrentObjects();
 }
@@ -32,30 +39,73 @@ void Scene::OnInit(ID3D12Device* device, ID3D12GraphicsCommandList* commandList)
     BuildInputElement();
     BuildShaders();
     BuildPSO(device);
-    BuildVertexBuffer(device, commandList);
-    BuildIndexBuffer(device, commandList);
-    BuildTextureBuffer(device, commandList);
     BuildConstantBuffer(device);
     BuildDescriptorHeap(device);
-    BuildVertexBufferView();
-    BuildIndexBufferView();
     BuildConstantBufferView(device);
-    BuildTextureBufferView(device);
+    for (int i = 0; i < m_DDSFileName.size(); ++i) BuildTextureBufferView(device, i);
     BuildShadow();
+    BuildAI();
+    BuildProjectileSystem(device);
+    BuildPoseCache();
+    BuildAnimationSystem(device);
 
     BuildRandomPuzzleStatus();
     ProcessStageQueue();
+    FinishStageBuild();
     ProcessObjectQueue();
+    UpdateResidentResources(device, commandList);
 }
 
-void Scene::BuildHuntingStage()
+StageManifest Scene::GetStageManifest(const wstring& stage)
 {
-    m_current_stage = L"Hunting";
+    //  : ÷̾, ȭ 簢
+    StageManifest manifest{ { "1P(boy-idle).fbx", "Quad" }, { L"boy" } };
+    auto Add = [&](vector<string> meshes, vector<wstring> textures) {
+        manifest.meshes.insert(manifest.meshes.end(), meshes.begin(), meshes.end());
+        manifest.textures.insert(manifest.textures.end(), textures.begin(), textures.end());
+        };
+
+    //  : UI(BuildUI), ,  ,   ǥ. Title, End  BuildUI   ʴ´.
+    //  ߿ ٲ  ؽó  ־ GetTextureIndex    ش.
+    if (stage == L"Hunting" || stage == L"Base" || stage == L"God") {
+        Add({ "ricecake.fbx" },
+            { L"Red", L"RiceCakePink", L"BoyIcon", L"White", L"Life0", L"Life1", L"Life2", L"Life3",
+              L"RiceCake0", L"RiceCake1", L"RiceCake2", L"RiceCake3", L"RiceCake4",
+              L"TigerLeather0", L"TigerLeather1", L"TigerLeather2", L"TigerLeather3", L"TigerLeather4", L"TigerLeather5",
+              L"PuzzleFrame", L"PuzzleFrameComplete", L"PuzzleO", L"PuzzleX" });
+    }
+
+    if (stage == L"Hunting") {
+        // BuildHuntingStage, ȣ̰ ߸ 
+        Add({ "HeightMap.raw", "0113_tiger.fbx", "tiger_leather.fbx", "well.fbx", "long_tree.fbx", "normal_tree.fbx", "cloud1.fbx" },
+            { L"grass", L"tigercolor", L"tigerLeather", L"broken_house", L"longTree", L"normalTree", L"LightGray" });
+    }
+    else if (stage == L"Base") {
+        // BuildBaseStage,  Ʈ â
+        Add({ "Plane", "sister_idle_fix.fbx", "god_idle.fbx", "0113_tiger.fbx", "background_house.fbx", "broken_house.fbx", "broken_house2.fbx",
+              "table.fbx", "long_tree.fbx", "normal_tree.fbx", "fence.fbx", "cloud1.fbx" },
+            { L"grass", L"sister", L"god", L"tigercolor", L"broken_house", L"broken_house2", L"Brown", L"longTree", L"normalTree",
+              L"Gray", L"LightGray", L"Quest", L"GoToGod" });
+    }
+    else if (stage == L"God") {
+        Add({ "HalfPlane", "normal_tree.fbx", "fence.fbx", "wood.fbx", "axe.fbx", "cloud1.fbx" },
+            { L"grass", L"normalTree", L"Brown", L"wood", L"axe", L"Gray" });
+    }
+    else if (stage == L"Title") {
+        Add({}, { L"Title" });
+    }
+    else if (stage == L"End") {
+        Add({}, { L"End" });
+    }
+    return manifest;
+}
 
+void Scene::BuildHuntingStage()
+{
     Object* objectPtr = nullptr;
     {
-        mMainCameraId = AllocateId();
-        objectPtr = new CameraObject(this, mMainCameraId);
+        m_stageBuild->mainCameraId = AllocateId();
+        objectPtr = new CameraObject(this, m_stageBuild->mainCameraId);
         objectPtr->AddComponent(new Transform{ {0.f, 0.0f, 0.f} });
         AddObj(objectPtr);
     }
@@ -67,9 +117,10 @@ void Scene::BuildHuntingStage()
         objectPtr->AddComponent(new AdjustTransform{ {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {scale, scale, scale} });
         objectPtr->AddComponent(new Mesh{ "1P(boy-idle).fbx" });
         objectPtr->AddComponent(new Texture{ L"boy" , 1.0f, 0.4f });
-        objectPtr->AddComponent(new Animation{ "1P(boy-idle).fbx" });
+        objectPtr->AddComponent(new Animation{ m_resourceManager->GetAnimationSet("1P(boy-idle).fbx"), BOY_IDLE });
         objectPtr->AddComponent(new Gravity);
         objectPtr->AddComponent(new Collider{ {0.0f, 8.0f, 0.0f}, {2.0f, 8.0f, 2.0f} });
+        objectPtr->GetComponent<Collider>()->SetActivator(true);
         AddObj(objectPtr);
     }
 
@@ -90,6 +141,7 @@ void Scene::BuildHuntingStage()
         objectPtr->AddComponent(new Mesh{ "well.fbx" });
         objectPtr->AddComponent(new Texture{ L"broken_house", 1.0f, 0.4f });
         objectPtr->AddComponent(new Collider{ {0.0f, 37.5f * scale, 0.0f}, {12.5f * scale, 37.5f * scale, 12.5f * scale} });
+        objectPtr->GetComponent<Collider>()->SetTrigger(true);
         objectPtr->AddComponent(new Gravity);
         AddObj(objectPtr);
 
@@ -99,6 +151,7 @@ void Scene::BuildHuntingStage()
         objectPtr->AddComponent(new Mesh{ "well.fbx" });
         objectPtr->AddComponent(new Texture{ L"broken_house", 1.0f, 0.4f });
         objectPtr->AddComponent(new Collider{ {0.0f, 37.5f * scale, 0.0f}, {12.5f * scale, 37.5f * scale, 12.5f * scale} });
+        objectPtr->GetComponent<Collider>()->SetTrigger(true);
         objectPtr->AddComponent(new Gravity);
         AddObj(objectPtr);
 
@@ -108,6 +161,7 @@ void Scene::BuildHuntingStage()
         objectPtr->AddComponent(new Mesh{ "well.fbx" });
         objectPtr->AddComponent(new Texture{ L"broken_house", 1.0f, 0.4f });
         objectPtr->AddComponent(new Collider{ {0.0f, 37.5f * scale, 0.0f}, {12.5f * scale, 37.5f * scale, 12.5f * scale} });
+        objectPtr->GetComponent<Collider>()->SetTrigger(true);
         objectPtr->AddComponent(new Gravity);
         AddObj(objectPtr);
 
@@ -117,6 +171,7 @@ void Scene::BuildHuntingStage()
         objectPtr->AddComponent(new Mesh{ "well.fbx" });
         objectPtr->AddComponent(new Texture{ L"broken_house", 1.0f, 0.4f });
         objectPtr->AddComponent(new Collider{ {0.0f, 37.5f * scale, 0.0f}, {12.5f * scale, 37.5f * scale, 12.5f * scale} });
+        objectPtr->GetComponent<Collider>()->SetTrigger(true);
         objectPtr->AddComponent(new Gravity);
         AddObj(objectPtr);
     }
@@ -176,7 +231,7 @@ void Scene::BuildHuntingStage()
                 objectPtr->AddComponent(new AdjustTransform{ {0.0f, 0.0f, -40.0f * scale}, {0.0f, 180.0f, 0.0f}, {scale, scale, scale} });
                 objectPtr->AddComponent(new Mesh{ "0113_tiger.fbx" });
                 objectPtr->AddComponent(new Texture{ L"tigercolor", 1.0f, 0.4f });
-                objectPtr->AddComponent(new Animation{ "0113_tiger_walk.fbx" });
+                objectPtr->AddComponent(new Animation{ m_resourceManager->GetAnimationSet("0113_tiger.fbx"), TIGER_WALK });
                 objectPtr->AddComponent(new Gravity);
                 objectPtr->AddComponent(new Collider{ {0.0f, 6.0f, 0.0f}, {2.0f, 6.0f, 10.0f} });
                 AddObj(objectPtr);
@@ -241,12 +296,11 @@ void Scene::BuildHuntingStage()
 
 void Scene::BuildBaseStage()
 {
-    m_current_stage = L"Base";
     Object* objectPtr = nullptr;
     // ī޶
     {
-        mMainCameraId = AllocateId();
-        objectPtr = new CameraObject(this, mMainCameraId);
+        m_stageBuild->mainCameraId = AllocateId();
+        objectPtr = new CameraObject(this, m_stageBuild->mainCameraId);
         objectPtr->AddComponent(new Transform{ {0.0f, 0.0f, 0.0f} });
         AddObj(objectPtr);
     }
@@ -259,9 +313,10 @@ void Scene::BuildBaseStage()
         objectPtr->AddComponent(new AdjustTransform{ {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {scale, scale, scale} });
         objectPtr->AddComponent(new Mesh{ "1P(boy-idle).fbx" });
         objectPtr->AddComponent(new Texture{ L"boy" , 1.0f, 0.4f });
-        objectPtr->AddComponent(new Animation{ "1P(boy-idle).fbx" });
+        objectPtr->AddComponent(new Animation{ m_resourceManager->GetAnimationSet("1P(boy-idle).fbx"), BOY_IDLE });
         objectPtr->AddComponent(new Gravity);
         objectPtr->AddComponent(new Collider{ {0.0f, 80.0f * scale, 0.0f}, {30.0f * scale, 80.0f * scale, 30.0f * scale} });
+        objectPtr->GetComponent<Collider>()->SetActivator(true);
         AddObj(objectPtr);
     }
 
@@ -273,9 +328,10 @@ void Scene::BuildBaseStage()
         objectPtr->AddComponent(new AdjustTransform{ {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {scale, scale, scale} });
         objectPtr->AddComponent(new Mesh{ "sister_idle_fix.fbx" });
         objectPtr->AddComponent(new Texture{ L"sister" , 1.0f, 0.4f });
-        objectPtr->AddComponent(new Animation{ "sister_idle_fix.fbx" });
+        objectPtr->AddComponent(new Animation{ m_resourceManager->GetAnimationSet("sister_idle_fix.fbx") });
         objectPtr->AddComponent(new Gravity);
         objectPtr->AddComponent(new Collider{ {0.0f, 80.0f * scale, 0.0f}, {30.0f * scale, 80.0f * scale, 30.0f * scale} });
+        objectPtr->GetComponent<Collider>()->SetTrigger(true);
         AddObj(objectPtr);
     }
 
@@ -287,9 +343,10 @@ void Scene::BuildBaseStage()
         objectPtr->AddComponent(new AdjustTransform{ {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {scale, scale, scale} });
         objectPtr->AddComponent(new Mesh{ "god_idle.fbx" });
         objectPtr->AddComponent(new Texture{ L"god" , 1.0f, 0.4f });
-        objectPtr->AddComponent(new Animation{ "god_idle.fbx" });
+        objectPtr->AddComponent(new Animation{ m_resourceManager->GetAnimationSet("god_idle.fbx") });
         objectPtr->AddComponent(new Gravity);
         objectPtr->AddComponent(new Collider{ {0.0f, 80.0f * scale, 0.0f}, {30.0f * scale, 80.0f * scale, 30.0f * scale} });
+        objectPtr->GetComponent<Collider>()->SetTrigger(true);
         AddObj(objectPtr);
     }
 
@@ -492,9 +549,10 @@ void Scene::BuildBaseStage()
         objectPtr->AddComponent(new AdjustTransform{ {0.0f, 0.0f, -40.0f * scale}, {0.0f, 180.0f, 0.0f}, {scale, scale, scale} });
         objectPtr->AddComponent(new Mesh{ "0113_tiger.fbx" });
         objectPtr->AddComponent(new Texture{ L"tigercolor", 1.0f, 0.4f });
-        objectPtr->AddComponent(new Animation{ "0113_tiger_walk.fbx" });
+        objectPtr->AddComponent(new Animation{ m_resourceManager->GetAnimationSet("0113_tiger.fbx"), TIGER_WALK });
         objectPtr->AddComponent(new Gravity);
         objectPtr->AddComponent(new Collider{ {0.0f, 6.0f, 0.0f}, {2.0f, 6.0f, 10.0f} });
+        objectPtr->GetComponent<Collider>()->SetTrigger(true);
         AddObj(objectPtr);
 
         objectPtr = new TigerMockup(this, AllocateId());
@@ -502,9 +560,10 @@ void Scene::BuildBaseStage()
         objectPtr->AddComponent(new AdjustTransform{ {0.0f, 0.0f, -40.0f * scale}, {0.0f, 180.0f, 0.0f}, {scale, scale, scale} });
         objectPtr->AddComponent(new Mesh{ "0113_tiger.fbx" });
         objectPtr->AddComponent(new Texture{ L"tigercolor", 1.0f, 0.4f });
-        objectPtr->AddComponent(new Animation{ "0113_tiger_walk.fbx" });
+        objectPtr->AddComponent(new Animation{ m_resourceManager->GetAnimationSet("0113_tiger.fbx"), TIGER_WALK });
         objectPtr->AddComponent(new Gravity);
         objectPtr->AddComponent(new Collider{ {0.0f, 6.0f, 0.0f}, {2.0f, 6.0f, 10.0f} });
+        objectPtr->GetComponent<Collider>()->SetTrigger(true);
         AddObj(objectPtr);
     }
  
@@ -619,13 +678,12 @@ void Scene::BuildBaseStage()
 
 void Scene::BuildGodStage()
 {
-    m_current_stage = L"God";
     Object* objectPtr = nullptr;
 
     // ī޶
     {
-        mMainCameraId = AllocateId();
-        objectPtr = new CameraObject(this, mMainCameraId);
+        m_stageBuild->mainCameraId = AllocateId();
+        objectPtr = new CameraObject(this, m_stageBuild->mainCameraId);
         objectPtr->AddComponent(new Transform{ {0.0f, 0.0f, 0.0f} });
         AddObj(objectPtr);
     }
@@ -638,9 +696,10 @@ void Scene::BuildGodStage()
         objectPtr->AddComponent(new AdjustTransform{ {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {scale, scale, scale} });
         objectPtr->AddComponent(new Mesh{ "1P(boy-idle).fbx" });
         objectPtr->AddComponent(new Texture{ L"boy" , 1.0f, 0.4f });
-        objectPtr->AddComponent(new Animation{ "1P(boy-idle).fbx" });
+        objectPtr->AddComponent(new Animation{ m_resourceManager->GetAnimationSet("1P(boy-idle).fbx"), BOY_IDLE });
         objectPtr->AddComponent(new Gravity);
         objectPtr->AddComponent(new Collider{ {0.0f, 80.0f * scale, 0.0f}, {30.0f * scale, 80.0f * scale, 30.0f * scale} });
+        objectPtr->GetComponent<Collider>()->SetActivator(true);
         AddObj(objectPtr);
     }
 
@@ -722,6 +781,7 @@ void Scene::BuildGodStage()
         objectPtr->AddComponent(new Texture{ L"axe", 1.0f, 0.4f });
         objectPtr->AddComponent(new Gravity);
         objectPtr->AddComponent(new Collider{ {0.0f, 0.2f * scale, 0.0f}, {0.1f * scale, 0.2f * scale, 0.05f * scale} });
+        objectPtr->GetComponent<Collider>()->SetTrigger(true);
         AddObj(objectPtr);
     }
 
@@ -919,13 +979,12 @@ void Scene::BuildGodStage()
 
 void Scene::BuildEndStage()
 {
-    m_current_stage = L"End";
     Object* objectPtr = nullptr;
 
     // ī޶
     {
-        mMainCameraId = AllocateId();
-        objectPtr = new CameraObject(this, mMainCameraId);
+        m_stageBuild->mainCameraId = AllocateId();
+        objectPtr = new CameraObject(this, m_stageBuild->mainCameraId);
         objectPtr->AddComponent(new Transform{ {0.0f, 0.0f, 0.0f} });
         AddObj(objectPtr);
     }
@@ -938,9 +997,10 @@ void Scene::BuildEndStage()
         objectPtr->AddComponent(new AdjustTransform{ {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {scale, scale, scale} });
         objectPtr->AddComponent(new Mesh{ "1P(boy-idle).fbx" });
         objectPtr->AddComponent(new Texture{ L"boy" , 1.0f, 0.4f });
-        objectPtr->AddComponent(new Animation{ "1P(boy-idle).fbx" });
+        objectPtr->AddComponent(new Animation{ m_resourceManager->GetAnimationSet("1P(boy-idle).fbx"), BOY_IDLE });
         objectPtr->AddComponent(new Gravity);
         objectPtr->AddComponent(new Collider{ {0.0f, 80.0f * scale, 0.0f}, {30.0f * scale, 80.0f * scale, 30.0f * scale} });
+        objectPtr->GetComponent<Collider>()->SetActivator(true);
         AddObj(objectPtr);
     }
 
@@ -949,7 +1009,7 @@ void Scene::BuildEndStage()
         float scale = 0.2f;
         float ratio = GetAspectRatio();
         float tan30 = 0.57735f;
-        objectPtr = new TitleQuadObject(this, AllocateId(), mMainCameraId);
+        objectPtr = new TitleQuadObject(this, AllocateId(), m_stageBuild->mainCameraId);
         objectPtr->AddComponent(new Transform{ {-tan30 * ratio * scale, -tan30 * scale, 1.0f * scale}, {-90.0f, 0.0f, 0.0f}, {tan30 * 2.0f * ratio * scale, 1.0f, tan30 * 2.0f * scale} });
         objectPtr->AddComponent(new Mesh{ "Quad" });
         objectPtr->AddComponent(new Texture{ L"End", -1.0f, 0.4f });
@@ -960,15 +1020,15 @@ void Scene::BuildEndStage()
 
 void Scene::BuildUI()
 {
-    if (m_current_stage == L"Title") return;
-    if (m_current_stage == L"End") return;
+    if (m_stageBuild->stage == L"Title") return;
+    if (m_stageBuild->stage == L"End") return;
     // UI
     Object* objectPtr = nullptr;
 
     float depthFactor = 0.2f;
     float scale = 0.1f;
     float textureRatio = 420.0f / 112.0f; // ؽó 
-    objectPtr = new LifeQuadObject(this, AllocateId(), mMainCameraId);
+    objectPtr = new LifeQuadObject(this, AllocateId(), m_stageBuild->mainCameraId);
     objectPtr->AddComponent(new Transform{ {-0.8f * depthFactor, 0.4f * depthFactor, 1.0f * depthFactor}, {-90.0f, 0.0f, 0.0f}, {depthFactor * textureRatio * scale, 1.0f, depthFactor * scale} });
     objectPtr->AddComponent(new Mesh{ "Quad" });
     objectPtr->AddComponent(new Texture{ L"Life3", -1.0f, 0.4f });
@@ -976,7 +1036,7 @@ void Scene::BuildUI()
 
     scale = 0.15;
     textureRatio = 256.0f / 256.0f; // ؽó 
-    objectPtr = new BoyIconQuadObject(this, AllocateId(), mMainCameraId);
+    objectPtr = new BoyIconQuadObject(this, AllocateId(), m_stageBuild->mainCameraId);
     objectPtr->AddComponent(new Transform{ {-1.0f * depthFactor, 0.4f * depthFactor, 1.0f * depthFactor}, {-90.0f, 0.0f, 0.0f}, {depthFactor * textureRatio * scale, 1.0f, depthFactor * scale} });
     objectPtr->AddComponent(new Mesh{ "Quad" });
     objectPtr->AddComponent(new Texture{ L"BoyIcon", -1.0f, 0.4f });
@@ -984,18 +1044,18 @@ void Scene::BuildUI()
 
     scale = 0.25;
     textureRatio = 256.0f / 328.0f; // ؽó 
-    objectPtr = new RiceCakeQuadObject(this, AllocateId(), mMainCameraId);
+    objectPtr = new RiceCakeQuadObject(this, AllocateId(), m_stageBuild->mainCameraId);
     objectPtr->AddComponent(new Transform{ {-1.0f * depthFactor, -0.55f * depthFactor, 1.0f * depthFactor}, {-90.0f, 0.0f, 0.0f}, {depthFactor * textureRatio * scale, 1.0f, depthFactor * scale} });
     objectPtr->AddComponent(new Mesh{ "Quad" });
     objectPtr->AddComponent(new Texture{ L"RiceCake0", -1.0f, 0.4f });
     AddObj(objectPtr);
 
 
-    if (m_current_stage == L"God")
+    if (m_stageBuild->stage == L"God")
     {
         scale = 0.25;
         textureRatio = 1024.0f / 1024.0f; // ؽó 
-        objectPtr = new PuzzleQuestObject(this, AllocateId(), mMainCameraId);
+        objectPtr = new PuzzleQuestObject(this, AllocateId(), m_stageBuild->mainCameraId);
         objectPtr->AddComponent(new Transform{ {0.7f * depthFactor, -0.55f * depthFactor, 1.0f * depthFactor}, {-90.0f, 0.0f, 0.0f}, {depthFactor * textureRatio * scale, 1.0f, depthFactor * scale} });
         objectPtr->AddComponent(new Mesh{ "Quad" });
         objectPtr->AddComponent(new Texture{ L"PuzzleFrame", -1.0f, 0.4f });
@@ -1005,7 +1065,7 @@ void Scene::BuildUI()
     {
         scale = 0.25;
         textureRatio = 256.0f / 256.0f; // ؽó 
-        objectPtr = new TigerLeatherQuadObject(this, AllocateId(), mMainCameraId);
+        objectPtr = new TigerLeatherQuadObject(this, AllocateId(), m_stageBuild->mainCameraId);
         objectPtr->AddComponent(new Transform{ {0.7f * depthFactor, -0.55f * depthFactor, 1.0f * depthFactor}, {-90.0f, 0.0f, 0.0f}, {depthFactor * textureRatio * scale, 1.0f, depthFactor * scale} });
         objectPtr->AddComponent(new Mesh{ "Quad" });
         objectPtr->AddComponent(new Texture{ L"White", -1.0f, 0.4f });
@@ -1015,13 +1075,12 @@ void Scene::BuildUI()
 
 void Scene::BuildTitleStage()
 {
-    m_current_stage = L"Title";
     Object* objectPtr = nullptr;
 
     // ī޶
     {
-        mMainCameraId = AllocateId();
-        objectPtr = new CameraObject(this, mMainCameraId);
+        m_stageBuild->mainCameraId = AllocateId();
+        objectPtr = new CameraObject(this, m_stageBuild->mainCameraId);
         objectPtr->AddComponent(new Transform{ {0.0f, 0.0f, 0.0f} });
         AddObj(objectPtr);
     }
@@ -1034,9 +1093,10 @@ void Scene::BuildTitleStage()
         objectPtr->AddComponent(new AdjustTransform{ {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {scale, scale, scale} });
         objectPtr->AddComponent(new Mesh{ "1P(boy-idle).fbx" });
         objectPtr->AddComponent(new Texture{ L"boy" , 1.0f, 0.4f });
-        objectPtr->AddComponent(new Animation{ "1P(boy-idle).fbx" });
+        objectPtr->AddComponent(new Animation{ m_resourceManager->GetAnimationSet("1P(boy-idle).fbx"), BOY_IDLE });
         objectPtr->AddComponent(new Gravity);
         objectPtr->AddComponent(new Collider{ {0.0f, 80.0f * scale, 0.0f}, {30.0f * scale, 80.0f * scale, 30.0f * scale} });
+        objectPtr->GetComponent<Collider>()->SetActivator(true);
         AddObj(objectPtr);
     }
 
@@ -1045,7 +1105,7 @@ void Scene::BuildTitleStage()
         float scale = 0.2f;
         float ratio = GetAspectRatio();
         float tan30 = 0.57735f;
-        objectPtr = new TitleQuadObject(this, AllocateId(), mMainCameraId);
+        objectPtr = new TitleQuadObject(this, AllocateId(), m_stageBuild->mainCameraId);
         objectPtr->AddComponent(new Transform{ {-tan30 * ratio * scale, -tan30 * scale, 1.0f * scale}, {-90.0f, 0.0f, 0.0f}, {tan30 * 2.0f * ratio * scale, 1.0f, tan30 * 2.0f * scale} });
         objectPtr->AddComponent(new Mesh{ "Quad" });
         objectPtr->AddComponent(new Texture{ L"Title", -1.0f, 0.4f });
@@ -1059,12 +1119,42 @@ void Scene::BuildShadow()
     m_shadow = make_unique<Shadow>(this, 2048, 2048);
 }
 
+void Scene::BuildAI()
+{
+    m_aiScheduler = make_unique<AIScheduler>(this);
+    m_flowField = make_unique<FlowField>(this);
+}
+
+void Scene::BuildProjectileSystem(ID3D12Device* device)
+{
+    m_projectileSystem = make_unique<ProjectileSystem>(this, device);
+}
+
+void Scene::BuildPoseCache()
+{
+    m_poseCache = make_unique<PoseCache>();
+    // ߿. 60Hz  ð ߸  Ŭ  ȣ̵ ȷƮ  .
+    m_poseCache->SetTimeStep(1.0f / 60.0f);
+}
+
+void Scene::BuildAnimationSystem(ID3D12Device* device)
+{
+    //  嵵  ϹǷ ۾  ھ  - 1 
+    UINT coreCount = std::thread::hardware_concurrency();
+    m_animationSystem = make_unique<AnimationSystem>(this, device, coreCount > 1 ? coreCount - 1 : 0);
+}
+
 void Scene::BuildShaders()
 {
     m_shaders["VS_Opaque"] = CompileShader(L"Shaders/Opaque.hlsl", nullptr, "VS", "vs_5_1");
     m_shaders["PS_Opaque"] = CompileShader(L"Shaders/Opaque.hlsl", nullptr, "PS", "ps_5_1");
     m_shaders["VS_Shadow"] = CompileShader(L"Shaders/Shadow.hlsl", nullptr, "VS", "vs_5_1");
     m_shaders["PS_Shadow"] = CompileShader(L"Shaders/Shadow.hlsl", nullptr, "PS", "ps_5_1");
+
+    // νϽ̿. world  t2  νϽ  .
+    const D3D_SHADER_MACRO instanced[] = { { "INSTANCED", "1" }, { nullptr, nullptr } };
+    m_shaders["VS_OpaqueInstanced"] = CompileShader(L"Shaders/Opaque.hlsl", instanced, "VS", "vs_5_1");
+    m_shaders["VS_ShadowInstanced"] = CompileShader(L"Shaders/Shadow.hlsl", instanced, "VS", "vs_5_1");
 }
 
 void Scene::BuildInputElement()
@@ -1073,11 +1163,13 @@ void Scene::BuildInputElement()
     //m_inputElement.reserve(5);
     m_inputElement =
     {
+        // 0  : StaticVertex
         { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 24, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "WEIGHT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 32, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "BONEINDEX", 0, DXGI_FORMAT_R32G32B32A32_SINT, 0, 48, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
+        { "NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+        { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 16, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+        // 1  : SkinVertex. Ų  ޽ô   ιǷ 0  
+        { "WEIGHT", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 1, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+        { "BONEINDEX", 0, DXGI_FORMAT_R8G8B8A8_UINT, 1, 4, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
     };
 }
 
@@ -1105,13 +1197,15 @@ ComPtr<ID3DBlob> Scene::CompileShader(
     return byteCode;
 }
 
-void Scene::RenderObjects(ID3D12Device* device, ID3D12GraphicsCommandList* commandList)
+void Scene::RenderObjects(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, ePass pass)
 {
+    m_animationSystem->BindPalette(commandList);
     for (Object* obj : m_objects)
     {
         if (!obj->GetValid()) continue;
         obj->OnRender(device, commandList);
     }
+    m_projectileSystem->Render(device, commandList, pass);
 }
 
 char Scene::ClampToBounds(XMVECTOR& pos, XMVECTOR offset)
@@ -1159,6 +1253,23 @@ char Scene::ClampToBounds(XMVECTOR& pos, XMVECTOR offset)
     return outStatus;
 }
 
+float Scene::GetGroundHeight(float x, float z, float maxY)
+{
+    //  ̿, (x, z)   ü ݶ̴   maxY Ʒ   
+    float ground = get<1>(GetBounds(x, z));
+    for (Object* obj : m_objects)
+    {
+        if (!obj->GetValid()) continue;
+        Collider* collider = obj->GetComponent<Collider>();
+        if (!collider || !collider->IsActive() || collider->IsTrigger() || collider->IsActivator()) continue;
+        BoundingBox& AABB = collider->GetAABB();
+        if (fabs(x - AABB.Center.x) > AABB.Extents.x || fabs(z - AABB.Center.z) > AABB.Extents.z) continue;
+        float top = AABB.Center.y + AABB.Extents.y;
+        if (top <= maxY && top > ground) ground = top;
+    }
+    return ground;
+}
+
 std::tuple<float, float, float, float, float> Scene::GetBounds(float x, float z)
 {
     //  stage ´ ٿ ȯϱ
@@ -1182,7 +1293,7 @@ std::tuple<float, float, float, float, float> Scene::GetBounds(float x, float z)
         int height = rm.GetTerrainData().terrainHeight;
         int terrainScale = rm.GetTerrainData().terrainScale;
 
-        vector<Vertex>& vertexBuffer = rm.GetVertexBuffer();
+        vector<StaticVertex>& vertexBuffer = rm.GetVertexBuffer();
         UINT startVertex = rm.GetSubMeshData("HeightMap.raw").baseVertexLocation;
 
         int indexX = (int)(x / terrainScale);
@@ -1213,7 +1324,13 @@ std::tuple<float, float, float, float, float> Scene::GetBounds(float x, float z)
 
 int Scene::GetTextureIndex(wstring name)
 {
-    return m_texture_name_to_index.at(name);
+    int index = m_texture_name_to_index.at(name);
+    if (m_textureRefs[index] == 0) {
+        OutputDebugStringW((L"[Stage] texture " + name + L"  Ŵ佺Ʈ \n").c_str());
+        m_stageAssets.textures.push_back(name);
+        AcquireTexture(index);
+    }
+    return index;
 }
 
 std::tuple<XMVECTOR, float> Scene::GetCollisionData(BoundingOrientedBox OBB1, BoundingOrientedBox OBB2)
@@ -1302,31 +1419,206 @@ void Scene::BuildRandomPuzzleStatus()
 
 void Scene::ProcessStageQueue()
 {
-    if (m_stage_queue == L"") return;
+    if (m_stageBuild == nullptr) {
+        if (m_stage_queue != L"") StartStageBuild();
+        return;
+    }
+    if (m_stageBuild->done == false) return;
+    WaitStageBuild();
 
-    DeleteCurrentObjects();
-    if (m_stage_queue == L"Base")
+    if (m_stageBuild->assetsCommitted == false) {
+        CommitStageAssets();
+        RunStageBuild([this] { BuildStageObjects(); });
+        return;
+    }
+    SwapStage();
+}
+
+void Scene::StartStageBuild()
+{
+    m_stageBuild = make_unique<StageBuild>();
+    StageBuild& build = *m_stageBuild;
+    build.stage = m_stage_queue;
+    build.start = chrono::steady_clock::now();
+    m_stage_queue = L"";
+
+    // ö   ͸    ¸ Ƿ  忡 Ѵ
+    build.manifest = GetStageManifest(build.stage);
+    build.meshes = m_resourceManager->FindMissingMeshes(build.manifest.meshes);
+    for (const wstring& texture : build.manifest.textures) {
+        int index = m_texture_name_to_index.at(texture);
+        if (m_textureRefs[index] > 0 || m_textureBuffer_defaults[index] != nullptr) continue;
+        auto same = [index](const PreparedTexture& prepared) { return prepared.index == index; };
+        if (find_if(build.textures.begin(), build.textures.end(), same) != build.textures.end()) continue;
+        build.textures.push_back(PreparedTexture{ index });
+    }
+
+    ID3D12Device* device = m_parent->GetDevice();
+    RunStageBuild([this, device] {
+        StageBuild& build = *m_stageBuild;
+        if (build.meshes.IsEmpty() == false) m_resourceManager->PrepareMeshes(build.meshes, thread::hardware_concurrency());
+        for (PreparedTexture& texture : build.textures) PrepareTexture(device, texture);
+    });
+}
+
+void Scene::RunStageBuild(function<void()> work)
+{
+    m_stageBuild->done = false;
+    m_stageBuild->worker = thread([this, work] {
+        work();
+        m_stageBuild->done = true;
+    });
+}
+
+void Scene::WaitStageBuild()
+{
+    if (m_stageBuild && m_stageBuild->worker.joinable()) m_stageBuild->worker.join();
+}
+
+void Scene::FinishStageBuild()
+{
+    while (m_stageBuild) {
+        WaitStageBuild();
+        ProcessStageQueue();
+    }
+}
+
+void Scene::CommitStageAssets()
+{
+    //      ʴ´.  ޽ô  ڿ Ƿ  Ʈ ׸ ġ ״δ.
+    StageBuild& build = *m_stageBuild;
+    for (PreparedTexture& texture : build.textures) {
+        if (m_textureBuffer_defaults[texture.index] == nullptr) m_preparedTextures[texture.index] = move(texture);
+    }
+    build.textures.clear();
+    AcquireStageAssets(build.manifest, &build.meshes);
+    build.meshes = PreparedMeshes{};
+    build.assetsCommitted = true;
+}
+
+void Scene::BuildStageObjects()
+{
+    sStageBuildObjects = &m_stageBuild->objects;
+    const wstring& stage = m_stageBuild->stage;
+    if (stage == L"Base")
     {
         BuildBaseStage();
     }
-    else if (m_stage_queue == L"Hunting")
+    else if (stage == L"Hunting")
     {
         BuildHuntingStage();
     }
-    else if (m_stage_queue == L"God")
+    else if (stage == L"God")
     {
         BuildGodStage();
     }
-    else if (m_stage_queue == L"Title")
+    else if (stage == L"Title")
     {
         BuildTitleStage();
     }
-    else if (m_stage_queue == L"End")
+    else if (stage == L"End")
     {
         BuildEndStage();
     }
     BuildUI();
-    m_stage_queue = L"";
+    sStageBuildObjects = nullptr;
+}
+
+void Scene::SwapStage()
+{
+    unique_ptr<StageBuild> build = move(m_stageBuild);
+
+    DeleteCurrentObjects();
+    ClearHitboxes();
+    m_flowField->Reset();
+    m_projectileSystem->Clear();
+
+    m_current_stage = build->stage;
+    mMainCameraId = build->mainCameraId;
+    StageManifest previous = move(m_stageAssets);
+    m_stageAssets = move(build->manifest);
+    for (Object* obj : build->objects) {
+        AcquireMissingAssets(obj);
+        m_objects.push_back(obj);
+    }
+    ReleaseStageAssets(previous);
+
+    float seconds = chrono::duration<float>(chrono::steady_clock::now() - build->start).count();
+    OutputDebugStringW((L"[Stage] " + build->stage + L" : objects " + to_wstring(build->objects.size()) + L", " + to_wstring(seconds) + L"s\n").c_str());
+    m_resourceManager->ReportVertexMemory();
+    m_resourceManager->ReportAnimationMemory();
+}
+
+void Scene::AcquireStageAssets(const StageManifest& manifest, PreparedMeshes* meshes)
+{
+    m_resourceManager->AcquireMeshes(manifest.meshes, meshes);
+    for (const wstring& texture : manifest.textures) AcquireTexture(m_texture_name_to_index.at(texture));
+}
+
+void Scene::ReleaseStageAssets(const StageManifest& manifest)
+{
+    m_resourceManager->ReleaseMeshes(manifest.meshes);
+    for (const wstring& texture : manifest.textures) ReleaseTexture(m_texture_name_to_index.at(texture));
+}
+
+void Scene::AcquireMissingAssets(Object* object)
+{
+    Mesh* mesh = object->GetComponent<Mesh>();
+    if (mesh && !m_resourceManager->IsMeshResident(mesh->mName)) {
+        WaitStageBuild();   // ۾ 尡 ResourceManager  аų  ȿ ġ ʴ´
+        OutputDebugStringA(("[Stage] mesh " + mesh->mName + "  Ŵ佺Ʈ \n").c_str());
+        m_stageAssets.meshes.push_back(mesh->mName);
+        m_resourceManager->AcquireMeshes({ mesh->mName });
+    }
+    Texture* texture = object->GetComponent<Texture>();
+    if (texture) GetTextureIndex(texture->mName);
+}
+
+void Scene::AcquireTexture(int index)
+{
+    if (m_textureRefs[index]++ > 0) return;
+    if (m_textureBuffer_defaults[index] == nullptr) m_dirtyTextures.push_back(index);
+}
+
+void Scene::ReleaseTexture(int index)
+{
+    if (m_textureRefs[index] == 0) throw; // Acquire  Release
+    if (--m_textureRefs[index] > 0) return;
+    m_dirtyTextures.push_back(index);
+}
+
+void Scene::UpdateResidentResources(ID3D12Device* device, ID3D12GraphicsCommandList* commandList)
+{
+    for (int index : m_dirtyTextures) {
+        bool resident = m_textureBuffer_defaults[index] != nullptr;
+        if (m_textureRefs[index] > 0 && !resident) {
+            LoadTexture(device, commandList, index);
+        }
+        else if (m_textureRefs[index] == 0 && resident) {
+            m_textureBuffer_defaults[index].Reset();
+            m_textureBuffer_uploads[index].Reset();
+        }
+        else if (m_textureRefs[index] == 0) {
+            m_preparedTextures[index] = PreparedTexture{};
+            continue;
+        }
+        else {
+            continue;
+        }
+        BuildTextureBufferView(device, index);
+    }
+    m_dirtyTextures.clear();
+
+    if (m_geometryVersion != m_resourceManager->GetGeometryVersion()) {
+        //   ó ٽ ø, ƴϸ   ޽ø ø
+        bool rewrite = m_geometryLayoutVersion != m_resourceManager->GetGeometryLayoutVersion();
+        BuildVertexBuffer(device, commandList, rewrite);
+        BuildIndexBuffer(device, commandList, rewrite);
+        BuildVertexBufferView();
+        BuildIndexBufferView();
+        m_geometryVersion = m_resourceManager->GetGeometryVersion();
+        m_geometryLayoutVersion = m_resourceManager->GetGeometryLayoutVersion();
+    }
 }
 
 void Scene::CompactObjects()
@@ -1346,6 +1638,7 @@ void Scene::ProcessObjectQueue()
 {
     for (int i = 0; i < m_object_queue_index; ++i)
     {
+        AcquireMissingAssets(m_object_queue[i]);
         m_objects.push_back(m_object_queue[i]);
     }
     m_object_queue_index = 0;
@@ -1358,6 +1651,8 @@ uint32_t Scene::AllocateId()
 
 void Scene::SetStage(wstring stage)
 {
+    // ƮŴ  ȿ   θǷ  ִ  ٽ  ʴ´
+    if (m_stageBuild && m_stageBuild->stage == stage) return;
     m_stage_queue = stage;
 }
 
@@ -1414,6 +1709,11 @@ void Scene::DeleteCurrentObjects()
         delete obj;
     }
     m_objects.clear();
+    //     ä    Ʈ
+    for (int i = 0; i < m_object_queue_index; ++i) {
+        delete m_object_queue[i];
+    }
+    m_object_queue_index = 0;
 }
 
 void Scene::BuildRootSignature(ID3D12Device* device)
@@ -1434,11 +1734,13 @@ void Scene::BuildRootSignature(ID3D12Device* device)
     ranges[1].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 0);
     ranges[2].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 1, 0);
 
-    CD3DX12_ROOT_PARAMETER1 rootParameters[4] = {};
+    CD3DX12_ROOT_PARAMETER1 rootParameters[6] = {};
     rootParameters[0].InitAsDescriptorTable(1, &ranges[0], D3D12_SHADER_VISIBILITY_VERTEX);
     rootParameters[1].InitAsDescriptorTable(1, &ranges[1], D3D12_SHADER_VISIBILITY_PIXEL);
     rootParameters[2].InitAsConstantBufferView(1);
     rootParameters[3].InitAsDescriptorTable(1, &ranges[2], D3D12_SHADER_VISIBILITY_PIXEL);
+    rootParameters[4].InitAsShaderResourceView(2, 0, D3D12_ROOT_DESCRIPTOR_FLAG_NONE, D3D12_SHADER_VISIBILITY_VERTEX);
+    rootParameters[5].InitAsShaderResourceView(3, 0, D3D12_ROOT_DESCRIPTOR_FLAG_NONE, D3D12_SHADER_VISIBILITY_VERTEX);
 
     std::array<D3D12_STATIC_SAMPLER_DESC, 2> samplerDesc = {};
     D3D12_STATIC_SAMPLER_DESC* descPtr = nullptr;
@@ -1503,6 +1805,8 @@ void Scene::BuildPSO(ID3D12Device* device)
     psoDesc.SampleDesc.Count = 1;
     psoDesc.DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
     ThrowIfFailed(device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(m_PSOs["PSO_Opaque"].GetAddressOf())));
+    psoDesc.VS = CD3DX12_SHADER_BYTECODE(m_shaders.at("VS_OpaqueInstanced").Get());
+    ThrowIfFailed(device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(m_PSOs["PSO_OpaqueInstanced"].GetAddressOf())));
 
     psoDesc.RasterizerState.DepthBias = 10000;
     psoDesc.RasterizerState.DepthBiasClamp = 0.0f;
@@ -1512,86 +1816,132 @@ void Scene::BuildPSO(ID3D12Device* device)
     psoDesc.NumRenderTargets = 0;
     psoDesc.RTVFormats[0] = DXGI_FORMAT_UNKNOWN;
     ThrowIfFailed(device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(m_PSOs["PSO_Shadow"].GetAddressOf())));
+    psoDesc.VS = CD3DX12_SHADER_BYTECODE(m_shaders.at("VS_ShadowInstanced").Get());
+    ThrowIfFailed(device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(m_PSOs["PSO_ShadowInstanced"].GetAddressOf())));
 }
 
-void Scene::BuildVertexBuffer(ID3D12Device* device, ID3D12GraphicsCommandList* commandList)
+void Scene::BuildVertexBuffer(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, bool rewrite)
 {
-    const UINT vertexBufferSize = m_resourceManager->GetVertexBuffer().size() * sizeof(Vertex);
-    // Create the vertex buffer.
-    ThrowIfFailed(device->CreateCommittedResource(
-        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-        D3D12_HEAP_FLAG_NONE,
-        &CD3DX12_RESOURCE_DESC::Buffer(vertexBufferSize),
-        D3D12_RESOURCE_STATE_COMMON,
-        nullptr,
-        IID_PPV_ARGS(m_vertexBuffer_default.GetAddressOf())));
-
-    ThrowIfFailed(device->CreateCommittedResource(
-        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
-        D3D12_HEAP_FLAG_NONE,
-        &CD3DX12_RESOURCE_DESC::Buffer(vertexBufferSize),
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        nullptr,
-        IID_PPV_ARGS(m_vertexBuffer_upload.GetAddressOf())));
-
-    D3D12_SUBRESOURCE_DATA subResourceData{};
-    subResourceData.pData = m_resourceManager->GetVertexBuffer().data();
-    subResourceData.RowPitch = vertexBufferSize;
-    subResourceData.SlicePitch = subResourceData.RowPitch;
-
-    commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(m_vertexBuffer_default.Get(),
-        D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST));
-    UpdateSubresources(commandList, m_vertexBuffer_default.Get(), m_vertexBuffer_upload.Get(), 0, 0, 1, &subResourceData);
-    commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(m_vertexBuffer_default.Get(),
-        D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_GENERIC_READ));
+    vector<StaticVertex>& vertices = m_resourceManager->GetVertexBuffer();
+    vector<SkinVertex>& skinVertices = m_resourceManager->GetSkinVertexBuffer();
+    UploadGeometry(device, commandList, m_vertexBuffer, vertices.data(), vertices.size() * sizeof(StaticVertex), rewrite);
+    UploadGeometry(device, commandList, m_skinVertexBuffer, skinVertices.data(), skinVertices.size() * sizeof(SkinVertex), rewrite);
 }
 
-void Scene::BuildIndexBuffer(ID3D12Device* device, ID3D12GraphicsCommandList* commandList)
+void Scene::BuildIndexBuffer(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, bool rewrite)
 {
-    // Create the index buffer.
-    const UINT indexBufferSize = m_resourceManager->GetIndexBuffer().size() * sizeof(uint32_t);
+    vector<uint32_t>& indices = m_resourceManager->GetIndexBuffer();
+    vector<uint16_t>& indices16 = m_resourceManager->GetIndexBuffer16();
+    UploadGeometry(device, commandList, m_indexBuffer, indices.data(), indices.size() * sizeof(uint32_t), rewrite);
+    UploadGeometry(device, commandList, m_indexBuffer16, indices16.data(), indices16.size() * sizeof(uint16_t), rewrite);
+}
 
-    ThrowIfFailed(device->CreateCommittedResource(
-        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-        D3D12_HEAP_FLAG_NONE,
-        &CD3DX12_RESOURCE_DESC::Buffer(indexBufferSize),
-        D3D12_RESOURCE_STATE_COMMON,
-        nullptr,
-        IID_PPV_ARGS(m_indexBuffer_default.GetAddressOf())));
+void Scene::UploadGeometry(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, GeometryBuffer& geometry, const void* data, UINT64 size, bool rewrite)
+{
+    // ڶ  1.5  ٽ   ø.  Ʈ 並   ְ ּ ũ  д.
+    UINT64 offset = rewrite ? 0 : geometry.size;
+    if (geometry.buffer == nullptr || size > geometry.capacity) {
+        geometry.capacity = max(max(size, 65536ull), geometry.capacity + geometry.capacity / 2);
+        ThrowIfFailed(device->CreateCommittedResource(
+            &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+            D3D12_HEAP_FLAG_NONE,
+            &CD3DX12_RESOURCE_DESC::Buffer(geometry.capacity),
+            D3D12_RESOURCE_STATE_COMMON,
+            nullptr,
+            IID_PPV_ARGS(geometry.buffer.ReleaseAndGetAddressOf())));
+        offset = 0;
+        geometry.state = D3D12_RESOURCE_STATE_COMMON;
+    }
+    geometry.size = size;
+    if (offset >= size) {
+        // ⸸  ø  .    ۵ б ·δ Ű д.
+        if (geometry.state != D3D12_RESOURCE_STATE_GENERIC_READ) {
+            commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(geometry.buffer.Get(),
+                geometry.state, D3D12_RESOURCE_STATE_GENERIC_READ));
+            geometry.state = D3D12_RESOURCE_STATE_GENERIC_READ;
+        }
+        return;
+    }
 
+    UINT64 copySize = size - offset;
     ThrowIfFailed(device->CreateCommittedResource(
         &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
         D3D12_HEAP_FLAG_NONE,
-        &CD3DX12_RESOURCE_DESC::Buffer(indexBufferSize),
+        &CD3DX12_RESOURCE_DESC::Buffer(copySize),
         D3D12_RESOURCE_STATE_GENERIC_READ,
         nullptr,
-        IID_PPV_ARGS(m_indexBuffer_upload.GetAddressOf())));
-
-    D3D12_SUBRESOURCE_DATA subResourceData = {};
-    subResourceData.pData = m_resourceManager->GetIndexBuffer().data();
-    subResourceData.RowPitch = indexBufferSize;
-    subResourceData.SlicePitch = subResourceData.RowPitch;
-
-    commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(m_indexBuffer_default.Get(),
-        D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST));
-    UpdateSubresources(commandList, m_indexBuffer_default.Get(), m_indexBuffer_upload.Get(), 0, 0, 1, &subResourceData);
-    commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(m_indexBuffer_default.Get(),
+        IID_PPV_ARGS(geometry.upload.ReleaseAndGetAddressOf())));
+    void* mapped = nullptr;
+    CD3DX12_RANGE readRange(0, 0);
+    ThrowIfFailed(geometry.upload->Map(0, &readRange, &mapped));
+    memcpy(mapped, static_cast<const uint8_t*>(data) + offset, copySize);
+    geometry.upload->Unmap(0, nullptr);
+
+    commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(geometry.buffer.Get(),
+        geometry.state, D3D12_RESOURCE_STATE_COPY_DEST));
+    commandList->CopyBufferRegion(geometry.buffer.Get(), offset, geometry.upload.Get(), 0, copySize);
+    commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(geometry.buffer.Get(),
         D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_GENERIC_READ));
+    geometry.state = D3D12_RESOURCE_STATE_GENERIC_READ;
 }
 
 void Scene::BuildVertexBufferView()
 {
     // Initialize the vertex buffer view.
-    m_vertexBufferView.BufferLocation = m_vertexBuffer_default->GetGPUVirtualAddress();
-    m_vertexBufferView.StrideInBytes = sizeof(Vertex);
-    m_vertexBufferView.SizeInBytes = m_resourceManager->GetVertexBuffer().size() * sizeof(Vertex);
+    m_vertexBufferView.BufferLocation = m_vertexBuffer.buffer->GetGPUVirtualAddress();
+    m_vertexBufferView.StrideInBytes = sizeof(StaticVertex);
+    m_vertexBufferView.SizeInBytes = (UINT)m_vertexBuffer.size;
+
+    m_skinVertexBufferView.BufferLocation = m_skinVertexBuffer.buffer->GetGPUVirtualAddress();
+    m_skinVertexBufferView.StrideInBytes = sizeof(SkinVertex);
+    m_skinVertexBufferView.SizeInBytes = (UINT)m_skinVertexBuffer.size;
+}
+
+void Scene::BindVertexBuffers(ID3D12GraphicsCommandList* commandList)
+{
+    D3D12_VERTEX_BUFFER_VIEW views[] = { m_vertexBufferView, {} };
+    commandList->IASetVertexBuffers(0, _countof(views), views);
+    m_meshVertexBuffersBound = false;
 }
 
 void Scene::BuildIndexBufferView()
 {
-    m_indexBufferView.BufferLocation = m_indexBuffer_default->GetGPUVirtualAddress();
+    m_indexBufferView.BufferLocation = m_indexBuffer.buffer->GetGPUVirtualAddress();
     m_indexBufferView.Format = DXGI_FORMAT_R32_UINT;
-    m_indexBufferView.SizeInBytes = m_resourceManager->GetIndexBuffer().size() * sizeof(uint32_t);
+    m_indexBufferView.SizeInBytes = (UINT)m_indexBuffer.size;
+
+    m_indexBufferView16.BufferLocation = m_indexBuffer16.buffer->GetGPUVirtualAddress();
+    m_indexBufferView16.Format = DXGI_FORMAT_R16_UINT;
+    m_indexBufferView16.SizeInBytes = (UINT)m_indexBuffer16.size;
+}
+
+void Scene::DrawSubMesh(ID3D12GraphicsCommandList* commandList, const SubMeshData& data, UINT instanceCount)
+{
+    // Ų Ʈ Ų ޽ó  ־  ȣ  Ʈ ٸ.
+    // ׷ Ų ޽ô  Ʈ ޽ ù  Ű  0   ׸.
+    UINT startVertexLocation = data.startVertexLocation;
+    UINT baseVertexLocation = data.baseVertexLocation;
+    if (data.skinVertexLocation != -1) {
+        D3D12_VERTEX_BUFFER_VIEW views[] = { m_vertexBufferView, m_skinVertexBufferView };
+        views[0].BufferLocation += data.startVertexLocation * sizeof(StaticVertex);
+        views[0].SizeInBytes = data.vertexCountPerInstance * sizeof(StaticVertex);
+        views[1].BufferLocation += data.skinVertexLocation * sizeof(SkinVertex);
+        views[1].SizeInBytes = data.vertexCountPerInstance * sizeof(SkinVertex);
+        commandList->IASetVertexBuffers(0, _countof(views), views);
+        m_meshVertexBuffersBound = true;
+        startVertexLocation = 0;
+        baseVertexLocation = 0;
+    }
+    else if (m_meshVertexBuffersBound) {
+        BindVertexBuffers(commandList);
+    }
+
+    if (data.startIndexLocation == -1) {
+        commandList->DrawInstanced(data.vertexCountPerInstance, instanceCount, startVertexLocation, 0);
+        return;
+    }
+    commandList->IASetIndexBuffer(data.indexFormat == DXGI_FORMAT_R16_UINT ? &m_indexBufferView16 : &m_indexBufferView);
+    commandList->DrawIndexedInstanced(data.indexCountPerInstance, instanceCount, data.startIndexLocation, baseVertexLocation, 0);
 }
 
 void Scene::BuildDescriptorHeap(ID3D12Device* device)
@@ -1637,68 +1987,75 @@ void Scene::BuildConstantBufferView(ID3D12Device* device)
 
 }
 
-void Scene::BuildTextureBuffer(ID3D12Device* device, ID3D12GraphicsCommandList* commandList)
+void Scene::PrepareTexture(ID3D12Device* device, PreparedTexture& texture)
 {
     // Create the texture.
-    for(auto& fileName: m_DDSFileName)
-    {
-        ComPtr<ID3D12Resource> defaultBuffer;
-        ComPtr<ID3D12Resource> uploadBuffer;
+    const wstring& fileName = m_DDSFileName[texture.index];
+    //   ./Textures/ Ʒ ASCII η  ִ. (AssetCooker::HashRawFiles)
+    string path;
+    for (wchar_t c : fileName) path += static_cast<char>(c);
+    m_resourceManager->VerifyRawFile(path);
 
-        // DDSTexture  ϴ 
-        unique_ptr<uint8_t[]> ddsData;
-        vector<D3D12_SUBRESOURCE_DATA> subresources;
-        ThrowIfFailed(LoadDDSTextureFromFile(device, fileName.c_str(), defaultBuffer.GetAddressOf(), ddsData, subresources));
+    // DDSTexture  ϴ 
+    ThrowIfFailed(LoadDDSTextureFromFile(device, fileName.c_str(), texture.defaultBuffer.GetAddressOf(), texture.ddsData, texture.subresources));
 
-        //// DirectTex ϴ 
-        //ScratchImage image;
-        //TexMetadata metadata;
+    //// DirectTex ϴ 
+    //ScratchImage image;
+    //TexMetadata metadata;
 
-        //ThrowIfFailed(LoadFromDDSFile(L"./Textures/grass.dds", DDS_FLAGS_NONE, &metadata, image));
-        ////metadata = image.GetMetadata(); // ڵ带 ϰ  ڵ 3° ڸ nullptr ص ȴ.
+    //ThrowIfFailed(LoadFromDDSFile(L"./Textures/grass.dds", DDS_FLAGS_NONE, &metadata, image));
+    ////metadata = image.GetMetadata(); // ڵ带 ϰ  ڵ 3° ڸ nullptr ص ȴ.
 
-        //ThrowIfFailed(CreateTexture(device, metadata, m_textureBuffer_default.GetAddressOf()));
-        //ThrowIfFailed(PrepareUpload(device, image.GetImages(), image.GetImageCount(), metadata, subresources));
+    //ThrowIfFailed(CreateTexture(device, metadata, m_textureBuffer_default.GetAddressOf()));
+    //ThrowIfFailed(PrepareUpload(device, image.GetImages(), image.GetImageCount(), metadata, subresources));
 
-        const UINT64 uploadBufferSize = GetRequiredIntermediateSize(defaultBuffer.Get(), 0, subresources.size());
-        
-        OutputDebugStringA(string{ "current texture subresource size = " + to_string(subresources.size()) + "\n"}.c_str());
-        OutputDebugStringA(string{ "current texture mip level = " + to_string(defaultBuffer->GetDesc().MipLevels) + "\n"}.c_str());
-        OutputDebugStringA(string{ "current texture format = " + to_string(defaultBuffer->GetDesc().Format) + "\n"}.c_str());
+    const UINT64 uploadBufferSize = GetRequiredIntermediateSize(texture.defaultBuffer.Get(), 0, texture.subresources.size());
 
-        // Create the GPU upload buffer.
-        ThrowIfFailed(device->CreateCommittedResource(
-            &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
-            D3D12_HEAP_FLAG_NONE,
-            &CD3DX12_RESOURCE_DESC::Buffer(uploadBufferSize),
-            D3D12_RESOURCE_STATE_GENERIC_READ,
-            nullptr,
-            IID_PPV_ARGS(uploadBuffer.GetAddressOf())));
-        
-        UpdateSubresources(commandList, defaultBuffer.Get(), uploadBuffer.Get(), 0, 0, static_cast<UINT>(subresources.size()), subresources.data());
-        commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(defaultBuffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE));
+    OutputDebugStringA(string{ "current texture subresource size = " + to_string(texture.subresources.size()) + "\n"}.c_str());
+    OutputDebugStringA(string{ "current texture mip level = " + to_string(texture.defaultBuffer->GetDesc().MipLevels) + "\n"}.c_str());
+    OutputDebugStringA(string{ "current texture format = " + to_string(texture.defaultBuffer->GetDesc().Format) + "\n"}.c_str());
 
-        m_textureBuffer_defaults.push_back(move(defaultBuffer));
-        m_textureBuffer_uploads.push_back(move(uploadBuffer));
+    // Create the GPU upload buffer.
+    ThrowIfFailed(device->CreateCommittedResource(
+        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
+        D3D12_HEAP_FLAG_NONE,
+        &CD3DX12_RESOURCE_DESC::Buffer(uploadBufferSize),
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        nullptr,
+        IID_PPV_ARGS(texture.uploadBuffer.GetAddressOf())));
+}
+
+void Scene::LoadTexture(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, int index)
+{
+    //    ̸ о  ʾ ⼭ д´
+    PreparedTexture texture = move(m_preparedTextures[index]);
+    m_preparedTextures[index] = PreparedTexture{};
+    if (texture.defaultBuffer == nullptr) {
+        texture.index = index;
+        PrepareTexture(device, texture);
     }
+
+    UpdateSubresources(commandList, texture.defaultBuffer.Get(), texture.uploadBuffer.Get(), 0, 0, static_cast<UINT>(texture.subresources.size()), texture.subresources.data());
+    commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(texture.defaultBuffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE));
+
+    m_textureBuffer_defaults[index] = move(texture.defaultBuffer);
+    m_textureBuffer_uploads[index] = move(texture.uploadBuffer);
 }
 
-void Scene::BuildTextureBufferView(ID3D12Device* device)
+void Scene::BuildTextureBufferView(ID3D12Device* device, int index)
 {
     // Describe and create a SRV for the texture.
-    for (int i = 0; i < m_DDSFileName.size(); ++i)
-    {
-        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
-        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-        srvDesc.Format = m_textureBuffer_defaults[i]->GetDesc().Format;
-        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-        srvDesc.Texture2D.MipLevels = m_textureBuffer_defaults[i]->GetDesc().MipLevels;
+    ID3D12Resource* texture = m_textureBuffer_defaults[index].Get();
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc.Format = texture ? texture->GetDesc().Format : DXGI_FORMAT_R8G8B8A8_UNORM;
+    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MipLevels = texture ? texture->GetDesc().MipLevels : 1;
 
-        CD3DX12_CPU_DESCRIPTOR_HANDLE hDescriptor(m_descriptorHeap->GetCPUDescriptorHandleForHeapStart());
-        hDescriptor.Offset(1 + i, m_cbvsrvuavDescriptorSize); // 1 + i   1 ǹ̴   constant buffer view  ̴.     
+    CD3DX12_CPU_DESCRIPTOR_HANDLE hDescriptor(m_descriptorHeap->GetCPUDescriptorHandleForHeapStart());
+    hDescriptor.Offset(1 + index, m_cbvsrvuavDescriptorSize); // 1 + index  1 ǹ̴   constant buffer view  ̴.     
 
-        device->CreateShaderResourceView(m_textureBuffer_defaults[i].Get(), &srvDesc, hDescriptor);
-    }
+    device->CreateShaderResourceView(texture, &srvDesc, hDescriptor);
 }
 
 UINT Scene::CalcConstantBufferByteSize(UINT byteSize)
@@ -1718,10 +2075,34 @@ UINT Scene::GetNumOfTexture()
 
 void Scene::AddObj(Object* object)
 {
+    if (sStageBuildObjects) {
+        sStageBuildObjects->push_back(object);
+        return;
+    }
     if (m_object_queue_index > MAX_QUEUE - 1) throw; // 
     m_object_queue[m_object_queue_index++] = object;
 }
 
+void Scene::AddHitbox(uint32_t ownerId, XMFLOAT3&& center, XMFLOAT3&& extents, float duration, std::function<void(Object&)> onHit)
+{
+    for (Hitbox& hitbox : m_hitboxes)
+    {
+        if (hitbox.active) continue;
+        hitbox.active = true;
+        hitbox.ownerId = ownerId;
+        hitbox.localOBB = BoundingOrientedBox{ std::move(center), std::move(extents), XMFLOAT4{ 0.0f, 0.0f, 0.0f, 1.0f } };
+        hitbox.remainTime = duration;
+        hitbox.onHit = std::move(onHit);
+        hitbox.hitCount = 0;
+
+        // ̹  浹 ó ٷ   ְ  OBB  ä д.
+        Object* owner = GetObjFromId(ownerId);
+        if (owner) hitbox.localOBB.Transform(hitbox.worldOBB, owner->GetComponent<Transform>()->GetFinalM());
+        return;
+    }
+    throw; // 
+}
+
 void Scene::BuildProjMatrix()
 {
     XMMATRIX proj = XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), m_viewport.Width / m_viewport.Height, 0.1f, 1500.0f);
@@ -1754,53 +2135,15 @@ void Scene::ProcessInput()
 
 void Scene::LoadMeshAnimationTexture()
 {
+    // ⼭ ̸ ϰ,  д    . (GetStageManifest)
+    // fbx ϰ   Ŀ  . (AssetCooker.cpp)
     m_resourceManager = make_unique<ResourceManager>();
-    m_resourceManager->CreatePlane("Plane", 1000, 30);
-    m_resourceManager->CreatePlane("HalfPlane", 500, 5);
-    m_resourceManager->CreatePlane("Quad", 1, 1);
-    m_resourceManager->CreateTerrain("HeightMap.raw", 50, 5, 50);
-    m_resourceManager->LoadFbx("1P(boy-idle).fbx", false, true);
-    m_resourceManager->LoadFbx("boy_walk_fix.fbx", true, true);
-    m_resourceManager->LoadFbx("boy_run_fix.fbx", true, true);
-    m_resourceManager->LoadFbx("boy_pickup_fix.fbx", true, true);
-    m_resourceManager->LoadFbx("boy_attack(45).fbx", true, true);
-    m_resourceManager->LoadFbx("boy_hit.fbx", true, true);
-    m_resourceManager->LoadFbx("boy_dying_fix.fbx", true, true);
-    m_resourceManager->LoadFbx("boy_throw.fbx", true, true);
-
-    m_resourceManager->LoadFbx("god_idle.fbx", false, true);
-    m_resourceManager->LoadFbx("sister_idle_fix.fbx", false, true);
-
-    m_resourceManager->LoadFbx("0113_tiger.fbx", false, true);
-    m_resourceManager->LoadFbx("0722_tiger_idle2.fbx", true, true);
-    m_resourceManager->LoadFbx("0113_tiger_walk.fbx", true, true);
-    m_resourceManager->LoadFbx("0722_tiger_run.fbx", true, true);
-    m_resourceManager->LoadFbx("0208_tiger_attack.fbx", true, true);
-    m_resourceManager->LoadFbx("0208_tiger_hit.fbx", true, true);
-    m_resourceManager->LoadFbx("0208_tiger_dying.fbx", true, true);
-
-    m_resourceManager->LoadFbx("long_tree.fbx", false, true);
-    m_resourceManager->LoadFbx("normal_tree.fbx", false, true);
-
-    m_resourceManager->LoadFbx("broken_house.fbx", false, true);
-    m_resourceManager->LoadFbx("broken_house2.fbx", false, true);
-    m_resourceManager->LoadFbx("background_house.fbx", false, true);
-
-    m_resourceManager->LoadFbx("table.fbx", false, true);
-    m_resourceManager->LoadFbx("well.fbx", false, true);
-    m_resourceManager->LoadFbx("fence.fbx", false, true);
-
-    m_resourceManager->LoadFbx("cloud1.fbx", false, true);
-    m_resourceManager->LoadFbx("cloud2.fbx", false, true);
-    m_resourceManager->LoadFbx("cloud3.fbx", false, true);
-    m_resourceManager->LoadFbx("cloud4.fbx", false, true);
-
-    m_resourceManager->LoadFbx("tiger_leather.fbx", false, true);
-    m_resourceManager->LoadFbx("axe.fbx", false, true);
-    m_resourceManager->LoadFbx("wood.fbx", false, true);
-    m_resourceManager->LoadFbx("ricecake.fbx", false, true);
-
-    m_resourceManager->LoadFbx("grass_low.fbx", false, true);
+    ResourceManager* rm = m_resourceManager.get();
+    //  ޽ô  ۾ 忡 Ƿ ResourceManager  ǵ帮 ʴ´
+    rm->DeclareMesh("Plane", [](PreparedMesh& mesh) { ResourceManager::CreatePlane(1000, 30, mesh); });
+    rm->DeclareMesh("HalfPlane", [](PreparedMesh& mesh) { ResourceManager::CreatePlane(500, 5, mesh); });
+    rm->DeclareMesh("Quad", [](PreparedMesh& mesh) { ResourceManager::CreatePlane(1, 1, mesh); });
+    rm->DeclareMesh("HeightMap.raw", [](PreparedMesh& mesh) { ResourceManager::CreateTerrain("HeightMap.raw", 50, 5, 50, mesh); }, "./HeightMap.raw");
 
     int i = 0;
     m_DDSFileName.push_back(L"./Textures/boy.dds");
@@ -1902,6 +2245,11 @@ void Scene::LoadMeshAnimationTexture()
     m_texture_name_to_index.insert({ L"PuzzleO", i++ });
     m_DDSFileName.push_back(L"./Textures/PuzzleX.dds");
     m_texture_name_to_index.insert({ L"PuzzleX", i++ });
+
+    m_textureRefs.resize(m_DDSFileName.size());
+    m_textureBuffer_defaults.resize(m_DDSFileName.size());
+    m_textureBuffer_uploads.resize(m_DDSFileName.size());
+    m_preparedTextures.resize(m_DDSFileName.size());
 }
 
 // Update frame-based values.
@@ -1911,11 +2259,15 @@ void Scene::OnUpdate(GameTimer& gTimer)
     ProcessStageQueue();
     CompactObjects();
     ProcessObjectQueue();
+    m_aiScheduler->Schedule(m_objects, gTimer.DeltaTime());
     for (Object* obj : m_objects)
     {
         if (!obj->GetValid()) continue;
         obj->OnUpdate(gTimer);
     }
+    m_flowField->Update(m_objects);
+    m_projectileSystem->Update(gTimer.DeltaTime());
+    UpdateHitboxes(gTimer.DeltaTime());
 
     m_shadow->UpdateShadow();
 
@@ -1930,6 +2282,7 @@ void Scene::OnRender(ID3D12Device* device, ID3D12GraphicsCommandList* commandLis
     {
     case ePass::Shadow:
     {
+        UpdateResidentResources(device, commandList);
         commandList->SetGraphicsRootSignature(m_rootSignature.Get());
         ID3D12DescriptorHeap* ppHeaps[] = { m_descriptorHeap.Get() };
         commandList->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
@@ -1937,7 +2290,7 @@ void Scene::OnRender(ID3D12Device* device, ID3D12GraphicsCommandList* commandLis
         CD3DX12_GPU_DESCRIPTOR_HANDLE hDescriptor(m_descriptorHeap->GetGPUDescriptorHandleForHeapStart());
         commandList->SetGraphicsRootDescriptorTable(0, hDescriptor);
         commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-        commandList->IASetVertexBuffers(0, 1, &m_vertexBufferView);
+        BindVertexBuffers(commandList);
         commandList->IASetIndexBuffer(&m_indexBufferView);
         m_shadow->DrawShadowMap();
         break;
@@ -1948,7 +2301,7 @@ void Scene::OnRender(ID3D12Device* device, ID3D12GraphicsCommandList* commandLis
         commandList->RSSetScissorRects(1, &m_scissorRect);
         commandList->SetPipelineState(m_PSOs.at("PSO_Opaque").Get());
         commandList->SetGraphicsRootDescriptorTable(3, m_shadow->GetGpuDescHandleForShadow());
-        RenderObjects(device, commandList);
+        RenderObjects(device, commandList, pass);
         break;
     }
     default:
@@ -1976,31 +2329,138 @@ void Scene::OnProcessCollision()
         if (!m_objects[i]->GetValid()) continue;
         Object* obj = m_objects[i];
         Collider* collider = obj->GetComponent<Collider>();
-        if (!collider) continue;
+        if (!collider || !collider->IsActive() || collider->IsTrigger()) continue;
         auto& OBB = collider->GetOBB();
+        XMVECTOR center = XMLoadFloat3(&OBB.Center);
+        float radius = XMVectorGetX(XMVector3Length(XMLoadFloat3(&OBB.Extents)));
         for (int j = i + 1; j < objCount; ++j)
         {
             if (!m_objects[i]->GetValid()) break;
             if (!m_objects[j]->GetValid()) continue;
             Object* otherObj = m_objects[j];
             Collider* otherCollider = otherObj->GetComponent<Collider>();
-            if (!otherCollider) continue;
+            if (!otherCollider || !otherCollider->IsActive() || otherCollider->IsTrigger()) continue;
             auto& otherOBB = otherCollider->GetOBB();
+            //    SAT   ʴ´.
+            float otherRadius = XMVectorGetX(XMVector3Length(XMLoadFloat3(&otherOBB.Extents)));
+            float distSq = XMVectorGetX(XMVector3LengthSq(XMLoadFloat3(&otherOBB.Center) - center));
+            if (distSq > (radius + otherRadius) * (radius + otherRadius)) continue;
             if (!OBB.Intersects(otherOBB)) continue;
             auto [normal, penetration] = GetCollisionData(OBB, otherOBB);
             obj->OnProcessCollision(*otherObj, normal, penetration);
             otherObj->OnProcessCollision(*obj, -normal, penetration);
         }
     }
+    m_projectileSystem->ProcessCollision(m_objects);
+    ProcessTriggers();
+    ProcessHitboxes();
+}
+
+void Scene::ProcessTriggers()
+{
+    // Ȱ(÷̾)    ǹǷ   ΰ ƮŸ AABB θ ˻Ѵ.
+    m_activators.clear();
+    for (Object* obj : m_objects)
+    {
+        if (!obj->GetValid()) continue;
+        Collider* collider = obj->GetComponent<Collider>();
+        if (collider && collider->IsActive() && collider->IsActivator()) m_activators.push_back(obj);
+    }
+    if (m_activators.empty()) return;
+
+    for (Object* obj : m_objects)
+    {
+        if (!obj->GetValid()) continue;
+        Collider* collider = obj->GetComponent<Collider>();
+        if (!collider || !collider->IsActive() || !collider->IsTrigger()) continue;
+        auto& AABB = collider->GetAABB();
+        for (Object* activator : m_activators)
+        {
+            if (!obj->GetValid()) break;
+            if (!activator->GetValid()) continue;
+            if (!AABB.Intersects(activator->GetComponent<Collider>()->GetAABB())) continue;
+            obj->OnTrigger(*activator);
+            activator->OnTrigger(*obj);
+        }
+    }
+}
+
+void Scene::UpdateHitboxes(float deltaTime)
+{
+    for (Hitbox& hitbox : m_hitboxes)
+    {
+        if (!hitbox.active) continue;
+        hitbox.remainTime -= deltaTime;
+        Object* owner = GetObjFromId(hitbox.ownerId);
+        if (hitbox.remainTime <= 0.0f || !owner)
+        {
+            hitbox.active = false;
+            hitbox.onHit = nullptr;
+            continue;
+        }
+        //  OnUpdate   ڶ FinalM  ̹  ̴.
+        hitbox.localOBB.Transform(hitbox.worldOBB, owner->GetComponent<Transform>()->GetFinalM());
+    }
+}
+
+void Scene::ProcessHitboxes()
+{
+    for (Hitbox& hitbox : m_hitboxes)
+    {
+        if (!hitbox.active) continue;
+        XMVECTOR center = XMLoadFloat3(&hitbox.worldOBB.Center);
+        float radius = XMVectorGetX(XMVector3Length(XMLoadFloat3(&hitbox.worldOBB.Extents)));
+        for (Object* obj : m_objects)
+        {
+            if (!obj->GetValid()) continue;
+            if (obj->GetId() == hitbox.ownerId) continue;
+            if (hitbox.hitCount >= MAX_HITBOX_TARGET) break;
+            Collider* collider = obj->GetComponent<Collider>();
+            if (!collider || !collider->IsActive() || collider->IsTrigger()) continue;
+
+            auto& OBB = collider->GetOBB();
+            float otherRadius = XMVectorGetX(XMVector3Length(XMLoadFloat3(&OBB.Extents)));
+            float distSq = XMVectorGetX(XMVector3LengthSq(XMLoadFloat3(&OBB.Center) - center));
+            if (distSq > (radius + otherRadius) * (radius + otherRadius)) continue;
+            if (!hitbox.worldOBB.Intersects(OBB)) continue;
+
+            //   Ʈڽ  ִ    ´´.
+            uint32_t id = obj->GetId();
+            bool alreadyHit = false;
+            for (int i = 0; i < hitbox.hitCount; ++i)
+            {
+                if (hitbox.hitIds[i] == id) alreadyHit = true;
+            }
+            if (alreadyHit) continue;
+            hitbox.hitIds[hitbox.hitCount++] = id;
+            hitbox.onHit(*obj);
+        }
+    }
+}
+
+void Scene::ClearHitboxes()
+{
+    for (Hitbox& hitbox : m_hitboxes)
+    {
+        hitbox.active = false;
+        hitbox.onHit = nullptr;
+    }
 }
 
 void Scene::LateUpdate(GameTimer& gTimer)
 {
+    m_poseCache->BeginFrame();
+    Object* camera = GetObjFromId(mMainCameraId);
+    if (camera && camera->GetValid()) m_animationLod.BeginFrame(camera->GetComponent<Transform>()->GetPosition());
+    else m_animationLod.Disable();
     for (Object* obj : m_objects)
     {
         if (!obj->GetValid()) continue;
         obj->LateUpdate(gTimer);
     }
+    // ġ   ڿ ִϸ̼ Ѳ Ѵ.
+    m_animationSystem->Update(m_objects, gTimer.DeltaTime());
+    m_projectileSystem->UploadInstances();
 }
 
 ResourceManager& Scene::GetResourceManager()
@@ -2008,6 +2468,31 @@ ResourceManager& Scene::GetResourceManager()
     return *(m_resourceManager.get());
 }
 
+AIScheduler& Scene::GetAIScheduler()
+{
+    return *(m_aiScheduler.get());
+}
+
+FlowField& Scene::GetFlowField()
+{
+    return *(m_flowField.get());
+}
+
+ProjectileSystem& Scene::GetProjectileSystem()
+{
+    return *(m_projectileSystem.get());
+}
+
+PoseCache& Scene::GetPoseCache()
+{
+    return *(m_poseCache.get());
+}
+
+AnimationLod& Scene::GetAnimationLod()
+{
+    return m_animationLod;
+}
+
 void* Scene::GetConstantBufferMappedData()
 {
     // TODO: ⿡ return  մϴ.
@@ -3,12 +3,86 @@
 #include "Object.h"
 #include "ResourceManager.h"
 #include <utility>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <chrono>
 #include "Shadow.h"
+#include "AIScheduler.h"
+#include "FlowField.h"
+#include "ProjectileSystem.h"
+#include "PoseCache.h"
+#include "AnimationLod.h"
+#include "AnimationSystem.h"
+#include "AssetCooker.h"
 #define MAX_QUEUE 700
+#define MAX_HITBOX 128
+#define MAX_HITBOX_TARGET 16
 
 class GameTimer;
 class Framework;
 
+//   OBB. Object  GPU ҽ     󰡸,
+// ģ 󸶴   onHit  θ.
+struct Hitbox
+{
+    bool active = false;
+    uint32_t ownerId = -1;
+    BoundingOrientedBox localOBB{};
+    BoundingOrientedBox worldOBB{};
+    float remainTime = 0.0f;
+    std::function<void(Object&)> onHit;
+    uint32_t hitIds[MAX_HITBOX_TARGET]{};
+    int hitCount = 0;
+};
+
+//   . Scene::GetStageManifest  Build*Stage    д.
+//    ö   ͸ а,    ʴ  ׶ . ( )
+struct StageManifest
+{
+    vector<string> meshes;      // ResourceManager  ޽ ̸ (fbx  ̸, DeclareMesh ̸)
+    vector<wstring> textures;   // GetTextureIndex   ̸
+};
+
+// ޽ Ʈ ϳ  GPU .  ΰ Ƽ  ٲ  ڿ  ŭ Ѵ.
+struct GeometryBuffer
+{
+    ComPtr<ID3D12Resource> buffer;
+    ComPtr<ID3D12Resource> upload;  //   κ. Ӹ GPU  ٸǷ    ȴ
+    UINT64 capacity = 0;            // Ʈ
+    UINT64 size = 0;                // ö ִ Ʈ
+    D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;  //  踮 before
+};
+
+//  а ҽ   ؽó.  ɸ   Ʈ  ȴ.
+struct PreparedTexture
+{
+    int index = -1;
+    ComPtr<ID3D12Resource> defaultBuffer;
+    ComPtr<ID3D12Resource> uploadBuffer;
+    unique_ptr<uint8_t[]> ddsData;
+    vector<D3D12_SUBRESOURCE_DATA> subresources;
+};
+
+// ۾ 忡   . ׵   ״ .
+// 1. ۾ : ö   fbx, ؽó  б. fbx   ̰  Ŭ Ѱ ΰ,    ޽õ 
+// 2.  : غ  ̾ ̱ (  ޽ ġ ״δ)
+// 3. ۾ : Build*Stage, BuildUI  Ʈ . AddObj  objects  ִ´.
+// 4.  : Ʈ  Ŵ佺Ʈ   ٲٰ   ´
+struct StageBuild
+{
+    wstring stage;
+    StageManifest manifest;
+    PreparedMeshes meshes;
+    vector<PreparedTexture> textures;
+    vector<Object*> objects;
+    uint32_t mainCameraId = -1;
+    bool assetsCommitted = false;
+    chrono::steady_clock::time_point start;
+    thread worker;              //  ܰ踦  
+    atomic<bool> done{ false };
+};
+
 class Scene
 {
 public:
@@ -22,21 +96,31 @@ public:
     void OnResize(UINT width, UINT height);
     void OnDestroy();
     ResourceManager& GetResourceManager();
+    AIScheduler& GetAIScheduler();
+    FlowField& GetFlowField();
+    ProjectileSystem& GetProjectileSystem();
+    PoseCache& GetPoseCache();
+    AnimationLod& GetAnimationLod();
     void* GetConstantBufferMappedData();
     ID3D12DescriptorHeap* GetDescriptorHeap();
     UINT CalcConstantBufferByteSize(UINT byteSize);
     Framework* GetFramework();
     UINT GetNumOfTexture();
     void AddObj(Object* object);
+    void AddHitbox(uint32_t ownerId, XMFLOAT3&& center, XMFLOAT3&& extents, float duration, std::function<void(Object&)> onHit);
     std::unordered_map<std::string, ComPtr<ID3D12PipelineState>>& GetPSOs();
-    void RenderObjects(ID3D12Device* device, ID3D12GraphicsCommandList* commandList);
+    void RenderObjects(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, ePass pass);
+    // ε  ޽ ε Ŀ ´ ε  並 ɰ ׸.
+    void DrawSubMesh(ID3D12GraphicsCommandList* commandList, const SubMeshData& data, UINT instanceCount);
     char ClampToBounds(XMVECTOR& pos, XMVECTOR offset);
     std::tuple<float, float, float, float, float> GetBounds(float x, float z);
+    float GetGroundHeight(float x, float z, float maxY);  // ݴ   
+    //   ö   ؽó  ٿ  ӿ ø. ׶  ִ.
     int GetTextureIndex(wstring name);
     std::tuple<XMVECTOR, float> GetCollisionData(BoundingOrientedBox OBB1, BoundingOrientedBox OBB2);
     Object* GetObjFromId(uint32_t id);
     uint32_t AllocateId();
-    void SetStage(wstring stage);
+    void SetStage(wstring stage);   //  Ӻ ۾ 忡 ,  Ǹ  迡 ٲ۴
     void IncreaseLeatherCount();
     void ResetLeatherCount();
     bool HasEnoughLeather();
@@ -62,21 +146,44 @@ public:
 private:
     void BuildRandomPuzzleStatus();
     void ProcessStageQueue();
+    void StartStageBuild();
+    void RunStageBuild(function<void()> work);
+    void WaitStageBuild();      //  ܰ ۾ 尡   ٸ
+    void FinishStageBuild();    //  ٲ   ڸ  (ó )
+    void CommitStageAssets();
+    void BuildStageObjects();   // ۾ 
+    void SwapStage();
+    StageManifest GetStageManifest(const wstring& stage);
+    void AcquireStageAssets(const StageManifest& manifest, PreparedMeshes* meshes = nullptr);
+    void ReleaseStageAssets(const StageManifest& manifest);
+    void AcquireMissingAssets(Object* object);   // Ŵ佺Ʈ    Ʈ    δ
+    void AcquireTexture(int index);
+    void ReleaseTexture(int index);
+    //  ؽó б/ , ε  ٽ . ׸  GPU     θ.
+    void UpdateResidentResources(ID3D12Device* device, ID3D12GraphicsCommandList* commandList);
     void CompactObjects();
+    void UpdateHitboxes(float deltaTime);
+    void ProcessHitboxes();
+    void ProcessTriggers();
+    void ClearHitboxes();
     void ProcessObjectQueue();
     void DeleteCurrentObjects();
     void ProcessInput();
     void LoadMeshAnimationTexture();
     void BuildRootSignature(ID3D12Device* device);
     void BuildPSO(ID3D12Device* device);
-    void BuildVertexBuffer(ID3D12Device* device, ID3D12GraphicsCommandList* commandList);
-    void BuildIndexBuffer(ID3D12Device* device, ID3D12GraphicsCommandList* commandList);
+    // rewrite  ̸  ø ڷ  κи ø
+    void BuildVertexBuffer(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, bool rewrite);
+    void BuildIndexBuffer(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, bool rewrite);
+    void UploadGeometry(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, GeometryBuffer& geometry, const void* data, UINT64 size, bool rewrite);
     void BuildVertexBufferView();
+    void BindVertexBuffers(ID3D12GraphicsCommandList* commandList);    //  Ʈ ü, Ų Ʈ  д
     void BuildIndexBufferView();
     void BuildConstantBuffer(ID3D12Device* device);
     void BuildConstantBufferView(ID3D12Device* device);
-    void BuildTextureBuffer(ID3D12Device* device, ID3D12GraphicsCommandList* commandList);
-    void BuildTextureBufferView(ID3D12Device* device);
+    void PrepareTexture(ID3D12Device* device, PreparedTexture& texture);    // ٸ 忡 ҷ ȴ
+    void LoadTexture(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, int index);
+    void BuildTextureBufferView(ID3D12Device* device, int index);     //  ڸ null ڷ ä
     void BuildDescriptorHeap(ID3D12Device* device);
     void BuildProjMatrix();
     void BuildTitleStage();
@@ -86,6 +193,10 @@ private:
     void BuildEndStage();
     void BuildUI();
     void BuildShadow();
+    void BuildAI();
+    void BuildProjectileSystem(ID3D12Device* device);
+    void BuildPoseCache();
+    void BuildAnimationSystem(ID3D12Device* device);
     void BuildShaders();
     void BuildInputElement();
     ComPtr<ID3DBlob> CompileShader(
@@ -95,9 +206,12 @@ private:
     wstring m_current_stage = L"";
     wstring m_stage_queue = L"Title";
     vector<Object*> m_objects;
-    uint32_t m_id_counter = 0;
+    atomic<uint32_t> m_id_counter{ 0 };     //   ۾ 嵵 
     Object* m_object_queue[MAX_QUEUE]{};
     int m_object_queue_index = 0;
+    unique_ptr<StageBuild> m_stageBuild;    //  ִ   nullptr
+    Hitbox m_hitboxes[MAX_HITBOX]{};
+    vector<Object*> m_activators;
     int mLeatherCount = 0;
     bool mTigerQuest = false;
     XMFLOAT3 mInputDir{};
@@ -116,17 +230,26 @@ private:
     ComPtr<ID3D12DescriptorHeap> m_descriptorHeap;
     UINT m_cbvsrvuavDescriptorSize;
     //
-    ComPtr<ID3D12Resource> m_vertexBuffer_default;
-    ComPtr<ID3D12Resource> m_indexBuffer_default;
-    ComPtr<ID3D12Resource> m_vertexBuffer_upload;
-    ComPtr<ID3D12Resource> m_indexBuffer_upload;
+    GeometryBuffer m_vertexBuffer;
+    GeometryBuffer m_skinVertexBuffer;
+    GeometryBuffer m_indexBuffer;
+    GeometryBuffer m_indexBuffer16;
     D3D12_VERTEX_BUFFER_VIEW m_vertexBufferView;
+    D3D12_VERTEX_BUFFER_VIEW m_skinVertexBufferView;
+    bool m_meshVertexBuffersBound = false;   // Ų ޽ø ׸  Ʈ  ޽ ġ Ű   
     D3D12_INDEX_BUFFER_VIEW m_indexBufferView;
+    D3D12_INDEX_BUFFER_VIEW m_indexBufferView16;
     //
     unordered_map<wstring, int> m_texture_name_to_index;
     vector<wstring> m_DDSFileName;
     vector<ComPtr<ID3D12Resource>> m_textureBuffer_defaults;
     vector<ComPtr<ID3D12Resource>> m_textureBuffer_uploads;
+    vector<PreparedTexture> m_preparedTextures;    //    ̸ о  . ø 
+    vector<UINT> m_textureRefs;
+    vector<int> m_dirtyTextures;    //  UpdateResidentResources  аų null  ٲ ڸ
+    StageManifest m_stageAssets;    //    ִ  (Ŵ佺Ʈ +  ־ ߿  )
+    uint64_t m_geometryVersion = -1;    // GPU ۿ ø ResourceManager /ε  
+    uint64_t m_geometryLayoutVersion = -1;
     //
     ComPtr<ID3D12Resource> m_constantBuffer;
     void* m_mappedData = nullptr;
@@ -134,6 +257,13 @@ private:
     XMFLOAT4X4 m_proj;
     //
     unique_ptr<Shadow> m_shadow = nullptr;
+    //
+    unique_ptr<AIScheduler> m_aiScheduler = nullptr;
+    unique_ptr<FlowField> m_flowField = nullptr;
+    unique_ptr<ProjectileSystem> m_projectileSystem = nullptr;
+    unique_ptr<PoseCache> m_poseCache = nullptr;
+    AnimationLod m_animationLod;
+    unique_ptr<AnimationSystem> m_animationSystem = nullptr;
 
     std::vector<D3D12_INPUT_ELEMENT_DESC> m_inputElement;
 };
@@ -1,9 +1,10 @@
 cbuffer WoldTranslate : register(b1)
 {
     float4x4 world;
-    float4x4 finalTranforms[90];
     int isAnimation;
-    int3 padding0;
+    uint paletteOffset;
+    int skinningMode;
+    int padding0;
     float powValue;
     float ambiantValue;
     float2 padding1;
@@ -20,10 +21,76 @@ cbuffer SceneConstantBuffer : register(b0)
 Texture2D Texture : register(t0);
 Texture2D ShadowMap : register(t1);
 
+#ifdef INSTANCED
+StructuredBuffer<float4x4> InstanceWorld : register(t2);
+#endif
+
+// Per bone: 3 rows of the transposed 3x4 matrix, or a dual quaternion (real, dual).
+StructuredBuffer<float4> Palette : register(t3);
+
 SamplerState Sampler : register(s0);
 SamplerComparisonState SamplerShadowMap : register(s1);
 
 
+//---------------------------------------------------------------------------------------
+// Octahedral normal (R16G16_SNORM) back to a unit vector. Encoded by VertexFormat.cpp.
+//---------------------------------------------------------------------------------------
+
+float3 DecodeOctahedral(float2 e)
+{
+    float3 n = float3(e, 1.0f - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z);
+    n.xy += n.xy >= 0.0f ? -t : t;
+    return normalize(n);
+}
+
+//---------------------------------------------------------------------------------------
+// Skinning. skinningMode 0: linear blend of 3x4 matrices, 1: dual quaternion blend.
+//---------------------------------------------------------------------------------------
+
+void Skin(float4 weight, uint4 boneIndex, inout float3 position, inout float3 normal)
+{
+    if (skinningMode == 1)
+    {
+        float4 firstReal = Palette[paletteOffset + boneIndex[0] * 2];
+        float4 real = 0.0f;
+        float4 dual = 0.0f;
+        for (int i = 0; i < 4; ++i)
+        {
+            uint b = paletteOffset + boneIndex[i] * 2;
+            float4 r = Palette[b];
+            float w = dot(r, firstReal) < 0.0f ? -weight[i] : weight[i];
+            real += w * r;
+            dual += w * Palette[b + 1];
+        }
+        float len = length(real);
+        real /= len;
+        dual /= len;
+
+        position += 2.0f * cross(real.xyz, cross(real.xyz, position) + real.w * position);
+        position += 2.0f * (real.w * dual.xyz - dual.w * real.xyz + cross(real.xyz, dual.xyz));
+        normal += 2.0f * cross(real.xyz, cross(real.xyz, normal) + real.w * normal);
+        normal = normalize(normal);
+        return;
+    }
+
+    float3 pos = 0.0f;
+    float3 n = 0.0f;
+    for (int i = 0; i < 4; ++i)
+    {
+        uint b = paletteOffset + boneIndex[i] * 3;
+        float4 c0 = Palette[b];
+        float4 c1 = Palette[b + 1];
+        float4 c2 = Palette[b + 2];
+        float4 p = float4(position, 1.0f);
+        float4 v = float4(normal, 0.0f);
+        pos += weight[i] * float3(dot(p, c0), dot(p, c1), dot(p, c2));
+        n += weight[i] * float3(dot(v, c0), dot(v, c1), dot(v, c2));
+    }
+    position = pos;
+    normal = normalize(n);
+}
+
 //---------------------------------------------------------------------------------------
 // PCF for shadow mapping.
 //---------------------------------------------------------------------------------------
@@ -3,10 +3,10 @@
 struct VSInput
 {
     float3 position : POSITION;
-    float3 normal : NORMAL;
+    float2 normal : NORMAL;         // octahedral
     float2 uv : TEXCOORD;
-    float4 weight : WEIGHT;
-    int4 boneIndex : BONEINDEX;
+    float4 weight : WEIGHT;         // slot 1, zero for meshes without skin
+    uint4 boneIndex : BONEINDEX;
 };
 
 struct VSOutput
@@ -17,28 +17,24 @@ struct VSOutput
     float2 uv : TEXCOORD;
 };
 
-VSOutput VS(VSInput input)
+VSOutput VS(VSInput input, uint instanceID : SV_InstanceID)
 {
+#ifdef INSTANCED
+    float4x4 W = InstanceWorld[instanceID];
+#else
+    float4x4 W = world;
+#endif
     
+    float3 normal = DecodeOctahedral(input.normal);
     if (isAnimation == 1)
     {
-        float3 pos = 0.0f;
-        float3 normal = 0.0f;
-        
-        for (int i = 0; i < 4; ++i)
-        {
-            pos += input.weight[i] * mul(float4(input.position, 1.0f), finalTranforms[input.boneIndex[i]]).xyz;
-            normal += input.weight[i] * mul(float4(input.normal, 0.0f), finalTranforms[input.boneIndex[i]]).xyz;
-        }
-        input.position = pos;
-        normal = normalize(normal);
-        input.normal = normal;
+        Skin(input.weight, input.boneIndex, input.position, normal);
     }
     
     VSOutput output;
-    float4 posW = mul(float4(input.position, 1.0f), world);
+    float4 posW = mul(float4(input.position, 1.0f), W);
     output.position = mul(posW, mul(view, proj));
-    float3 n = mul(input.normal, (float3x3) world);
+    float3 n = mul(normal, (float3x3) W);
     output.normal = float4(normalize(n), 0);
     output.uv = input.uv;
     output.shadowPosH = mul(posW, mul(lightViewProj, lightTexCoord));
@@ -4,7 +4,7 @@ struct VertexIn
 {
     float3 position : POSITION;
     float4 weight : WEIGHT;
-    int4 boneIndex : BONEINDEX;
+    uint4 boneIndex : BONEINDEX;
 };
 
 struct VertexOut
@@ -12,21 +12,21 @@ struct VertexOut
     float4 position : SV_POSITION;
 };
 
-VertexOut VS(VertexIn input)
+VertexOut VS(VertexIn input, uint instanceID : SV_InstanceID)
 {
+#ifdef INSTANCED
+    float4x4 W = InstanceWorld[instanceID];
+#else
+    float4x4 W = world;
+#endif
     if (isAnimation == 1)
     {
-        float3 pos = 0.0f;
-        
-        for (int i = 0; i < 4; ++i)
-        {
-            pos += input.weight[i] * mul(float4(input.position, 1.0f), finalTranforms[input.boneIndex[i]]).xyz;
-        }
-        input.position = pos;
+        float3 normal = float3(0.0f, 1.0f, 0.0f);
+        Skin(input.weight, input.boneIndex, input.position, normal);
     }
 
     VertexOut vertexOut = (VertexOut)0.0f;
-    float4 PosW = mul(float4(input.position, 1.0f), world);
+    float4 PosW = mul(float4(input.position, 1.0f), W);
     vertexOut.position = mul(PosW, lightViewProj);
     
     return vertexOut;
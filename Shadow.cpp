@@ -104,7 +104,7 @@ void Shadow::DrawShadowMap()
 	auto& PSOs = mParent->GetPSOs();
 	commandList->SetPipelineState(PSOs["PSO_Shadow"].Get());
 
-	mParent->RenderObjects(device, commandList);
+	mParent->RenderObjects(device, commandList, ePass::Shadow);
 
 	barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_DEPTH_WRITE;
 	barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_GENERIC_READ;
@@ -1,5 +1,6 @@
 #include "SkinnedData.h"
 #include "MathHelper.h"
+#include <algorithm>
 
 
 Keyframe::Keyframe()
@@ -10,9 +11,6 @@ Keyframe::Keyframe()
 {
 }
 
-Keyframe::~Keyframe()
-{
-}
  
 float BoneAnimation::GetStartTime()const
 {
@@ -29,57 +27,76 @@ float BoneAnimation::GetEndTime()const
 }
 
 void BoneAnimation::Interpolate(float t, XMFLOAT4X4& M)const
+{
+	UINT cursor = 0;
+	Interpolate(t, M, cursor);
+}
+
+void BoneAnimation::Interpolate(float t, XMFLOAT4X4& M, UINT& cursor)const
 {
 	if( t <= Keyframes.front().TimePos )
 	{
-		XMVECTOR S = XMLoadFloat3(&Keyframes.front().Scale);
-		XMVECTOR P = XMLoadFloat3(&Keyframes.front().Translation);
-		XMVECTOR Q = XMLoadFloat4(&Keyframes.front().RotationQuat);
-
-		XMVECTOR zero = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
-		XMStoreFloat4x4(&M, XMMatrixAffineTransformation(S, zero, Q, P));
+		InterpolateKey(0, 0.0f, M);
 	}
 	else if( t >= Keyframes.back().TimePos )
 	{
-		XMVECTOR S = XMLoadFloat3(&Keyframes.back().Scale);
-		XMVECTOR P = XMLoadFloat3(&Keyframes.back().Translation);
-		XMVECTOR Q = XMLoadFloat4(&Keyframes.back().RotationQuat);
-
-		XMVECTOR zero = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
-		XMStoreFloat4x4(&M, XMMatrixAffineTransformation(S, zero, Q, P));
+		InterpolateKey((UINT)Keyframes.size() - 1, 0.0f, M);
 	}
 	else
 	{
-		for(UINT i = 0; i < Keyframes.size()-1; ++i)
-		{
-			if( t >= Keyframes[i].TimePos && t <= Keyframes[i+1].TimePos )
-			{
-				float lerpPercent = (t - Keyframes[i].TimePos) / (Keyframes[i+1].TimePos - Keyframes[i].TimePos);
+		UINT i = FindKey(t, cursor);
+		float lerpPercent = (t - Keyframes[i].TimePos) / (Keyframes[i+1].TimePos - Keyframes[i].TimePos);
+		InterpolateKey(i, lerpPercent, M);
+	}
+}
+
+void BoneAnimation::InterpolateKey(UINT i, float lerpPercent, XMFLOAT4X4& M)const
+{
+	const Keyframe& k0 = Keyframes[i];
+	const Keyframe& k1 = Keyframes[MathHelper::Min(i + 1, (UINT)Keyframes.size() - 1)];
 
-				XMVECTOR s0 = XMLoadFloat3(&Keyframes[i].Scale);
-				XMVECTOR s1 = XMLoadFloat3(&Keyframes[i+1].Scale);
+	XMVECTOR s0 = XMLoadFloat3(&k0.Scale);
+	XMVECTOR s1 = XMLoadFloat3(&k1.Scale);
 
-				XMVECTOR p0 = XMLoadFloat3(&Keyframes[i].Translation);
-				XMVECTOR p1 = XMLoadFloat3(&Keyframes[i+1].Translation);
+	XMVECTOR p0 = XMLoadFloat3(&k0.Translation);
+	XMVECTOR p1 = XMLoadFloat3(&k1.Translation);
 
-				XMVECTOR q0 = XMLoadFloat4(&Keyframes[i].RotationQuat);
-				XMVECTOR q1 = XMLoadFloat4(&Keyframes[i+1].RotationQuat);
+	XMVECTOR q0 = XMLoadFloat4(&k0.RotationQuat);
+	XMVECTOR q1 = XMLoadFloat4(&k1.RotationQuat);
 
-				XMVECTOR S = XMVectorLerp(s0, s1, lerpPercent);
-				XMVECTOR P = XMVectorLerp(p0, p1, lerpPercent);
-				XMVECTOR Q = XMQuaternionSlerp(q0, q1, lerpPercent);
+	XMVECTOR S = XMVectorLerp(s0, s1, lerpPercent);
+	XMVECTOR P = XMVectorLerp(p0, p1, lerpPercent);
+	XMVECTOR Q = XMQuaternionSlerp(q0, q1, lerpPercent);
 
-				XMVECTOR zero = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
-				XMStoreFloat4x4(&M, XMMatrixAffineTransformation(S, zero, Q, P));
+	XMVECTOR zero = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
+	XMStoreFloat4x4(&M, XMMatrixAffineTransformation(S, zero, Q, P));
+}
 
-				break;
-			}
+UINT BoneAnimation::FindKey(float t, UINT& cursor)const
+{
+	// Front < t < back here. Try the previous pair and the one after it
+	// first, then fall back to a binary search (seek, loop, clip change).
+	UINT last = (UINT)Keyframes.size() - 1;
+	for (UINT i = cursor; i < cursor + 2 && i < last; ++i)
+	{
+		if (Keyframes[i].TimePos <= t && t < Keyframes[i + 1].TimePos)
+		{
+			cursor = i;
+			return i;
 		}
 	}
+
+	auto next = std::upper_bound(Keyframes.begin(), Keyframes.end(), t,
+		[](float time, const Keyframe& key) { return time < key.TimePos; });
+	cursor = (UINT)(next - Keyframes.begin()) - 1;
+	return cursor;
 }
 
 float AnimationClip::GetClipStartTime()const
 {
+	// Compressed clips no longer have raw keys.
+	if (SampleRate > 0.0f) return StartTime;
+
 	// Find smallest start time over all bones in this clip.
 	float t = MathHelper::Infinity;
 	for(UINT i = 0; i < BoneAnimations.size(); ++i)
@@ -92,6 +109,8 @@ float AnimationClip::GetClipStartTime()const
 
 float AnimationClip::GetClipEndTime()const
 {
+	if (SampleRate > 0.0f) return StartTime + (float)(KeyCount - 1) / SampleRate;
+
 	// Find largest end time over all bones in this clip.
 	float t = 0.0f;
 	for(UINT i = 0; i < BoneAnimations.size(); ++i)
@@ -102,82 +121,719 @@ float AnimationClip::GetClipEndTime()const
 	return t;
 }
 
-void AnimationClip::Interpolate(float t, std::vector<XMFLOAT4X4>& boneTransforms)const
+void AnimationClip::DetectUniformSampling()
+{
+	SampleRate = 0.0f;
+	StartTime = 0.0f;
+	KeyCount = 0;
+	if (BoneAnimations.empty()) return;
+
+	const std::vector<Keyframe>& reference = BoneAnimations[0].Keyframes;
+	UINT keyCount = (UINT)reference.size();
+	if (keyCount < 2) return;
+
+	float start = reference[0].TimePos;
+	float step = reference[1].TimePos - start;
+	if (step <= 0.0f) return;
+
+	float tolerance = step * 1.0e-3f;
+	for (UINT i = 0; i < BoneAnimations.size(); ++i)
+	{
+		const std::vector<Keyframe>& keys = BoneAnimations[i].Keyframes;
+		if (keys.size() != keyCount) return;
+		for (UINT k = 0; k < keyCount; ++k)
+		{
+			if (fabsf(keys[k].TimePos - (start + step * k)) > tolerance) return;
+		}
+	}
+
+	SampleRate = 1.0f / step;
+	StartTime = start;
+	KeyCount = keyCount;
+}
+
+void AnimationClip::Interpolate(float t, XMFLOAT4X4* boneTransforms, UINT* cursors)const
 {
+	if (SampleRate > 0.0f)
+	{
+		// Uniform clip: the key index is the same for every bone.
+		float frame = MathHelper::Clamp((t - StartTime) * SampleRate, 0.0f, (float)(KeyCount - 1));
+		if (!Compressed.empty())
+		{
+			for (UINT b = 0; b < Compressed.size(); ++b)
+			{
+				Compressed[b].Interpolate(frame, boneTransforms[b]);
+			}
+			return;
+		}
+		UINT i = MathHelper::Min((UINT)frame, KeyCount - 1);
+		float lerpPercent = frame - (float)i;
+		if (!SoA.empty())
+		{
+			InterpolateSoA(i, lerpPercent, boneTransforms);
+			return;
+		}
+		for (UINT b = 0; b < BoneAnimations.size(); ++b)
+		{
+			BoneAnimations[b].InterpolateKey(i, lerpPercent, boneTransforms[b]);
+		}
+		return;
+	}
+
 	for(UINT i = 0; i < BoneAnimations.size(); ++i)
 	{
-		BoneAnimations[i].Interpolate(t, boneTransforms[i]);
+		if (cursors) BoneAnimations[i].Interpolate(t, boneTransforms[i], cursors[i]);
+		else BoneAnimations[i].Interpolate(t, boneTransforms[i]);
+	}
+}
+
+void AnimationClip::BuildSoA()
+{
+	SoA.clear();
+	SoABoneStride = 0;
+	if (SampleRate <= 0.0f) return;
+
+	UINT boneCount = (UINT)BoneAnimations.size();
+	UINT stride = (boneCount + 3) & ~3u;
+	size_t keyStride = (size_t)stride * SOA_STREAM_COUNT;
+	SoA.assign(keyStride * KeyCount, 0.0f);
+	SoABoneStride = stride;
+
+	Keyframe identity;
+	for (UINT k = 0; k < KeyCount; ++k)
+	{
+		float* key = &SoA[keyStride * k];
+		for (UINT b = 0; b < stride; ++b)
+		{
+			const Keyframe& frame = b < boneCount ? BoneAnimations[b].Keyframes[k] : identity;
+			XMFLOAT4 q = frame.RotationQuat;
+
+			// Keep consecutive keys in the same hemisphere so nlerp never
+			// needs a per-sample sign test.
+			if (k > 0)
+			{
+				const float* prev = &SoA[keyStride * (k - 1)];
+				float dot = q.x * prev[SOA_QX * stride + b] + q.y * prev[SOA_QY * stride + b]
+					+ q.z * prev[SOA_QZ * stride + b] + q.w * prev[SOA_QW * stride + b];
+				if (dot < 0.0f) q = XMFLOAT4(-q.x, -q.y, -q.z, -q.w);
+			}
+
+			key[SOA_TX * stride + b] = frame.Translation.x;
+			key[SOA_TY * stride + b] = frame.Translation.y;
+			key[SOA_TZ * stride + b] = frame.Translation.z;
+			key[SOA_QX * stride + b] = q.x;
+			key[SOA_QY * stride + b] = q.y;
+			key[SOA_QZ * stride + b] = q.z;
+			key[SOA_QW * stride + b] = q.w;
+			key[SOA_SX * stride + b] = frame.Scale.x;
+			key[SOA_SY * stride + b] = frame.Scale.y;
+			key[SOA_SZ * stride + b] = frame.Scale.z;
+		}
+	}
+}
+
+void AnimationClip::InterpolateSoA(UINT i, float lerpPercent, XMFLOAT4X4* boneTransforms)const
+{
+	UINT boneCount = (UINT)BoneAnimations.size();
+	UINT stride = SoABoneStride;
+	size_t keyStride = (size_t)stride * SOA_STREAM_COUNT;
+	const float* k0 = &SoA[keyStride * i];
+	const float* k1 = &SoA[keyStride * MathHelper::Min(i + 1, KeyCount - 1)];
+
+	const XMVECTOR t = XMVectorReplicate(lerpPercent);
+	const XMVECTOR one = XMVectorSplatOne();
+	const XMVECTOR two = XMVectorReplicate(2.0f);
+	const XMVECTOR zero = XMVectorZero();
+
+	for (UINT b = 0; b < boneCount; b += 4)
+	{
+		auto lerp = [&](UINT stream)
+			{
+				XMVECTOR v0 = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(k0 + stream * stride + b));
+				XMVECTOR v1 = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(k1 + stream * stride + b));
+				return XMVectorLerpV(v0, v1, t);
+			};
+
+		XMVECTOR px = lerp(SOA_TX);
+		XMVECTOR py = lerp(SOA_TY);
+		XMVECTOR pz = lerp(SOA_TZ);
+		XMVECTOR qx = lerp(SOA_QX);
+		XMVECTOR qy = lerp(SOA_QY);
+		XMVECTOR qz = lerp(SOA_QZ);
+		XMVECTOR qw = lerp(SOA_QW);
+		XMVECTOR sx = lerp(SOA_SX);
+		XMVECTOR sy = lerp(SOA_SY);
+		XMVECTOR sz = lerp(SOA_SZ);
+
+		XMVECTOR invLength = XMVectorReciprocalSqrt(qx * qx + qy * qy + qz * qz + qw * qw);
+		qx *= invLength;
+		qy *= invLength;
+		qz *= invLength;
+		qw *= invLength;
+
+		// Same as XMMatrixAffineTransformation(S, 0, Q, P), four bones at a time.
+		XMVECTOR xx = qx * qx, yy = qy * qy, zz = qz * qz;
+		XMVECTOR xy = qx * qy, xz = qx * qz, yz = qy * qz;
+		XMVECTOR wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+		XMMATRIX row0 = XMMatrixTranspose(XMMATRIX(
+			sx * (one - two * (yy + zz)), sx * two * (xy + wz), sx * two * (xz - wy), zero));
+		XMMATRIX row1 = XMMatrixTranspose(XMMATRIX(
+			sy * two * (xy - wz), sy * (one - two * (xx + zz)), sy * two * (yz + wx), zero));
+		XMMATRIX row2 = XMMatrixTranspose(XMMATRIX(
+			sz * two * (xz + wy), sz * two * (yz - wx), sz * (one - two * (xx + yy)), zero));
+		XMMATRIX row3 = XMMatrixTranspose(XMMATRIX(px, py, pz, one));
+
+		UINT count = MathHelper::Min(4u, boneCount - b);
+		for (UINT j = 0; j < count; ++j)
+		{
+			XMStoreFloat4x4(&boneTransforms[b + j], XMMATRIX(row0.r[j], row1.r[j], row2.r[j], row3.r[j]));
+		}
+	}
+}
+
+bool AnimationClip::ValidateSoA(float tolerance)const
+{
+	if (SoA.empty()) return true;
+
+	UINT boneCount = (UINT)BoneAnimations.size();
+	std::vector<XMFLOAT4X4> expected(boneCount);
+	std::vector<XMFLOAT4X4> actual(boneCount);
+	const float lerps[] = { 0.0f, 0.25f, 0.5f, 0.75f };
+	for (UINT k = 0; k < KeyCount; ++k)
+	{
+		for (float lerpPercent : lerps)
+		{
+			for (UINT b = 0; b < boneCount; ++b)
+			{
+				BoneAnimations[b].InterpolateKey(k, lerpPercent, expected[b]);
+			}
+			InterpolateSoA(k, lerpPercent, actual.data());
+
+			for (UINT b = 0; b < boneCount; ++b)
+			{
+				for (int r = 0; r < 4; ++r)
+				{
+					for (int c = 0; c < 4; ++c)
+					{
+						float e = expected[b].m[r][c];
+						if (fabsf(actual[b].m[r][c] - e) > tolerance * (1.0f + fabsf(e))) return false;
+					}
+				}
+			}
+		}
+	}
+	return true;
+}
+
+//
+// Compression
+//
+
+// Smallest-three: the largest component is dropped (and made positive) and
+// the other three are stored as 15-bit values in [-1/sqrt2, 1/sqrt2].
+// 2 bits index + 3 * 15 bits = 47 of 48 bits.
+static const float sQuatRange = 0.70710678f;
+static const float sQuatScale = 32767.0f;
+
+static void PackQuaternion(XMFLOAT4 q, std::uint16_t* out)
+{
+	float c[4] = { q.x, q.y, q.z, q.w };
+	int largest = 0;
+	for (int i = 1; i < 4; ++i)
+	{
+		if (fabsf(c[i]) > fabsf(c[largest])) largest = i;
+	}
+	float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+
+	std::uint64_t bits = (std::uint64_t)largest;
+	for (int i = 0; i < 4; ++i)
+	{
+		if (i == largest) continue;
+		float v = MathHelper::Clamp(c[i] * sign / sQuatRange, -1.0f, 1.0f);
+		std::uint64_t quantized = (std::uint64_t)((v * 0.5f + 0.5f) * sQuatScale + 0.5f);
+		bits = (bits << 15) | quantized;
+	}
+	out[0] = (std::uint16_t)(bits >> 32);
+	out[1] = (std::uint16_t)(bits >> 16);
+	out[2] = (std::uint16_t)bits;
+}
+
+static XMVECTOR UnpackQuaternion(const std::uint16_t* in)
+{
+	std::uint64_t bits = ((std::uint64_t)in[0] << 32) | ((std::uint64_t)in[1] << 16) | (std::uint64_t)in[2];
+	int largest = (int)(bits >> 45) & 3;
+
+	float c[4];
+	float sum = 0.0f;
+	int shift = 30;
+	for (int i = 0; i < 4; ++i)
+	{
+		if (i == largest) continue;
+		float v = (float)((bits >> shift) & 0x7fff) / sQuatScale;
+		c[i] = (v * 2.0f - 1.0f) * sQuatRange;
+		sum += c[i] * c[i];
+		shift -= 15;
 	}
+	c[largest] = sqrtf(MathHelper::Max(0.0f, 1.0f - sum));
+	return XMQuaternionNormalize(XMVectorSet(c[0], c[1], c[2], c[3]));
+}
+
+// Returns k with frames[k] <= frame < frames[k + 1] (clamped at both ends).
+static UINT FindSegment(const std::vector<std::uint16_t>& frames, float frame, float& lerpPercent)
+{
+	lerpPercent = 0.0f;
+	if (frames.size() == 1 || frame <= (float)frames.front()) return 0;
+	if (frame >= (float)frames.back()) return (UINT)frames.size() - 1;
+
+	auto next = std::upper_bound(frames.begin(), frames.end(), frame,
+		[](float f, std::uint16_t key) { return f < (float)key; });
+	UINT k = (UINT)(next - frames.begin()) - 1;
+	lerpPercent = (frame - frames[k]) / (float)(frames[k + 1] - frames[k]);
+	return k;
+}
+
+// Greedy: from each kept key, extend the segment while every key inside
+// it is reproduced within the error, then keep the segment end.
+template<typename WithinError>
+static std::vector<UINT> ReduceKeys(UINT keyCount, WithinError withinError)
+{
+	std::vector<UINT> kept{ 0 };
+	UINT anchor = 0;
+	while (anchor + 1 < keyCount)
+	{
+		UINT end = anchor + 1;
+		while (end + 1 < keyCount && withinError(anchor, end + 1)) ++end;
+		kept.push_back(end);
+		anchor = end;
+	}
+	return kept;
+}
+
+static std::vector<UINT> ReduceFloat3(const std::vector<XMFLOAT3>& values, float error)
+{
+	return ReduceKeys((UINT)values.size(), [&](UINT a, UINT b)
+		{
+			XMVECTOR va = XMLoadFloat3(&values[a]);
+			XMVECTOR vb = XMLoadFloat3(&values[b]);
+			for (UINT k = a + 1; k < b; ++k)
+			{
+				XMVECTOR lerp = XMVectorLerp(va, vb, (float)(k - a) / (float)(b - a));
+				if (XMVectorGetX(XMVector3Length(lerp - XMLoadFloat3(&values[k]))) > error) return false;
+			}
+			return true;
+		});
+}
+
+void CompressedBoneAnimation::Interpolate(float frame, XMFLOAT4X4& M)const
+{
+	float lerpPercent = 0.0f;
+
+	UINT k = FindSegment(TranslationFrames, frame, lerpPercent);
+	UINT k1 = MathHelper::Min(k + 1, (UINT)Translations.size() - 1);
+	XMVECTOR P = XMVectorLerp(XMLoadFloat3(&Translations[k]), XMLoadFloat3(&Translations[k1]), lerpPercent);
+
+	k = FindSegment(RotationFrames, frame, lerpPercent);
+	k1 = MathHelper::Min(k + 1, (UINT)RotationFrames.size() - 1);
+	XMVECTOR Q = XMQuaternionSlerp(UnpackQuaternion(&Rotations[k * 3]), UnpackQuaternion(&Rotations[k1 * 3]), lerpPercent);
+
+	k = FindSegment(ScaleFrames, frame, lerpPercent);
+	k1 = MathHelper::Min(k + 1, (UINT)Scales.size() - 1);
+	XMVECTOR S = XMVectorLerp(XMLoadFloat3(&Scales[k]), XMLoadFloat3(&Scales[k1]), lerpPercent);
+
+	XMVECTOR zero = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
+	XMStoreFloat4x4(&M, XMMatrixAffineTransformation(S, zero, Q, P));
+}
+
+size_t CompressedBoneAnimation::ByteSize()const
+{
+	return sizeof(std::uint16_t) * (TranslationFrames.size() + RotationFrames.size() + Rotations.size() + ScaleFrames.size())
+		+ sizeof(XMFLOAT3) * (Translations.size() + Scales.size());
+}
+
+void AnimationClip::Compress(const AnimationCompression& settings)
+{
+	Compressed.clear();
+	if (SampleRate <= 0.0f || KeyCount > 0xffff) return;
+
+	Compressed.resize(BoneAnimations.size());
+	std::vector<XMFLOAT3> translations(KeyCount);
+	std::vector<XMFLOAT3> scales(KeyCount);
+	std::vector<std::uint16_t> packed(KeyCount * 3);
+	std::vector<XMFLOAT4> rotations(KeyCount);
+	for (UINT b = 0; b < BoneAnimations.size(); ++b)
+	{
+		const std::vector<Keyframe>& keys = BoneAnimations[b].Keyframes;
+		CompressedBoneAnimation& bone = Compressed[b];
+
+		for (UINT k = 0; k < KeyCount; ++k)
+		{
+			translations[k] = keys[k].Translation;
+			scales[k] = keys[k].Scale;
+			// Reduce against the quantized values so the error bound holds after decoding.
+			PackQuaternion(keys[k].RotationQuat, &packed[k * 3]);
+			XMStoreFloat4(&rotations[k], UnpackQuaternion(&packed[k * 3]));
+		}
+
+		for (UINT k : ReduceFloat3(translations, settings.TranslationError))
+		{
+			bone.TranslationFrames.push_back((std::uint16_t)k);
+			bone.Translations.push_back(translations[k]);
+		}
+
+		std::vector<UINT> keptRotations = ReduceKeys(KeyCount, [&](UINT a, UINT b)
+			{
+				XMVECTOR qa = XMLoadFloat4(&rotations[a]);
+				XMVECTOR qb = XMLoadFloat4(&rotations[b]);
+				for (UINT k = a + 1; k < b; ++k)
+				{
+					XMVECTOR q = XMQuaternionSlerp(qa, qb, (float)(k - a) / (float)(b - a));
+					float dot = fabsf(XMVectorGetX(XMQuaternionDot(q, XMLoadFloat4(&rotations[k]))));
+					if (2.0f * acosf(MathHelper::Min(dot, 1.0f)) > settings.RotationError) return false;
+				}
+				return true;
+			});
+		for (UINT k : keptRotations)
+		{
+			bone.RotationFrames.push_back((std::uint16_t)k);
+			bone.Rotations.insert(bone.Rotations.end(), &packed[k * 3], &packed[k * 3] + 3);
+		}
+
+		// A constant scale track keeps only its first key.
+		bool constantScale = true;
+		for (UINT k = 1; k < KeyCount && constantScale; ++k)
+		{
+			constantScale = fabsf(scales[k].x - scales[0].x) <= settings.ScaleError
+				&& fabsf(scales[k].y - scales[0].y) <= settings.ScaleError
+				&& fabsf(scales[k].z - scales[0].z) <= settings.ScaleError;
+		}
+		std::vector<UINT> keptScales = constantScale ? std::vector<UINT>{ 0 } : ReduceFloat3(scales, settings.ScaleError);
+		for (UINT k : keptScales)
+		{
+			bone.ScaleFrames.push_back((std::uint16_t)k);
+			bone.Scales.push_back(scales[k]);
+		}
+	}
+}
+
+void AnimationClip::DropRawKeys()
+{
+	for (BoneAnimation& bone : BoneAnimations)
+	{
+		std::vector<Keyframe>().swap(bone.Keyframes);
+	}
+	std::vector<float>().swap(SoA);
+	SoABoneStride = 0;
+}
+
+size_t AnimationClip::RawByteSize()const
+{
+	size_t bytes = 0;
+	for (const BoneAnimation& bone : BoneAnimations)
+	{
+		bytes += bone.Keyframes.size() * sizeof(Keyframe);
+	}
+	return bytes;
+}
+
+size_t AnimationClip::CompressedByteSize()const
+{
+	size_t bytes = 0;
+	for (const CompressedBoneAnimation& bone : Compressed)
+	{
+		bytes += bone.ByteSize();
+	}
+	return bytes;
+}
+
+UINT PaletteStride(SkinningMode mode)
+{
+	return mode == SkinningMode::DualQuaternion ? 2 : 3;
+}
+
+void AnimationScratch::Reserve(UINT boneCount)
+{
+	if (Transforms.size() < boneCount) Transforms.resize(boneCount);
+}
+
+UINT Skeleton::BoneCount()const
+{
+	return BoneHierarchy.size();
+}
+
+int Skeleton::FindBone(const std::string& name)const
+{
+	for (UINT i = 0; i < BoneNames.size(); ++i)
+	{
+		if (BoneNames[i] == name) return i;
+	}
+	return -1;
+}
+
+bool SkinnedData::HasClip(const std::string& clipName)const
+{
+	return mClipIndex.find(clipName) != mClipIndex.end();
+}
+
+ClipHandle SkinnedData::FindClip(const std::string& clipName)const
+{
+	return mClipIndex.at(clipName);
 }
 
 float SkinnedData::GetClipStartTime(const std::string& clipName)const
 {
-	auto clip = mAnimations.find(clipName);
-	return clip->second.GetClipStartTime();
+	return GetClipStartTime(FindClip(clipName));
 }
 
 float SkinnedData::GetClipEndTime(const std::string& clipName)const
 {
-	auto clip = mAnimations.find(clipName);
-	return clip->second.GetClipEndTime();
+	return GetClipEndTime(FindClip(clipName));
+}
+
+float SkinnedData::GetClipStartTime(ClipHandle clip)const
+{
+	return mClips[clip].GetClipStartTime();
+}
+
+float SkinnedData::GetClipEndTime(ClipHandle clip)const
+{
+	return mClips[clip].GetClipEndTime();
 }
 
 UINT SkinnedData::BoneCount()const
 {
-	return mBoneHierarchy.size();
+	return mSkeleton->BoneCount();
 }
 
-void SkinnedData::Set(std::vector<int>& boneHierarchy, 
-		              std::vector<XMFLOAT4X4>& boneOffsets,
-		              std::unordered_map<std::string, AnimationClip>& animations)
+const Skeleton* SkinnedData::GetSkeleton()const
 {
-	mBoneHierarchy = boneHierarchy;
-	mBoneOffsets   = boneOffsets;
-	mAnimations    = animations;
+	return mSkeleton;
+}
+
+void SkinnedData::BindClips(const Skeleton& skeleton,
+		                    const std::vector<std::string>& boneNames,
+		                    std::unordered_map<std::string, AnimationClip>& animations,
+		                    const AnimationCompression& compression)
+{
+	for (auto& [name, clip] : animations)
+	{
+		BindToSkeleton(skeleton, clip, boneNames);
+		BakeAxisCorrection(skeleton, clip);
+		clip.DetectUniformSampling();
+
+		//  ʾҰų    Ŭ( ø ƴ)  ũ ״ .
+		size_t rawBytes = clip.RawByteSize();
+		if (compression.Enabled) clip.Compress(compression);
+		clip.RawKeyBytes = rawBytes;
+		clip.CompressedKeyBytes = clip.Compressed.empty() ? rawBytes : clip.CompressedByteSize();
+		if (!clip.Compressed.empty())
+		{
+			clip.DropRawKeys();
+			continue;
+		}
+
+		// nlerp  slerp   ٸ.    SoA    η .
+		//     ϹǷ  ˻Ѵ.
+		clip.BuildSoA();
+		if (!clip.ValidateSoA(5.0e-3f))
+		{
+			OutputDebugStringA(("SoA pose sampling mismatch : " + name + "\n").c_str());
+			clip.SoA.clear();
+			clip.SoABoneStride = 0;
+		}
+	}
+}
+
+void SkinnedData::Set(const Skeleton& skeleton, std::unordered_map<std::string, AnimationClip>& animations)
+{
+	mSkeleton = &skeleton;
+
+	mClips.clear();
+	mClipIndex.clear();
+	mClips.reserve(animations.size());
+	mCompressedKeyBytes = 0;
+	for (auto& [name, clip] : animations)
+	{
+		mClipIndex[name] = (ClipHandle)mClips.size();
+		mCompressedKeyBytes += clip.CompressedKeyBytes;
+		mClips.push_back(std::move(clip));
+	}
+}
+
+size_t SkinnedData::GetCompressedKeyBytes()const
+{
+	return mCompressedKeyBytes;
+}
+
+void SkinnedData::BindToSkeleton(const Skeleton& skeleton, AnimationClip& clip, const std::vector<std::string>& boneNames)
+{
+	//  ĳͶ fbx    ٸ  Ƿ ̸ ̷  .
+	// Ŭ   ε  ä, Ű ð ù Ʈ 󰡼  ø Ѵ.
+	std::vector<float> keyTimes;
+	if (!clip.BoneAnimations.empty())
+	{
+		for (const Keyframe& key : clip.BoneAnimations[0].Keyframes) keyTimes.push_back(key.TimePos);
+	}
+	if (keyTimes.empty()) keyTimes.push_back(0.0f);
+
+	std::vector<BoneAnimation> bound(skeleton.BoneCount());
+	std::vector<bool> found(bound.size(), false);
+	for (UINT j = 0; j < boneNames.size() && j < clip.BoneAnimations.size(); ++j)
+	{
+		int i = skeleton.FindBone(boneNames[j]);
+		if (i < 0 || found[i]) continue;
+		bound[i] = std::move(clip.BoneAnimations[j]);
+		found[i] = true;
+	}
+
+	for (UINT i = 0; i < bound.size(); ++i)
+	{
+		if (found[i]) continue;
+		const std::string& name = skeleton.BoneNames[i];
+		OutputDebugStringA(("Bone missing in clip, using bind pose : " + name + "\n").c_str());
+
+		// toRoot = inverse(offset) ̹Ƿ toParent = inverse(offset) * parentOffset
+		Keyframe bindKey;
+		XMMATRIX offset = XMLoadFloat4x4(&skeleton.BoneOffsets[i]);
+		XMVECTOR det = XMMatrixDeterminant(offset);
+		if (fabsf(XMVectorGetX(det)) > 1.0e-8f)
+		{
+			XMMATRIX toParent = XMMatrixInverse(&det, offset);
+			int parentIndex = skeleton.BoneHierarchy[i];
+			if (parentIndex >= 0) toParent = XMMatrixMultiply(toParent, XMLoadFloat4x4(&skeleton.BoneOffsets[parentIndex]));
+
+			XMVECTOR S, Q, T;
+			if (XMMatrixDecompose(&S, &Q, &T, toParent))
+			{
+				XMStoreFloat3(&bindKey.Scale, S);
+				XMStoreFloat4(&bindKey.RotationQuat, Q);
+				XMStoreFloat3(&bindKey.Translation, T);
+			}
+		}
+
+		bound[i].Keyframes.resize(keyTimes.size(), bindKey);
+		for (UINT k = 0; k < keyTimes.size(); ++k)
+		{
+			bound[i].Keyframes[k].TimePos = keyTimes[k];
+		}
+	}
+	clip.BoneAnimations = std::move(bound);
+}
+
+void SkinnedData::BakeAxisCorrection(const Skeleton& skeleton, AnimationClip& clip)
+{
+	// ִϸ̼Ǹ ϸ x   90 ȸ.  x  -90 ȸŴ.
+	//   offset * toRoot * R ̰ R  Ʈ  toParent ʿ  Ͱ Ƿ
+	// ε  Ʈ  Űӿ ̸ ־ д. S * Q * T(p) * R = S * (Q * R) * T(p * R)
+	XMVECTOR adjustQ = XMQuaternionRotationNormal(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), XMConvertToRadians(-90.0f));
+	for (UINT i = 0; i < clip.BoneAnimations.size() && i < skeleton.BoneCount(); ++i)
+	{
+		if (skeleton.BoneHierarchy[i] >= 0) continue;
+		for (Keyframe& key : clip.BoneAnimations[i].Keyframes)
+		{
+			XMVECTOR Q = XMLoadFloat4(&key.RotationQuat);
+			XMVECTOR P = XMLoadFloat3(&key.Translation);
+			XMStoreFloat4(&key.RotationQuat, XMQuaternionMultiply(Q, adjustQ));
+			XMStoreFloat3(&key.Translation, XMVector3Rotate(P, adjustQ));
+		}
+	}
 }
  
-void SkinnedData::GetFinalTransforms(const std::string& clipName, float timePos,  std::vector<XMFLOAT4X4>& finalTransforms)const
+void SkinnedData::GetFinalTransforms(ClipHandle clip, float timePos, AnimationScratch& scratch,
+	SkinningMode mode, XMFLOAT4* palette, UINT* keyCursors)const
 {
-	UINT numBones = mBoneOffsets.size();
-	//finalTransforms.resize(numBones);
-	std::vector<XMFLOAT4X4> toParentTransforms(numBones);
+	const std::vector<int>& boneHierarchy = mSkeleton->BoneHierarchy;
+	const std::vector<XMFLOAT4X4>& boneOffsets = mSkeleton->BoneOffsets;
+	UINT numBones = boneOffsets.size();
+	scratch.Reserve(numBones);
+	XMFLOAT4X4* transforms = scratch.Transforms.data();
 
 	// Interpolate all the bones of this clip at the given time instance.
-	auto clip = mAnimations.at(clipName);
-	clip.Interpolate(timePos, toParentTransforms);
+	mClips[clip].Interpolate(timePos, transforms, keyCursors);
 
 	//
 	// Traverse the hierarchy and transform all the bones to the root space.
+	// Parents always come before their children, so toParent is replaced
+	// by toRoot in place.
 	//
+	for(UINT i = 0; i < numBones; ++i)
+	{
+		int parentIndex = boneHierarchy[i];
+		if (parentIndex < 0) continue;
 
-	std::vector<XMFLOAT4X4> toRootTransforms(numBones);
-
-	// The root bone has index 0.  The root bone has no parent, so its toRootTransform
-	// is just its local bone transform.
-	toRootTransforms[0] = toParentTransforms[0];
+		XMMATRIX toParent = XMLoadFloat4x4(&transforms[i]);
+		XMMATRIX parentToRoot = XMLoadFloat4x4(&transforms[parentIndex]);
+		XMStoreFloat4x4(&transforms[i], XMMatrixMultiply(toParent, parentToRoot));
+	}
 
-	// Now find the toRootTransform of the children.
-	for(UINT i = 1; i < numBones; ++i)
+	// Premultiply by the bone offset transform to get the final transform.
+	for(UINT i = 0; i < numBones; ++i)
 	{
-		XMMATRIX toParent = XMLoadFloat4x4(&toParentTransforms[i]);
-
-		int parentIndex = mBoneHierarchy[i];
-		XMMATRIX parentToRoot = XMLoadFloat4x4(&toRootTransforms[parentIndex]);
+		XMMATRIX offset = XMLoadFloat4x4(&boneOffsets[i]);
+		XMMATRIX toRoot = XMLoadFloat4x4(&transforms[i]);
+		XMMATRIX finalTransform = XMMatrixMultiply(offset, toRoot);
 
-		XMMATRIX toRoot = XMMatrixMultiply(toParent, parentToRoot);
+		if (mode == SkinningMode::Matrix3x4)
+		{
+			// XMStoreFloat3x4 stores the transpose, so the rows are the columns the shader dots with.
+			XMStoreFloat3x4(reinterpret_cast<XMFLOAT3X4*>(&palette[i * 3]), finalTransform);
+			continue;
+		}
 
-		XMStoreFloat4x4(&toRootTransforms[i], toRoot);
+		// p' = q p q* + t with dual part d = 0.5 * t * q.
+		XMVECTOR S, Q, T;
+		XMMatrixDecompose(&S, &Q, &T, finalTransform);
+		XMVECTOR dual = XMVectorScale(XMQuaternionMultiply(Q, XMVectorSetW(T, 0.0f)), 0.5f);
+		XMStoreFloat4(&palette[i * 2], Q);
+		XMStoreFloat4(&palette[i * 2 + 1], dual);
 	}
+}
 
-	// Premultiply by the bone offset transform to get the final transform.
-	for(UINT i = 0; i < numBones; ++i)
+int AnimationSet::Add(const std::string& name, const SkinnedData* data, ClipHandle clip)
+{
+	ClipInfo info;
+	info.Name = name;
+	info.Data = data;
+	info.Clip = clip;
+	info.StartTime = data->GetClipStartTime(clip);
+	info.EndTime = data->GetClipEndTime(clip);
+	info.BoneCount = data->BoneCount();
+	mEntries.push_back(info);
+	return (int)mEntries.size() - 1;
+}
+
+int AnimationSet::Find(const std::string& name)const
+{
+	for (UINT i = 0; i < mEntries.size(); ++i)
 	{
-		XMMATRIX offset = XMLoadFloat4x4(&mBoneOffsets[i]);
-		XMMATRIX toRoot = XMLoadFloat4x4(&toRootTransforms[i]);
-        XMMATRIX finalTransform = XMMatrixMultiply(offset, toRoot);
+		if (mEntries[i].Name == name) return i;
+	}
+	return -1;
+}
+
+UINT AnimationSet::Count()const
+{
+	return mEntries.size();
+}
 
-		// ִϸ̼Ǹ ϸ x   90 ȸ  ׷ 𸣰.  x  -90 ȸŴ.
-		XMMATRIX adjustRotXM = XMMatrixRotationX(XMConvertToRadians(-90.0f));
-		XMStoreFloat4x4(&finalTransforms[i], XMMatrixTranspose(finalTransform * adjustRotXM));
+const ClipInfo& AnimationSet::Get(int index)const
+{
+	return mEntries[index];
+}
+
+void AnimationSet::BindStates(const std::vector<std::string>& states)
+{
+	mStates.resize(states.size());
+	for (UINT i = 0; i < states.size(); ++i)
+	{
+		int index = Find(states[i]);
+		if (index == -1) OutputDebugStringA(("AnimationSet : no clip " + states[i] + "\n").c_str());
+		mStates[i] = index != -1 ? index : 0;
 	}
-}
\ No newline at end of file
+}
+
+int AnimationSet::GetStateIndex(int state)const
+{
+	if (mStates.empty()) return state < (int)mEntries.size() ? state : 0;
+	return state >= 0 && state < (int)mStates.size() ? mStates[state] : 0;
+}
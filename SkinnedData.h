@@ -2,6 +2,7 @@
 //#define SKINNEDDATA_H
 
 #include <vector>
+#include <cstdint>
 #include <DirectXMath.h>
 #include <Windows.h>
 #include <string>
@@ -16,7 +17,6 @@ using namespace DirectX;
 struct Keyframe
 {
 	Keyframe();
-	~Keyframe();
 
     float TimePos;
 	DirectX::XMFLOAT3 Translation;
@@ -37,8 +37,49 @@ struct BoneAnimation
 	float GetEndTime()const;
 
     void Interpolate(float t, DirectX::XMFLOAT4X4& M)const;
+	// cursor remembers the last bracketing key so that playback moving
+	// forward finds the next pair without searching.
+	void Interpolate(float t, DirectX::XMFLOAT4X4& M, UINT& cursor)const;
+	// Blends key i and key i+1 (clamped to the last key).
+	void InterpolateKey(UINT i, float lerpPercent, DirectX::XMFLOAT4X4& M)const;
 
 	std::vector<Keyframe> Keyframes; 	
+
+private:
+	UINT FindKey(float t, UINT& cursor)const;
+};
+
+///<summary>
+/// Import-time animation compression settings. The errors are the largest
+/// deviation a removed key may have from interpolating its neighbours.
+/// Clips are only compressed when Enabled is set; AssetCooker::ReportAnimation
+/// measures the savings without changing the cooked clips.
+///</summary>
+struct AnimationCompression
+{
+	bool Enabled = false;
+	float TranslationError = 0.01f;
+	float RotationError = 0.001f;	// radians
+	float ScaleError = 0.0001f;
+};
+
+///<summary>
+/// A BoneAnimation after compression. Every channel keeps only the keys
+/// that linear interpolation cannot reproduce, addressed by source frame
+/// index. Rotations are smallest-three quaternions packed into 48 bits
+/// and a constant scale track keeps a single key.
+///</summary>
+struct CompressedBoneAnimation
+{
+	void Interpolate(float frame, DirectX::XMFLOAT4X4& M)const;
+	size_t ByteSize()const;
+
+	std::vector<std::uint16_t> TranslationFrames;
+	std::vector<DirectX::XMFLOAT3> Translations;
+	std::vector<std::uint16_t> RotationFrames;
+	std::vector<std::uint16_t> Rotations;	// 3 per key
+	std::vector<std::uint16_t> ScaleFrames;
+	std::vector<DirectX::XMFLOAT3> Scales;
 };
 
 ///<summary>
@@ -51,38 +92,192 @@ struct AnimationClip
 	float GetClipStartTime()const;
 	float GetClipEndTime()const;
 
-    void Interpolate(float t, std::vector<DirectX::XMFLOAT4X4>& boneTransforms)const;
+	// Sets SampleRate/StartTime/KeyCount when every bone has the same,
+	// evenly spaced key times. Otherwise SampleRate stays 0.
+	void DetectUniformSampling();
+
+	// Copies the keys of a uniform clip into SoA streams so that
+	// InterpolateSoA can sample four bones per instruction.
+	void BuildSoA();
+	// Compares InterpolateSoA against the per-bone InterpolateKey path.
+	bool ValidateSoA(float tolerance)const;
+
+	// Fills Compressed from the keys of a uniform clip.
+	void Compress(const AnimationCompression& settings);
+	// Frees the raw keys once the clip plays from Compressed.
+	void DropRawKeys();
+	size_t RawByteSize()const;
+	size_t CompressedByteSize()const;
+
+	// cursors (one per bone) is only used for clips that are not uniformly
+	// sampled and may be null.
+    void Interpolate(float t, DirectX::XMFLOAT4X4* boneTransforms, UINT* cursors)const;
+	// Blends key i and i+1 of every bone with normalized-lerp quaternions.
+	void InterpolateSoA(UINT i, float lerpPercent, DirectX::XMFLOAT4X4* boneTransforms)const;
 
     std::vector<BoneAnimation> BoneAnimations; 	
+
+	// Uniformly sampled clips compute the key index directly from these.
+	float SampleRate = 0.0f;
+	float StartTime = 0.0f;
+	UINT KeyCount = 0;
+
+	// Per key: Tx Ty Tz Qx Qy Qz Qw Sx Sy Sz streams of SoABoneStride floats.
+	// Bones are padded to a multiple of 4 with identity keys.
+	enum { SOA_TX, SOA_TY, SOA_TZ, SOA_QX, SOA_QY, SOA_QZ, SOA_QW, SOA_SX, SOA_SY, SOA_SZ, SOA_STREAM_COUNT };
+	std::vector<float> SoA;
+	UINT SoABoneStride = 0;
+
+	std::vector<CompressedBoneAnimation> Compressed;
+
+	// Key memory as imported and after compression, measured when binding.
+	size_t RawKeyBytes = 0;
+	size_t CompressedKeyBytes = 0;
+};
+
+///<summary>
+/// Index of a clip inside a SkinnedData. Resolve it once with FindClip
+/// instead of looking the clip up by name every frame.
+///</summary>
+typedef int ClipHandle;
+
+///<summary>
+/// Layout of one bone in a skinning palette. Matrix3x4 stores the first
+/// three rows of the transposed final transform, DualQuaternion stores a
+/// unit dual quaternion (real, dual) and drops any scale.
+///</summary>
+enum class SkinningMode
+{
+	Matrix3x4,
+	DualQuaternion
+};
+
+// Number of float4 one bone takes in the palette.
+UINT PaletteStride(SkinningMode mode);
+
+///<summary>
+/// Reusable working memory for GetFinalTransforms. It only grows, so once
+/// it has seen the largest skeleton no further allocation happens.
+///</summary>
+struct AnimationScratch
+{
+	void Reserve(UINT boneCount);
+
+	std::vector<DirectX::XMFLOAT4X4> Transforms;
+};
+
+///<summary>
+/// Bone hierarchy, names and bind offsets of a skinned mesh. It is loaded
+/// once per character and every clip of that character refers to it.
+///</summary>
+struct Skeleton
+{
+	UINT BoneCount()const;
+	// Returns -1 when no bone has this name.
+	int FindBone(const std::string& name)const;
+
+	// Gives parentIndex of ith bone.
+	std::vector<int> BoneHierarchy;
+	std::vector<std::string> BoneNames;
+	std::vector<DirectX::XMFLOAT4X4> BoneOffsets;
 };
 
+///<summary>
+/// The clips of one fbx file bound to a shared Skeleton. Bone tracks are
+/// reordered by bone name when cooked, so a clip exported from a different
+/// file of the same character plays on the character's mesh.
+///</summary>
 class SkinnedData
 {
 public:
 
 	UINT BoneCount()const;
+	const Skeleton* GetSkeleton()const;
+
+	bool HasClip(const std::string& clipName)const;
+	ClipHandle FindClip(const std::string& clipName)const;
 
 	float GetClipStartTime(const std::string& clipName)const;
 	float GetClipEndTime(const std::string& clipName)const;
+	float GetClipStartTime(ClipHandle clip)const;
+	float GetClipEndTime(ClipHandle clip)const;
+
+	// Reorders the tracks of every clip to the skeleton by bone name, bakes
+	// the axis correction and builds the SoA or compressed keys. The cooker
+	// does this once and the cooked file keeps the result.
+	// boneNames gives the bone of each BoneAnimation in animations.
+	static void BindClips(
+		const Skeleton& skeleton,
+		const std::vector<std::string>& boneNames,
+		std::unordered_map<std::string, AnimationClip>& animations,
+		const AnimationCompression& compression = AnimationCompression{});
 
-	void Set(
-		std::vector<int>& boneHierarchy, 
-		std::vector<DirectX::XMFLOAT4X4>& boneOffsets,
-		std::unordered_map<std::string, AnimationClip>& animations);
+	// Takes clips that BindClips prepared for this skeleton.
+	void Set(const Skeleton& skeleton, std::unordered_map<std::string, AnimationClip>& animations);
 
-	 // In a real project, you'd want to cache the result if there was a chance
-	 // that you were calling this several times with the same clipName at 
-	 // the same timePos.
-    void GetFinalTransforms(const std::string& clipName, float timePos,
-		 std::vector<DirectX::XMFLOAT4X4>& finalTransforms)const;
+	// Key memory of all clips as they play. Clips that are not compressed
+	// count their raw keys.
+	size_t GetCompressedKeyBytes()const;
+
+	// Writes BoneCount() * PaletteStride(mode) float4 to palette.
+	// Does not allocate once scratch has been reserved for this skeleton.
+    void GetFinalTransforms(ClipHandle clip, float timePos, AnimationScratch& scratch,
+		SkinningMode mode, DirectX::XMFLOAT4* palette, UINT* keyCursors = nullptr)const;
 
 private:
-    // Gives parentIndex of ith bone.
-	std::vector<int> mBoneHierarchy;
+	static void BindToSkeleton(const Skeleton& skeleton, AnimationClip& clip, const std::vector<std::string>& boneNames);
+	static void BakeAxisCorrection(const Skeleton& skeleton, AnimationClip& clip);
 
-	std::vector<DirectX::XMFLOAT4X4> mBoneOffsets;
+private:
+	const Skeleton* mSkeleton = nullptr;
    
-	std::unordered_map<std::string, AnimationClip> mAnimations;
+	std::vector<AnimationClip> mClips;
+	std::unordered_map<std::string, ClipHandle> mClipIndex;
+
+	size_t mCompressedKeyBytes = 0;
+};
+
+///<summary>
+/// A clip resolved once at load, with the values playback needs every
+/// frame so that they are plain loads instead of lookups or bone loops.
+///</summary>
+struct ClipInfo
+{
+	std::string Name;
+	const SkinnedData* Data = nullptr;
+	ClipHandle Clip = 0;
+	float StartTime = 0.0f;
+	float EndTime = 0.0f;
+	UINT BoneCount = 0;
+};
+
+///<summary>
+/// Every clip a character can play, addressed by the index it was added
+/// with. Gameplay states are mapped to entries by clip name when binding,
+/// so switching animation is an array access instead of a name lookup.
+/// Entries are only added while loading, so pointers to them stay valid.
+///</summary>
+class AnimationSet
+{
+public:
+	// Returns the index of the new entry.
+	int Add(const std::string& name, const SkinnedData* data, ClipHandle clip);
+	// Returns -1 when no entry has this name. Meant for load time only.
+	int Find(const std::string& name)const;
+
+	UINT Count()const;
+	const ClipInfo& Get(int index)const;
+
+	// Looks up the entry of every state by name once. states[i] names the
+	// clip of state i. States whose clip is not loaded play entry 0.
+	void BindStates(const std::vector<std::string>& states);
+	// Entry to play for a state. Sets without states use the state as the
+	// entry index.
+	int GetStateIndex(int state)const;
+
+private:
+	std::vector<ClipInfo> mEntries;
+	std::vector<int> mStates;	// state -> entry
 };
  
 //#endif // SKINNEDDATA_H
\ No newline at end of file
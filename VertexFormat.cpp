@@ -0,0 +1,71 @@
+#include <cmath>
+#include "VertexFormat.h"
+
+static_assert(sizeof(StaticVertex) == 24, "StaticVertex  Է ̾ƿ  24 Ʈ Ѵ");
+static_assert(sizeof(SkinVertex) == 8, "SkinVertex  Է ̾ƿ  8 Ʈ Ѵ");
+static_assert(MAX_BONE <= 256, " ȣ 8 Ʈ   ");
+
+namespace
+{
+	float SignNotZero(float value)
+	{
+		return value >= 0.0f ? 1.0f : -1.0f;
+	}
+}
+
+StaticVertex VertexFormat::PackStatic(const Vertex& vertex)
+{
+	StaticVertex packed;
+	packed.position = vertex.position;
+	XMFLOAT2 normal = EncodeOctahedral(vertex.normal);
+	PackedVector::XMStoreShortN2(&packed.normal, XMLoadFloat2(&normal));
+	packed.uv = vertex.uv;
+	return packed;
+}
+
+SkinVertex VertexFormat::PackSkin(const Vertex& vertex)
+{
+	// ݿøϰ ų ڶ ŭ  ū ġ Ƽ  1  
+	const float* weight = &vertex.weight.x;
+	int quantized[4];
+	int sum = 0;
+	int largest = 0;
+	for (int i = 0; i < 4; ++i) {
+		quantized[i] = static_cast<int>(weight[i] * 255.0f + 0.5f);
+		quantized[i] = min(max(quantized[i], 0), 255);
+		sum += quantized[i];
+		if (quantized[i] > quantized[largest]) largest = i;
+	}
+	if (sum > 0) quantized[largest] = min(max(quantized[largest] + 255 - sum, 0), 255);
+
+	SkinVertex packed;
+	packed.weight = PackedVector::XMUBYTEN4(static_cast<uint8_t>(quantized[0]), static_cast<uint8_t>(quantized[1]),
+		static_cast<uint8_t>(quantized[2]), static_cast<uint8_t>(quantized[3]));
+	packed.boneIndex = PackedVector::XMUBYTE4(static_cast<uint8_t>(vertex.boneIndex[0]), static_cast<uint8_t>(vertex.boneIndex[1]),
+		static_cast<uint8_t>(vertex.boneIndex[2]), static_cast<uint8_t>(vertex.boneIndex[3]));
+	return packed;
+}
+
+bool VertexFormat::IsSkinned(const vector<Vertex>& vertices)
+{
+	for (const Vertex& vertex : vertices) {
+		if (vertex.weight.x > 0.0f || vertex.weight.y > 0.0f || vertex.weight.z > 0.0f || vertex.weight.w > 0.0f) return true;
+	}
+	return false;
+}
+
+XMFLOAT2 VertexFormat::EncodeOctahedral(const XMFLOAT3& normal)
+{
+	float length = fabsf(normal.x) + fabsf(normal.y) + fabsf(normal.z);
+	if (length == 0.0f) return XMFLOAT2{ 0.0f, 0.0f };
+	float x = normal.x / length;
+	float y = normal.y / length;
+	if (normal.z < 0.0f) {
+		// Ʒ ݱ ٱ ﰢ ´
+		float foldedX = (1.0f - fabsf(y)) * SignNotZero(x);
+		float foldedY = (1.0f - fabsf(x)) * SignNotZero(y);
+		x = foldedX;
+		y = foldedY;
+	}
+	return XMFLOAT2{ x, y };
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "stdafx.h"
+#include <DirectXPackedVector.h>
+#include "Info.h"
+
+// GPU  ۿ ø . Vertex(64 Ʈ)   , ø   Ʈ  δ.
+// 0  Ʈ  ޽ð , 1  Ʈ Ų ޽ø   д.
+// Է ̾ƿ Scene::BuildInputElement, ̴  Ǯ Common.hlsl  DecodeOctahedral  ִ.
+struct StaticVertex
+{
+	XMFLOAT3 position;				//  ̸ CPU  Ƿ  ʴ´
+	PackedVector::XMSHORTN2 normal;	// ȸü ڵ (R16G16_SNORM)
+	XMFLOAT2 uv;					// ó 50  ݺϴ UV  half δ ؼ Ƿ  ʴ´
+};
+
+struct SkinVertex
+{
+	PackedVector::XMUBYTEN4 weight;	// R8G8B8A8_UNORM.  255  ǰ 
+	PackedVector::XMUBYTE4 boneIndex;	// R8G8B8A8_UINT
+};
+
+namespace VertexFormat
+{
+	StaticVertex PackStatic(const Vertex& vertex);
+	SkinVertex PackSkin(const Vertex& vertex);
+	// ġ ϳ  Ų ޽ô
+	bool IsSkinned(const vector<Vertex>& vertices);
+
+	//  ͸ [-1, 1]  2  ´. Ǫ  ̴ ִ
+	XMFLOAT2 EncodeOctahedral(const XMFLOAT3& normal);
+}